@@ -1,5 +1,11 @@
 TEMPLATE = subdirs
 CONFIG += c++17
 
-# Proyecto principal en subcarpeta Juego/ProyectoFinal
-SUBDIRS += Juego/ProyectoFinal
+# Núcleo de simulación (biblioteca estática sin Qt), simulador por lotes
+# de línea de comandos y proyecto principal en Juego/ProyectoFinal
+SUBDIRS += nucleo simulador juego
+
+nucleo.subdir = Juego/NucleoSimulacion
+simulador.subdir = Juego/SimuladorLotes
+simulador.depends = nucleo
+juego.subdir = Juego/ProyectoFinal
@@ -0,0 +1,7 @@
+TEMPLATE = lib
+CONFIG += staticlib c++17
+CONFIG -= qt
+
+TARGET = NucleoSimulacion
+
+include(../ProyectoFinal/nucleo.pri)
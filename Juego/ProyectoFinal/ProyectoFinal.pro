@@ -8,29 +8,16 @@ CONFIG += c++17
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# Física, niveles y HAL (sin Qt); ver nucleo.pri
+include(nucleo.pri)
+
 SOURCES += \
-    agentehal69.cpp \
-    cohete.cpp \
-    juego.cpp \
     main.cpp \
     mainwindow.cpp \
-    nivel.cpp \
-    nivel1_sputnik.cpp \
-    nivel2_vostok.cpp \
-    nivel3_apolo11.cpp \
-    sistemafisica.cpp \
     visualizacionwidget.cpp
 
 HEADERS += \
-    agentehal69.h \
-    cohete.h \
-    juego.h \
     mainwindow.h \
-    nivel.h \
-    nivel1_sputnik.h \
-    nivel2_vostok.h \
-    nivel3_apolo11.h \
-    sistemafisica.h \
     visualizacionwidget.h
 
 FORMS += \
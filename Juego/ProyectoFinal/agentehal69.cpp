@@ -1,124 +1,186 @@
-#include "AgenteHAL69.h"
-#include <iostream>
-#include "Cohete.h"
-#include "Nivel.h"
+#include "agentehal69.h"
+#include <algorithm>
+#include "cohete.h"
+#include "nivel.h"
+#include "nivel3_apolo11.h"
+#include "pilotoalunizaje.h"
+#include "tablaalunizaje.h"
 
 AgenteHAL69::AgenteHAL69()
-    : velSeguraMinNivel2(2000.0),
-    velSeguraMaxNivel2(9000.0),
-    velAdvertenciaPeligrosaNivel2(9000.0),
-    combustibleBajo(40.0),
-    combustibleCritico(20.0),
+    : velAdvertenciaPeligrosaNivel2(9000.0),
     fallosVelocidadAltaNivel2(0)
 {
 }
 
+void AgenteHAL69::informar(CodigoAviso codigo, int numeroNivel, double tiempoSimulacion,
+                           double parametro)
+{
+    AvisoHAL aviso;
+    aviso.codigo = codigo;
+    aviso.nivel = numeroNivel;
+    aviso.tiempo = tiempoSimulacion;
+    aviso.parametros[0] = parametro;
+    avisos.registrar(aviso);
+}
+
+ValoresHAL AgenteHAL69::medir(const Nivel& nivel, const Cohete& cohete,
+                              const ResumenTelemetria& telemetria) const
+{
+    const double v = cohete.obtenerVelocidad();
+    const double h = cohete.obtenerAltura();
+
+    ValoresHAL valores{};
+    valores[static_cast<std::size_t>(VariableHAL::Velocidad)] = v;
+    valores[static_cast<std::size_t>(VariableHAL::Combustible)] = cohete.obtenerPorcentajeCombustible();
+    valores[static_cast<std::size_t>(VariableHAL::Altura)] = h;
+    valores[static_cast<std::size_t>(VariableHAL::FraccionObjetivo)] = h / nivel.obtenerAlturaObjetivo();
+    valores[static_cast<std::size_t>(VariableHAL::RazonVelocidadMaxima)] = v / nivel.obtenerVelocidadMaxima();
+    valores[static_cast<std::size_t>(VariableHAL::RazonAdvertencia)] = v / velAdvertenciaPeligrosaNivel2;
+    valores[static_cast<std::size_t>(VariableHAL::SegundosHastaVacio)] = telemetria.segundosHastaVacio;
+    return valores;
+}
+
 void AgenteHAL69::analizarEstado(int numeroNivel,
                                  const Nivel& nivel,
                                  const Cohete& cohete,
+                                 const ResumenTelemetria& telemetria,
                                  double tiempoSimulacion)
 {
-    using std::cout;
-    using std::endl;
-
-    double v    = cohete.obtenerVelocidad();
-    double fuel = cohete.obtenerPorcentajeCombustible();
-    double h    = cohete.obtenerAltura();
+    const DecisionHAL decision =
+        MotorReglasHAL::compartido().evaluar(numeroNivel, medir(nivel, cohete, telemetria));
 
     bool emitioAlgo = false;
-
-    cout << "HAL-69 [" << nivel.obtenerNombre()
-         << " | t=" << tiempoSimulacion << " s]: ";
-
-    if (numeroNivel == 2) {
-        if (v < velSeguraMinNivel2) {
-            cout << "\n  - Velocidad baja (" << v
-                 << " m/s). Te recomiendo aumentar un poco el empuje.";
-            emitioAlgo = true;
-        } else if (v > velAdvertenciaPeligrosaNivel2) {
-            cout << "\n  - Velocidad PELIGROSA (" << v
-                 << " m/s). Reduce el empuje para evitar dañar la nave.";
-            emitioAlgo = true;
-        } else if (v > velSeguraMaxNivel2 * 0.9) {
-            cout << "\n  - Estas cerca del limite seguro de velocidad. Vigila el empuje.";
+    for (GrupoRegla grupo : {GrupoRegla::InformeVelocidad, GrupoRegla::InformeCombustible}) {
+        const std::size_t g = static_cast<std::size_t>(grupo);
+        if (decision.codigo[g] != CodigoAviso::Ninguno) {
+            informar(decision.codigo[g], numeroNivel, tiempoSimulacion, decision.parametro[g]);
             emitioAlgo = true;
         }
-    } else if (numeroNivel == 1) {
-        double velMaxNivel1 = nivel.obtenerVelocidadMaxima();
-        if (v > velMaxNivel1 * 0.95 && h < 100000.0) {
-            cout << "\n  - Velocidad muy alta en la atmosfera. "
-                    "Podrias quemar el Sputnik.";
-            emitioAlgo = true;
-        }
-    }
-
-    if (fuel < combustibleCritico) {
-        cout << "\n  - Combustible CRITICO (" << fuel
-             << "%). Ajusta el empuje o no alcanzaras el objetivo.";
-        emitioAlgo = true;
-    } else if (fuel < combustibleBajo) {
-        cout << "\n  - Combustible bajo (" << fuel
-             << "%). Administra mejor la potencia.";
-        emitioAlgo = true;
     }
 
     if (!emitioAlgo) {
-        cout << "Todo en rangos seguros por ahora." << endl;
-    } else {
-        cout << endl;
+        informar(CodigoAviso::InformeSinNovedad, numeroNivel, tiempoSimulacion);
     }
 }
 
-std::string AgenteHAL69::obtenerMensajeUI(int numeroNivel,
-                                         const Nivel& nivel,
-                                         const Cohete& cohete,
-                                         double tiempoSimulacion)
+AvisoHAL AgenteHAL69::diagnosticar(int numeroNivel,
+                                   const Nivel& nivel,
+                                   const Cohete& cohete,
+                                   const ResumenTelemetria& telemetria,
+                                   double tiempoSimulacion,
+                                   const IncertidumbreAlunizaje& incertidumbre) const
 {
-    (void)tiempoSimulacion; // Parámetro reservado para uso futuro
     double v = cohete.obtenerVelocidad();
-    double fuel = cohete.obtenerPorcentajeCombustible();
     double h = cohete.obtenerAltura();
-    double alturaObjetivo = nivel.obtenerAlturaObjetivo();
+
+    AvisoHAL aviso;
+    aviso.nivel = numeroNivel;
+    aviso.tiempo = tiempoSimulacion;
+    // Devuelve el aviso con el código (y el parámetro) dado
+    auto con = [&aviso](CodigoAviso codigo, double parametro = 0.0) {
+        aviso.codigo = codigo;
+        aviso.parametros[0] = parametro;
+        return aviso;
+    };
     
-    // Mensajes positivos
-    if (numeroNivel == 2) {
-        if (v >= 2000.0 && v <= 8500.0 && fuel > 30.0 && h < alturaObjetivo) {
-            double progreso = (h / alturaObjetivo) * 100.0;
-            if (progreso > 50.0) {
-                return "Excelente progreso. Mantén esta velocidad y llegarás al objetivo.";
-            } else if (progreso > 25.0) {
-                return "Buen ritmo. Continúa así para alcanzar la órbita.";
-            }
+    // Lo que va a pasar si nada cambia pesa más que el estado de ahora
+    const PrevisionHAL* prevision = anticipador.obtenerPrevision();
+    if ((numeroNivel == 1 || numeroNivel == 2) && prevision &&
+        prevision->fallo != FalloPrevisto::Ninguno) {
+        const double faltan = std::max(0.0, prevision->tiempo - tiempoSimulacion);
+        switch (prevision->fallo) {
+        case FalloPrevisto::ExcesoVelocidad:
+            return con(CodigoAviso::PrevistoExcesoVelocidad, faltan);
+        case FalloPrevisto::SinCombustible:
+            return con(CodigoAviso::PrevistoSinCombustible, faltan);
+        case FalloPrevisto::Impacto:
+            return con(CodigoAviso::PrevistoImpacto, faltan);
+        case FalloPrevisto::Ninguno:
+            break;
         }
-        
-        // Advertencias
-        if (v > 10000.0) {
-            return "¡PELIGRO! Velocidad crítica. Reduce el empuje inmediatamente o la nave se destruirá.";
-        } else if (v > 9500.0) {
-            return "Velocidad muy alta. Reduce el empuje para evitar daños.";
-        } else if (v < 2000.0 && h < alturaObjetivo * 0.5) {
-            return "Velocidad baja. Aumenta el empuje para mantener el ascenso.";
+    }
+
+    // Lo que no cuadra con la física del nivel pesa más que los umbrales
+    switch (MonitorTelemetria::anomaliaVigente(telemetria, tiempoSimulacion)) {
+    case AnomaliaTelemetria::ConsumoExcesivo:
+        aviso.parametros[1] = telemetria.segundosHastaVacio;
+        return con(CodigoAviso::AnomaliaConsumo, telemetria.magnitudAnomalia);
+    case AnomaliaTelemetria::PicoArrastre:
+        return con(CodigoAviso::AnomaliaArrastre, telemetria.magnitudAnomalia);
+    case AnomaliaTelemetria::SaltoVelocidad:
+        return con(CodigoAviso::AnomaliaSaltoVelocidad, telemetria.magnitudAnomalia);
+    case AnomaliaTelemetria::Ninguna:
+        break;
+    }
+
+    const DecisionHAL decision =
+        MotorReglasHAL::compartido().evaluar(numeroNivel, medir(nivel, cohete, telemetria));
+    const std::size_t consejo = static_cast<std::size_t>(GrupoRegla::Consejo);
+    if (decision.codigo[consejo] != CodigoAviso::Ninguno) {
+        return con(decision.codigo[consejo], decision.parametro[consejo]);
+    }
+
+    // El nivel 3 compara los controles con el piloto automático y la tabla
+    // de alunizaje, que no son rangos fijos sobre el estado
+    if (const auto* apolo = dynamic_cast<const Nivel3_Apolo11*>(&nivel)) {
+        // Se compara el empuje del jugador con el del piloto automático
+        const ConsignaAlunizaje consigna = PilotoAlunizaje(*apolo).calcular(cohete, incertidumbre);
+        const double empuje = cohete.obtenerEmpuje();
+
+        // Con la tabla precalculada el veredicto tiene en cuenta el
+        // combustible que queda; sin ella se usa solo el piloto
+        const TablaAlunizaje& tabla = TablaAlunizaje::compartida();
+        if (tabla.estaCargada()) {
+            const ConsultaAlunizaje consulta =
+                tabla.consultar(h, v, cohete.obtenerCombustible());
+            if (!consulta.posible) {
+                return con(CodigoAviso::Nivel3AlunizajeImposible, consulta.velocidadImpactoMinima);
+            }
+            if (empuje < consulta.empuje - 50000.0) {
+                return con(CodigoAviso::Nivel3SubirEmpuje, consulta.empuje);
+            }
+        } else if (!consigna.alcanza) {
+            return con(CodigoAviso::Nivel3FrenadoImposible);
         }
-        
-        if (fuel < 10.0) {
-            return "¡COMBUSTIBLE CRÍTICO! Optimiza el empuje o no alcanzarás el objetivo.";
-        } else if (fuel < 25.0) {
-            return "Combustible bajo. Ajusta el empuje para optimizar el consumo.";
+        if (consigna.frenando && empuje < 0.8 * consigna.empuje) {
+            return con(CodigoAviso::Nivel3HoraDeFrenar, consigna.empuje);
         }
-        
-        if (h >= alturaObjetivo * 0.9 && v >= 2000.0 && v <= 8500.0) {
-            return "¡Casi ahí! Mantén la velocidad actual para completar la misión.";
+        if (!consigna.frenando && empuje > 0.0 && h > 1000.0) {
+            return con(CodigoAviso::Nivel3ApagarMotor);
         }
-    } else if (numeroNivel == 1) {
-        if (v > 7500.0 && h < 100000.0) {
-            return "Velocidad muy alta en la atmósfera. Podrías quemar el Sputnik.";
+        if (consigna.cambioVelocidadX < -5.0) {
+            return con(CodigoAviso::Nivel3CorregirIzquierda);
         }
-        if (fuel < 20.0) {
-            return "Combustible bajo. Ajusta el empuje.";
+        if (consigna.cambioVelocidadX > 5.0) {
+            return con(CodigoAviso::Nivel3CorregirDerecha);
         }
     }
     
-    return ""; // Sin mensaje si todo está bien
+    return aviso; // Ninguno si todo está bien
+}
+
+void AgenteHAL69::evaluar(int numeroNivel,
+                          const Nivel& nivel,
+                          const Cohete& cohete,
+                          const ResumenTelemetria& telemetria,
+                          double tiempoSimulacion,
+                          double reloj,
+                          const IncertidumbreAlunizaje& incertidumbre)
+{
+    anticipador.actualizar(numeroNivel, nivel, cohete, tiempoSimulacion);
+    avisos.emitir(diagnosticar(numeroNivel, nivel, cohete, telemetria, tiempoSimulacion, incertidumbre),
+                  reloj);
+}
+
+void AgenteHAL69::normalizarAvisos()
+{
+    avisos.normalizar();
+    anticipador.descartar();
+}
+
+void AgenteHAL69::olvidarConsejos()
+{
+    avisos.olvidarConsejos();
 }
 
 void AgenteHAL69::registrarFalloNivel2PorVelocidadAlta()
@@ -126,17 +188,29 @@ void AgenteHAL69::registrarFalloNivel2PorVelocidadAlta()
     ++fallosVelocidadAltaNivel2;
 
     if (fallosVelocidadAltaNivel2 == 1) {
-        std::cout << "HAL-69: He registrado un fallo por exceso de velocidad. "
-                     "A partir de ahora te avisare antes de superar "
-                  << velAdvertenciaPeligrosaNivel2 << " m/s.\n";
+        informar(CodigoAviso::InformeFalloRegistrado, 2, 0.0, velAdvertenciaPeligrosaNivel2);
     } else if (fallosVelocidadAltaNivel2 > 1) {
         velAdvertenciaPeligrosaNivel2 *= 0.9;
         if (velAdvertenciaPeligrosaNivel2 < 1500.0) {
             velAdvertenciaPeligrosaNivel2 = 1500.0;
         }
 
-        std::cout << "HAL-69: He aprendido de tus fallos anteriores, "
-                     "ahora te avisare antes de superar "
-                  << velAdvertenciaPeligrosaNivel2 << " m/s.\n";
+        informar(CodigoAviso::InformeFalloAprendido, 2, 0.0, velAdvertenciaPeligrosaNivel2);
     }
 }
+
+EstadoHAL AgenteHAL69::capturarEstado() const
+{
+    return {fallosVelocidadAltaNivel2, velAdvertenciaPeligrosaNivel2};
+}
+
+void AgenteHAL69::restaurarEstado(const EstadoHAL& estado)
+{
+    fallosVelocidadAltaNivel2 = estado.fallosVelocidadAltaNivel2;
+    velAdvertenciaPeligrosaNivel2 = estado.velAdvertenciaPeligrosaNivel2;
+}
+
+const HistorialAvisos& AgenteHAL69::obtenerAvisos() const
+{
+    return avisos.obtenerHistorial();
+}
@@ -1,35 +1,94 @@
 #ifndef AGENTE_HAL69_H
 #define AGENTE_HAL69_H
 
-#include <string>
+#include "anticipadorhal.h"
+#include "avisoshal.h"
+#include "buffercircular.h"
+#include "cohete.h"
+#include "monitortelemetria.h"
+#include "pilotoalunizaje.h"
+#include "reglashal.h"
 
-class Cohete;
 class Nivel;
 
+// Memoria de HAL entre partidas (lo que no es configuración)
+struct EstadoHAL {
+    int fallosVelocidadAltaNivel2 = 0;
+    double velAdvertenciaPeligrosaNivel2 = 0.0; // Baja con cada fallo
+};
+
+// Estado del cohete al cumplirse un intervalo de control, para que el
+// informe periódico se analice fuera del paso de física
+struct MuestraHAL {
+    int nivel = 0;
+    double tiempo = 0.0;
+    Cohete cohete;
+    ResumenTelemetria telemetria;
+};
+
+using MuestrasHAL = BufferCircular<MuestraHAL, 16>;
+
 class AgenteHAL69 {
 private:
-    double velSeguraMinNivel2;
-    double velSeguraMaxNivel2;
+    // Los umbrales fijos están en reglasPredeterminadasHAL(); este lo
+    // aprende HAL con cada fallo
     double velAdvertenciaPeligrosaNivel2;
-    double combustibleBajo;
-    double combustibleCritico;
 
     int fallosVelocidadAltaNivel2;
 
+    RegistroAvisos avisos;
+    AnticipadorHAL anticipador;
+
+    void informar(CodigoAviso codigo, int numeroNivel, double tiempoSimulacion,
+                  double parametro = 0.0);
+    // Lo que miran las reglas
+    ValoresHAL medir(const Nivel& nivel, const Cohete& cohete,
+                     const ResumenTelemetria& telemetria) const;
+
 public:
     AgenteHAL69();
 
+    // Informe periódico: deja avisos del canal Consola en el historial
     void analizarEstado(int numeroNivel,
                         const Nivel& nivel,
                         const Cohete& cohete,
+                        const ResumenTelemetria& telemetria,
                         double tiempoSimulacion);
 
-    std::string obtenerMensajeUI(int numeroNivel,
-                                  const Nivel& nivel,
-                                  const Cohete& cohete,
-                                  double tiempoSimulacion);
+    // Consejo para la interfaz en este instante (Ninguno si todo va bien).
+    // En los niveles 1 y 2 avisa antes que nada del primer fallo que prevé
+    // la última simulación hacia adelante de evaluar(); después, de las
+    // anomalías vigentes de la telemetría. 'incertidumbre' son los desvíos
+    // de 'cohete' si es una estimación de los sensores.
+    AvisoHAL diagnosticar(int numeroNivel,
+                          const Nivel& nivel,
+                          const Cohete& cohete,
+                          const ResumenTelemetria& telemetria,
+                          double tiempoSimulacion,
+                          const IncertidumbreAlunizaje& incertidumbre = IncertidumbreAlunizaje()) const;
+
+    // Avanza la simulación hacia adelante (con su propio presupuesto de
+    // tiempo) y pasa diagnosticar() por el filtro del registro; 'reloj' en
+    // segundos de tiempo real
+    void evaluar(int numeroNivel,
+                 const Nivel& nivel,
+                 const Cohete& cohete,
+                 const ResumenTelemetria& telemetria,
+                 double tiempoSimulacion,
+                 double reloj,
+                 const IncertidumbreAlunizaje& incertidumbre = IncertidumbreAlunizaje());
+    // Fuera de partida: el próximo consejo se muestra aunque se repita
+    void normalizarAvisos();
+    // Los consejos ya emitidos se descartaron sin mostrarse
+    void olvidarConsejos();
 
     void registrarFalloNivel2PorVelocidadAlta();
+
+    EstadoHAL capturarEstado() const;
+    void restaurarEstado(const EstadoHAL& estado);
+
+    // Lo que HAL dijo, en orden; se lee por número de secuencia
+    const HistorialAvisos& obtenerAvisos() const;
 };
 
 #endif // AGENTE_HAL69_H
@@ -0,0 +1,134 @@
+#include "anticipadorhal.h"
+#include <chrono>
+#include <type_traits>
+
+AnticipadorHAL::AnticipadorHAL()
+    : numeroNivel(0),
+    tiempo(0.0),
+    hasta(0.0),
+    origen(0.0),
+    empujeOrigen(0.0),
+    enCurso(false),
+    hayPrevision(false) {
+}
+
+bool AnticipadorHAL::copiar(int numero, const Nivel& original) {
+    // Se asigna sobre la copia anterior para reusar su memoria
+    if (numero == 1) {
+        const auto* sputnik = dynamic_cast<const Nivel1_Sputnik*>(&original);
+        if (!sputnik) return false;
+        if (auto* copia = std::get_if<Nivel1_Sputnik>(&nivel)) {
+            *copia = *sputnik;
+        } else {
+            nivel.emplace<Nivel1_Sputnik>(*sputnik);
+        }
+        std::get<Nivel1_Sputnik>(nivel).establecerIntegrador(TipoIntegrador::RK4);
+        return true;
+    }
+    if (numero == 2) {
+        const auto* vostok = dynamic_cast<const Nivel2_Vostok*>(&original);
+        if (!vostok) return false;
+        if (auto* copia = std::get_if<Nivel2_Vostok>(&nivel)) {
+            *copia = *vostok;
+        } else {
+            nivel.emplace<Nivel2_Vostok>(*vostok);
+        }
+        std::get<Nivel2_Vostok>(nivel).establecerIntegrador(TipoIntegrador::RK4);
+        return true;
+    }
+    return false;
+}
+
+void AnticipadorHAL::actualizar(int numero, const Nivel& original, const Cohete& actual,
+                                double tiempoSimulacion) {
+    // Con otro empuje, otro nivel o tras rebobinar lo previsto ya no vale
+    const bool cambio = numero != numeroNivel ||
+                        tiempoSimulacion < origen ||
+                        actual.obtenerEmpuje() != empujeOrigen;
+    if (cambio) {
+        hayPrevision = false;
+        enCurso = false;
+    }
+
+    const bool vencida = !hayPrevision || tiempoSimulacion >= prevision.origen + INTERVALO;
+    if (!enCurso && vencida) {
+        if (!copiar(numero, original)) {
+            descartar();
+            return;
+        }
+        cohete = actual;
+        numeroNivel = numero;
+        tiempo = tiempoSimulacion;
+        hasta = tiempoSimulacion + HORIZONTE;
+        origen = tiempoSimulacion;
+        empujeOrigen = actual.obtenerEmpuje();
+        calculo = PrevisionHAL{FalloPrevisto::Ninguno, 0.0, tiempoSimulacion};
+        enCurso = true;
+    }
+    if (!enCurso) return;
+
+    using Reloj = std::chrono::steady_clock;
+    const Reloj::time_point limite = Reloj::now() +
+        std::chrono::duration_cast<Reloj::duration>(std::chrono::duration<double>(PRESUPUESTO));
+
+    std::visit([&](auto& copia) {
+        if constexpr (!std::is_same_v<std::decay_t<decltype(copia)>, std::monostate>) {
+            do {
+                if (!avanzar(copia)) {
+                    prevision = calculo;
+                    enCurso = false;
+                    hayPrevision = true;
+                    return;
+                }
+            } while (Reloj::now() < limite);
+        }
+    }, nivel);
+}
+
+template<class NivelT>
+bool AnticipadorHAL::avanzar(NivelT& copia) {
+    const double inicio = tiempo;
+    copia.aplicarFisica(&cohete, PASO);
+    tiempo += PASO;
+
+    // Instante del primer evento 'tipo' del paso (el final si no hubo)
+    const std::vector<EventoFisica>& eventos = copia.obtenerEventosPaso();
+    auto instante = [&](TipoEvento tipo) {
+        for (const EventoFisica& evento : eventos) {
+            if (evento.tipo == tipo) return inicio + evento.instante;
+        }
+        return tiempo;
+    };
+
+    // Mismo orden que Juego::verificarEstado
+    if (copia.verificarVictoria(&cohete)) {
+        return false;
+    }
+    if (cohete.estaDanado()) {
+        if (cohete.obtenerAltura() <= 0.0) {
+            calculo.fallo = FalloPrevisto::Impacto;
+            calculo.tiempo = instante(TipoEvento::Contacto);
+        } else {
+            calculo.fallo = FalloPrevisto::ExcesoVelocidad;
+            calculo.tiempo = instante(TipoEvento::LimiteVelocidad);
+        }
+        return false;
+    }
+    if (!cohete.tieneCombustible() && cohete.obtenerAltura() < copia.obtenerAlturaObjetivo()) {
+        calculo.fallo = FalloPrevisto::SinCombustible;
+        calculo.tiempo = instante(TipoEvento::SinCombustible);
+        return false;
+    }
+    return tiempo < hasta;
+}
+
+void AnticipadorHAL::descartar() {
+    nivel.emplace<std::monostate>();
+    numeroNivel = 0;
+    enCurso = false;
+    hayPrevision = false;
+}
+
+const PrevisionHAL* AnticipadorHAL::obtenerPrevision() const {
+    return hayPrevision ? &prevision : nullptr;
+}
@@ -0,0 +1,66 @@
+#ifndef ANTICIPADORHAL_H
+#define ANTICIPADORHAL_H
+
+#include <cstdint>
+#include <variant>
+#include "cohete.h"
+#include "nivel1_sputnik.h"
+#include "nivel2_vostok.h"
+
+enum class FalloPrevisto : std::uint8_t {
+    Ninguno,
+    ExcesoVelocidad, // Supera la velocidad máxima (en el nivel 1, se quema)
+    SinCombustible,  // Se agota antes de llegar a la altura objetivo
+    Impacto          // Vuelve a tocar el suelo
+};
+
+struct PrevisionHAL {
+    FalloPrevisto fallo = FalloPrevisto::Ninguno;
+    double tiempo = 0.0;  // Instante simulado del fallo
+    double origen = 0.0;  // Instante desde el que se simuló
+};
+
+// Mira hacia adelante por HAL en los niveles 1 y 2: simula una copia del
+// cohete y del nivel con el empuje actual hasta HORIZONTE segundos y guarda
+// el primer fallo que encuentra. Para que salga barato usa RK4 con pasos de
+// PASO segundos (la partida usa pasos de milisegundos) y cada llamada a
+// actualizar() trabaja como mucho PRESUPUESTO de tiempo real; una previsión
+// que no entra se sigue en la llamada siguiente.
+class AnticipadorHAL {
+public:
+    static constexpr double HORIZONTE = 90.0;      // s simulados por delante
+    static constexpr double PASO = 0.5;            // s por paso de RK4
+    static constexpr double INTERVALO = 1.0;       // s simulados entre previsiones
+    static constexpr double PRESUPUESTO = 0.0005;  // s reales por llamada
+
+private:
+    std::variant<std::monostate, Nivel1_Sputnik, Nivel2_Vostok> nivel;
+    Cohete cohete;
+    int numeroNivel;
+    double tiempo;       // Instante simulado de la copia
+    double hasta;
+    double origen;
+    double empujeOrigen; // Si el jugador lo cambia, la previsión ya no vale
+    bool enCurso;
+    PrevisionHAL calculo;   // La que se está simulando
+
+    PrevisionHAL prevision; // La última terminada
+    bool hayPrevision;
+
+    bool copiar(int numero, const Nivel& original);
+    // Da un paso de la copia; false cuando la previsión terminó
+    template<class NivelT>
+    bool avanzar(NivelT& copia);
+
+public:
+    AnticipadorHAL();
+
+    void actualizar(int numero, const Nivel& original, const Cohete& actual,
+                    double tiempoSimulacion);
+    void descartar();
+
+    // Nulo mientras no hay una previsión terminada para la situación actual
+    const PrevisionHAL* obtenerPrevision() const;
+};
+
+#endif // ANTICIPADORHAL_H
@@ -0,0 +1,122 @@
+#include "archivomapeado.h"
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+ArchivoMapeado::ArchivoMapeado()
+    : datos(nullptr),
+    tamano(0),
+#ifdef _WIN32
+    archivo(nullptr),
+    proyeccion(nullptr)
+#else
+    descriptor(-1)
+#endif
+{
+}
+
+ArchivoMapeado::~ArchivoMapeado() {
+    cerrar();
+}
+
+ArchivoMapeado::ArchivoMapeado(ArchivoMapeado&& otro) noexcept
+    : ArchivoMapeado() {
+    *this = std::move(otro);
+}
+
+ArchivoMapeado& ArchivoMapeado::operator=(ArchivoMapeado&& otro) noexcept {
+    if (this != &otro) {
+        cerrar();
+        std::swap(datos, otro.datos);
+        std::swap(tamano, otro.tamano);
+#ifdef _WIN32
+        std::swap(archivo, otro.archivo);
+        std::swap(proyeccion, otro.proyeccion);
+#else
+        std::swap(descriptor, otro.descriptor);
+#endif
+    }
+    return *this;
+}
+
+bool ArchivoMapeado::abrir(const std::string& ruta) {
+    cerrar();
+
+#ifdef _WIN32
+    HANDLE manejador = CreateFileA(ruta.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (manejador == INVALID_HANDLE_VALUE) return false;
+    archivo = manejador;
+
+    LARGE_INTEGER largo;
+    if (!GetFileSizeEx(manejador, &largo) || largo.QuadPart == 0) {
+        cerrar();
+        return false;
+    }
+    tamano = static_cast<std::size_t>(largo.QuadPart);
+
+    proyeccion = CreateFileMappingA(manejador, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!proyeccion) {
+        cerrar();
+        return false;
+    }
+    datos = static_cast<const unsigned char*>(MapViewOfFile(proyeccion, FILE_MAP_READ, 0, 0, 0));
+#else
+    descriptor = ::open(ruta.c_str(), O_RDONLY);
+    if (descriptor < 0) return false;
+
+    struct stat info;
+    if (::fstat(descriptor, &info) != 0 || info.st_size <= 0) {
+        cerrar();
+        return false;
+    }
+    tamano = static_cast<std::size_t>(info.st_size);
+
+    void* direccion = ::mmap(nullptr, tamano, PROT_READ, MAP_SHARED, descriptor, 0);
+    datos = direccion == MAP_FAILED ? nullptr : static_cast<const unsigned char*>(direccion);
+#endif
+
+    if (!datos) {
+        cerrar();
+        return false;
+    }
+    return true;
+}
+
+void ArchivoMapeado::cerrar() {
+#ifdef _WIN32
+    if (datos) UnmapViewOfFile(datos);
+    if (proyeccion) CloseHandle(proyeccion);
+    if (archivo) CloseHandle(archivo);
+    archivo = nullptr;
+    proyeccion = nullptr;
+#else
+    if (datos) ::munmap(const_cast<unsigned char*>(datos), tamano);
+    if (descriptor >= 0) ::close(descriptor);
+    descriptor = -1;
+#endif
+    datos = nullptr;
+    tamano = 0;
+}
+
+bool ArchivoMapeado::estaAbierto() const {
+    return datos != nullptr;
+}
+
+const unsigned char* ArchivoMapeado::obtenerDatos() const {
+    return datos;
+}
+
+std::size_t ArchivoMapeado::obtenerTamano() const {
+    return tamano;
+}
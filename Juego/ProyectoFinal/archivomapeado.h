@@ -0,0 +1,39 @@
+#ifndef ARCHIVOMAPEADO_H
+#define ARCHIVOMAPEADO_H
+
+#include <cstddef>
+#include <string>
+
+// Archivo proyectado en memoria de solo lectura. Abrirlo no copia nada:
+// el sistema operativo trae las páginas a medida que se leen y las
+// comparte entre procesos.
+class ArchivoMapeado {
+private:
+    const unsigned char* datos;
+    std::size_t tamano;
+#ifdef _WIN32
+    void* archivo;
+    void* proyeccion;
+#else
+    int descriptor;
+#endif
+
+public:
+    ArchivoMapeado();
+    ~ArchivoMapeado();
+
+    ArchivoMapeado(ArchivoMapeado&& otro) noexcept;
+    ArchivoMapeado& operator=(ArchivoMapeado&& otro) noexcept;
+    ArchivoMapeado(const ArchivoMapeado&) = delete;
+    ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+
+    // Cierra lo que hubiera abierto antes; false si no se pudo proyectar
+    bool abrir(const std::string& ruta);
+    void cerrar();
+
+    bool estaAbierto() const;
+    const unsigned char* obtenerDatos() const;
+    std::size_t obtenerTamano() const;
+};
+
+#endif // ARCHIVOMAPEADO_H
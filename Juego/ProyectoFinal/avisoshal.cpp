@@ -0,0 +1,226 @@
+#include "avisoshal.h"
+#include <cstdio>
+
+CanalAviso canalDe(CodigoAviso codigo) {
+    return codigo >= CodigoAviso::InformeSinNovedad ? CanalAviso::Consola : CanalAviso::Interfaz;
+}
+
+bool esUrgente(CodigoAviso codigo) {
+    switch (codigo) {
+    case CodigoAviso::Nivel2VelocidadCritica:
+    case CodigoAviso::Nivel2CombustibleCritico:
+    case CodigoAviso::Nivel3AlunizajeImposible:
+    case CodigoAviso::Nivel3FrenadoImposible:
+        return true;
+    default:
+        return false;
+    }
+}
+
+std::size_t formatearAviso(const AvisoHAL& aviso, char* destino, std::size_t capacidad) {
+    const double p = aviso.parametros[0];
+    int escritos = 0;
+
+    switch (aviso.codigo) {
+    case CodigoAviso::Ninguno:
+        escritos = std::snprintf(destino, capacidad, "%s", "");
+        break;
+    case CodigoAviso::Nivel1VelocidadAlta:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "Velocidad muy alta en la atmósfera. Podrías quemar el Sputnik.");
+        break;
+    case CodigoAviso::Nivel1CombustibleBajo:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "Combustible bajo. Ajusta el empuje.");
+        break;
+    case CodigoAviso::Nivel2ProgresoExcelente:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "Excelente progreso. Mantén esta velocidad y llegarás al objetivo.");
+        break;
+    case CodigoAviso::Nivel2BuenRitmo:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "Buen ritmo. Continúa así para alcanzar la órbita.");
+        break;
+    case CodigoAviso::Nivel2VelocidadCritica:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "¡PELIGRO! Velocidad crítica. Reduce el empuje inmediatamente o la nave se destruirá.");
+        break;
+    case CodigoAviso::Nivel2VelocidadMuyAlta:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "Velocidad muy alta. Reduce el empuje para evitar daños.");
+        break;
+    case CodigoAviso::Nivel2VelocidadBaja:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "Velocidad baja. Aumenta el empuje para mantener el ascenso.");
+        break;
+    case CodigoAviso::Nivel2CombustibleCritico:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "¡COMBUSTIBLE CRÍTICO! Optimiza el empuje o no alcanzarás el objetivo.");
+        break;
+    case CodigoAviso::Nivel2CombustibleBajo:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "Combustible bajo. Ajusta el empuje para optimizar el consumo.");
+        break;
+    case CodigoAviso::Nivel2CasiAhi:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "¡Casi ahí! Mantén la velocidad actual para completar la misión.");
+        break;
+    case CodigoAviso::Nivel3AlunizajeImposible:
+        escritos = std::snprintf(destino, capacidad,
+            "Ya no es posible alunizar: en el mejor caso tocarás el suelo a %d m/s.",
+            static_cast<int>(p));
+        break;
+    case CodigoAviso::Nivel3SubirEmpuje:
+        escritos = std::snprintf(destino, capacidad, "Sube el empuje a %d kN.",
+            static_cast<int>(p / 1000.0));
+        break;
+    case CodigoAviso::Nivel3FrenadoImposible:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "¡Ni a empuje máximo frenas a tiempo! Todo el empuje ya.");
+        break;
+    case CodigoAviso::Nivel3HoraDeFrenar:
+        escritos = std::snprintf(destino, capacidad,
+            "Hora de frenar: sube el empuje a unos %d kN.", static_cast<int>(p / 1000.0));
+        break;
+    case CodigoAviso::Nivel3ApagarMotor:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "Todavía no hace falta frenar. Apaga el motor y ahorra combustible.");
+        break;
+    case CodigoAviso::Nivel3CorregirIzquierda:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "Vas a caer fuera de la zona. Corrige hacia la izquierda (←).");
+        break;
+    case CodigoAviso::Nivel3CorregirDerecha:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "Vas a caer fuera de la zona. Corrige hacia la derecha (→).");
+        break;
+    case CodigoAviso::PrevistoExcesoVelocidad:
+        escritos = aviso.nivel == 1
+            ? std::snprintf(destino, capacidad,
+                  "A este ritmo el Sputnik se quemará en la atmósfera en %d s.",
+                  static_cast<int>(p))
+            : std::snprintf(destino, capacidad,
+                  "Con este empuje superarás la velocidad máxima en %d s. Reduce el empuje.",
+                  static_cast<int>(p));
+        break;
+    case CodigoAviso::PrevistoSinCombustible:
+        escritos = std::snprintf(destino, capacidad,
+            "Con este empuje te quedarás sin combustible en %d s, antes de llegar al objetivo.",
+            static_cast<int>(p));
+        break;
+    case CodigoAviso::PrevistoImpacto:
+        escritos = std::snprintf(destino, capacidad,
+            "Con este empuje volverás a caer a tierra en %d s.", static_cast<int>(p));
+        break;
+    case CodigoAviso::AnomaliaConsumo:
+        escritos = std::snprintf(destino, capacidad,
+            "El combustible baja %.1f kg/s más rápido de lo que pide el empuje. "
+            "A este ritmo se agota en %.0f s.", p, aviso.parametros[1]);
+        break;
+    case CodigoAviso::AnomaliaArrastre:
+        escritos = std::snprintf(destino, capacidad,
+            "Pico de arrastre: el aire frena %.1f m/s² más de lo normal. "
+            "Reduce la velocidad en la atmósfera baja.", p);
+        break;
+    case CodigoAviso::AnomaliaSaltoVelocidad:
+        escritos = std::snprintf(destino, capacidad,
+            "La velocidad cambió %+.1f m/s de golpe sin que el empuje lo explique.", p);
+        break;
+    case CodigoAviso::ProyeccionVacio:
+        escritos = std::snprintf(destino, capacidad,
+            "Al consumo de los últimos segundos el tanque se vacía en %.0f s.", p);
+        break;
+    case CodigoAviso::InformeSinNovedad:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "Todo en rangos seguros por ahora.");
+        break;
+    case CodigoAviso::InformeVelocidadBaja:
+        escritos = std::snprintf(destino, capacidad,
+            "Velocidad baja (%.2f m/s). Te recomiendo aumentar un poco el empuje.", p);
+        break;
+    case CodigoAviso::InformeVelocidadPeligrosa:
+        escritos = std::snprintf(destino, capacidad,
+            "Velocidad PELIGROSA (%.2f m/s). Reduce el empuje para evitar dañar la nave.", p);
+        break;
+    case CodigoAviso::InformeCercaLimite:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "Estas cerca del limite seguro de velocidad. Vigila el empuje.");
+        break;
+    case CodigoAviso::InformeNivel1VelocidadAlta:
+        escritos = std::snprintf(destino, capacidad, "%s",
+            "Velocidad muy alta en la atmosfera. Podrias quemar el Sputnik.");
+        break;
+    case CodigoAviso::InformeCombustibleCritico:
+        escritos = std::snprintf(destino, capacidad,
+            "Combustible CRITICO (%.2f%%). Ajusta el empuje o no alcanzaras el objetivo.", p);
+        break;
+    case CodigoAviso::InformeCombustibleBajo:
+        escritos = std::snprintf(destino, capacidad,
+            "Combustible bajo (%.2f%%). Administra mejor la potencia.", p);
+        break;
+    case CodigoAviso::InformeProyeccionVacio:
+        escritos = std::snprintf(destino, capacidad,
+            "Al consumo actual el combustible se agota en %.0f s. Dosifica el empuje.", p);
+        break;
+    case CodigoAviso::InformeFalloRegistrado:
+        escritos = std::snprintf(destino, capacidad,
+            "He registrado un fallo por exceso de velocidad. "
+            "A partir de ahora te avisare antes de superar %.2f m/s.", p);
+        break;
+    case CodigoAviso::InformeFalloAprendido:
+        escritos = std::snprintf(destino, capacidad,
+            "He aprendido de tus fallos anteriores, "
+            "ahora te avisare antes de superar %.2f m/s.", p);
+        break;
+    }
+
+    return escritos > 0 ? static_cast<std::size_t>(escritos) : 0;
+}
+
+RegistroAvisos::RegistroAvisos()
+    : ultimoConsejo(CodigoAviso::Ninguno),
+    relojUltimoConsejo(0.0),
+    hayConsejoPrevio(false) {
+}
+
+bool RegistroAvisos::emitir(const AvisoHAL& aviso, double reloj) {
+    if (aviso.codigo == CodigoAviso::Ninguno) {
+        normalizar();
+        return false;
+    }
+    if (canalDe(aviso.codigo) == CanalAviso::Consola) {
+        registrar(aviso);
+        return true;
+    }
+
+    // Mientras siga la misma situación basta con haberlo dicho una vez
+    if (aviso.codigo == ultimoConsejo) return false;
+
+    if (hayConsejoPrevio && !esUrgente(aviso.codigo) &&
+        reloj - relojUltimoConsejo < INTERVALO_MINIMO) {
+        return false;
+    }
+
+    avisos.agregar(aviso);
+    ultimoConsejo = aviso.codigo;
+    relojUltimoConsejo = reloj;
+    hayConsejoPrevio = true;
+    return true;
+}
+
+void RegistroAvisos::normalizar() {
+    ultimoConsejo = CodigoAviso::Ninguno;
+}
+
+void RegistroAvisos::olvidarConsejos() {
+    ultimoConsejo = CodigoAviso::Ninguno;
+    hayConsejoPrevio = false;
+}
+
+void RegistroAvisos::registrar(const AvisoHAL& informe) {
+    avisos.agregar(informe);
+}
+
+const RegistroAvisos::Historial& RegistroAvisos::obtenerHistorial() const {
+    return avisos;
+}
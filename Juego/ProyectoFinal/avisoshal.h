@@ -0,0 +1,112 @@
+#ifndef AVISOSHAL_H
+#define AVISOSHAL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "buffercircular.h"
+
+// Lo que HAL quiere decir, sin el texto. El texto se arma con
+// formatearAviso() recién cuando el aviso se muestra.
+enum class CodigoAviso : std::uint8_t {
+    Ninguno,
+
+    // Consejos para la interfaz
+    Nivel1VelocidadAlta,
+    Nivel1CombustibleBajo,
+    Nivel2ProgresoExcelente,
+    Nivel2BuenRitmo,
+    Nivel2VelocidadCritica,
+    Nivel2VelocidadMuyAlta,
+    Nivel2VelocidadBaja,
+    Nivel2CombustibleCritico,
+    Nivel2CombustibleBajo,
+    Nivel2CasiAhi,
+    Nivel3AlunizajeImposible,   // parametros[0]: velocidad de impacto mínima (m/s)
+    Nivel3SubirEmpuje,          // parametros[0]: empuje recomendado (N)
+    Nivel3FrenadoImposible,
+    Nivel3HoraDeFrenar,         // parametros[0]: empuje recomendado (N)
+    Nivel3ApagarMotor,
+    Nivel3CorregirIzquierda,
+    Nivel3CorregirDerecha,
+    PrevistoExcesoVelocidad,    // parametros[0]: segundos hasta el fallo
+    PrevistoSinCombustible,     // parametros[0]: segundos hasta el fallo
+    PrevistoImpacto,            // parametros[0]: segundos hasta el fallo
+    AnomaliaConsumo,            // parametros[0]: kg/s de más; [1]: segundos hasta vaciar
+    AnomaliaArrastre,           // parametros[0]: m/s² de frenado de más
+    AnomaliaSaltoVelocidad,     // parametros[0]: cambio de velocidad sin explicar (m/s)
+    ProyeccionVacio,            // parametros[0]: segundos hasta vaciar al consumo medio
+
+    // Informe periódico por consola
+    InformeSinNovedad,
+    InformeVelocidadBaja,        // parametros[0]: velocidad (m/s)
+    InformeVelocidadPeligrosa,   // parametros[0]: velocidad (m/s)
+    InformeCercaLimite,
+    InformeNivel1VelocidadAlta,
+    InformeCombustibleCritico,   // parametros[0]: combustible (%)
+    InformeCombustibleBajo,      // parametros[0]: combustible (%)
+    InformeProyeccionVacio,      // parametros[0]: segundos hasta vaciar al consumo medio
+    InformeFalloRegistrado,      // parametros[0]: nuevo umbral de aviso (m/s)
+    InformeFalloAprendido        // parametros[0]: nuevo umbral de aviso (m/s)
+};
+
+enum class CanalAviso {
+    Interfaz,
+    Consola
+};
+
+struct AvisoHAL {
+    CodigoAviso codigo = CodigoAviso::Ninguno;
+    int nivel = 0;
+    double tiempo = 0.0;                  // Tiempo de simulación (s)
+    std::array<double, 2> parametros{};   // Según el código
+};
+
+CanalAviso canalDe(CodigoAviso codigo);
+
+// Los urgentes no esperan el intervalo mínimo entre avisos
+bool esUrgente(CodigoAviso codigo);
+
+// Escribe el texto del aviso en 'destino' (UTF-8, terminado en cero) sin
+// reservar memoria. Devuelve cuántos bytes ocupa el texto completo, como
+// snprintf.
+std::size_t formatearAviso(const AvisoHAL& aviso, char* destino, std::size_t capacidad);
+
+// Avisos de HAL en un historial de capacidad fija. Los de la interfaz se
+// filtran al entrar: el mismo consejo no se repite mientras la situación
+// siga igual y entre dos consejos pasa al menos INTERVALO_MINIMO (salvo
+// los urgentes). Los informes de consola se guardan siempre.
+class RegistroAvisos {
+public:
+    static constexpr std::size_t CAPACIDAD = 64;
+    static constexpr double INTERVALO_MINIMO = 2.0; // s de reloj entre consejos
+
+    using Historial = BufferCircular<AvisoHAL, CAPACIDAD>;
+
+private:
+    Historial avisos;
+    CodigoAviso ultimoConsejo;
+    double relojUltimoConsejo;
+    bool hayConsejoPrevio;
+
+public:
+    RegistroAvisos();
+
+    // 'reloj' en segundos de cualquier reloj monótono; el intervalo mínimo
+    // es para que se alcance a leer, así que conviene el tiempo real.
+    // Devuelve true si el aviso quedó guardado.
+    bool emitir(const AvisoHAL& aviso, double reloj);
+    // Ya no hay nada que aconsejar: el próximo consejo se acepta aunque
+    // repita el último
+    void normalizar();
+    // Los últimos consejos no llegaron a mostrarse: ni cuentan como dichos
+    // ni hacen esperar al siguiente
+    void olvidarConsejos();
+    void registrar(const AvisoHAL& informe);
+
+    const Historial& obtenerHistorial() const;
+};
+
+using HistorialAvisos = RegistroAvisos::Historial;
+
+#endif // AVISOSHAL_H
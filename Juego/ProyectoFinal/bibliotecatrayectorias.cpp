@@ -0,0 +1,322 @@
+#include "bibliotecatrayectorias.h"
+#include <algorithm>
+#include <cmath>
+#include "ejecutorlotes.h"
+#include "juego.h"
+#include "nivel1_sputnik.h"
+
+double TrayectoriaPrevista::alturaEn(double tiempo) const {
+    if (alturas.empty() || tiempo <= 0.0) {
+        return alturas.empty() ? alturaFinal : alturas.front();
+    }
+    if (tiempo >= tiempoFinal) return alturaFinal;
+
+    const double posicion = tiempo / intervalo;
+    const std::size_t i = static_cast<std::size_t>(posicion);
+    const double fraccion = posicion - i;
+    if (i + 1 < alturas.size()) {
+        return alturas[i] + (alturas[i + 1] - alturas[i]) * fraccion;
+    }
+
+    // Tramo entre la última muestra y el final
+    const double inicio = i * intervalo;
+    const double peso = (tiempo - inicio) / std::max(tiempoFinal - inicio, 1e-9);
+    return alturas.back() + (alturaFinal - alturas.back()) * peso;
+}
+
+std::size_t TrayectoriaPrevista::obtenerBytes() const {
+    return sizeof(TrayectoriaPrevista) + alturas.capacity() * sizeof(double);
+}
+
+BibliotecaTrayectorias::BibliotecaTrayectorias(double pasoFisica, std::size_t memoriaMaximaCache)
+    : paso(pasoFisica),
+    bibliotecaLista(false),
+    ultimaPedida(-1),
+    bytesCache(0),
+    memoriaMaxima(memoriaMaximaCache),
+    // Un hilo propio alcanza: encolar() no corre nada en el que llama y
+    // solo se simula la última velocidad pedida
+    grupo(1)
+{
+    grupo.encolar([this] { construirBiblioteca(); });
+}
+
+void BibliotecaTrayectorias::construirBiblioteca() {
+    // Ayudantes que solo viven mientras se construye; junto con este hilo
+    // dejan un núcleo libre para la partida
+    GrupoHilos ayudantes(std::max(1u, GrupoHilos::hilosDisponibles() - 1) - 1);
+
+    std::vector<double> velocidades;
+    for (int k = 0; k * PASO_BIBLIOTECA_BAJO <= VELOCIDAD_BAJA; ++k) {
+        velocidades.push_back(k * PASO_BIBLIOTECA_BAJO);
+    }
+    for (int k = static_cast<int>(VELOCIDAD_BAJA / PASO_BIBLIOTECA) + 1;
+         k * PASO_BIBLIOTECA <= VELOCIDAD_MAXIMA; ++k) {
+        velocidades.push_back(k * PASO_BIBLIOTECA);
+    }
+
+    std::vector<TrayectoriaPrevista> entradas(velocidades.size());
+    ayudantes.paraCada(velocidades.size(), [&](std::size_t i) {
+        entradas[i] = simular(velocidades[i], paso);
+    });
+
+    // Cada ronda simula el punto medio de los tramos abiertos y lo agrega.
+    // Las dos mitades siguen abiertas si el desenlace cambia en el tramo o
+    // si mezclar los extremos no anticipa el punto medio.
+    std::vector<char> abiertos(entradas.size() - 1, 1);
+    while (std::find(abiertos.begin(), abiertos.end(), 1) != abiertos.end()) {
+        std::vector<std::size_t> tramos;
+        for (std::size_t i = 0; i < abiertos.size(); ++i) {
+            if (abiertos[i]) tramos.push_back(i);
+        }
+
+        std::vector<TrayectoriaPrevista> medios(tramos.size());
+        ayudantes.paraCada(tramos.size(), [&](std::size_t j) {
+            const std::size_t i = tramos[j];
+            medios[j] = simular(0.5 * (entradas[i].velocidadInicial + entradas[i + 1].velocidadInicial),
+                                paso);
+        });
+
+        std::vector<TrayectoriaPrevista> refinadas;
+        std::vector<char> siguientes;
+        refinadas.reserve(entradas.size() + medios.size());
+        std::size_t j = 0;
+        for (std::size_t i = 0; i + 1 < entradas.size(); ++i) {
+            refinadas.push_back(std::move(entradas[i]));
+            if (j == tramos.size() || tramos[j] != i) {
+                siguientes.push_back(0);
+                continue;
+            }
+
+            const TrayectoriaPrevista& a = refinadas.back();
+            const TrayectoriaPrevista& b = entradas[i + 1];
+            TrayectoriaPrevista& medio = medios[j++];
+            const char dividir =
+                (b.velocidadInicial - a.velocidadInicial) / 2.0 > PASO_MINIMO_BIBLIOTECA &&
+                (a.desenlace != b.desenlace || medio.desenlace != b.desenlace ||
+                 diferenciaMaxima(mezclar(a, b, 0.5), medio) > TOLERANCIA_BIBLIOTECA);
+            refinadas.push_back(std::move(medio));
+            siguientes.push_back(dividir);
+            siguientes.push_back(dividir);
+        }
+        refinadas.push_back(std::move(entradas.back()));
+
+        entradas = std::move(refinadas);
+        abiertos = std::move(siguientes);
+    }
+
+    biblioteca = std::move(entradas);
+    bibliotecaLista.store(true, std::memory_order_release);
+}
+
+bool BibliotecaTrayectorias::estaLista() const {
+    return bibliotecaLista.load(std::memory_order_acquire);
+}
+
+long long BibliotecaTrayectorias::clave(double velocidadInicial) {
+    return std::llround(velocidadInicial * 100.0);
+}
+
+TrayectoriaPrevista BibliotecaTrayectorias::simular(double velocidadInicial, double pasoFisica) {
+    Mision mision;
+    mision.nivel = 1;
+    mision.velocidadInicial = velocidadInicial;
+    mision.pasoFisica = pasoFisica;
+
+    Juego juego;
+    juego.establecerModoSilencioso(true);
+    EjecutorLotes::prepararMision(juego, mision);
+    const Cohete* cohete = juego.obtenerCohete();
+
+    TrayectoriaPrevista trayectoria;
+    trayectoria.velocidadInicial = velocidadInicial;
+    trayectoria.intervalo = INTERVALO_MUESTRA;
+    trayectoria.alturas.push_back(cohete->obtenerAltura());
+    trayectoria.alturaApogeo = cohete->obtenerAltura();
+
+    // Paso a paso para no perder el apogeo entre dos muestras
+    long muestra = 1;
+    bool enSuelo = false;
+    while (juego.estaEnEjecucion() && !juego.haGanado() && !juego.haPerdido()) {
+        if (juego.avanzar(1) == 0) break;
+
+        const double t = juego.obtenerTiempoSimulacion();
+        if (cohete->obtenerAltura() > trayectoria.alturaApogeo) {
+            trayectoria.alturaApogeo = cohete->obtenerAltura();
+            trayectoria.tiempoApogeo = t;
+        }
+        if (t >= muestra * INTERVALO_MUESTRA - 1e-9) {
+            trayectoria.alturas.push_back(cohete->obtenerAltura());
+            ++muestra;
+        }
+        // Sin motor, lo que vuelve al suelo sano ya no se mueve más
+        if (cohete->obtenerAltura() <= 0.0 && !cohete->estaDanado()) {
+            enSuelo = true;
+            break;
+        }
+    }
+    trayectoria.alturas.shrink_to_fit();
+
+    // Mismo criterio que Juego::obtenerRazonDerrota para el nivel 1
+    trayectoria.tiempoFinal = juego.haGanado() || juego.haPerdido()
+                                  ? juego.obtenerTiempoFinal()
+                                  : juego.obtenerTiempoSimulacion();
+    trayectoria.alturaFinal = cohete->obtenerAltura();
+    if (juego.haGanado()) {
+        trayectoria.desenlace = DesenlaceTrayectoria::Orbita;
+    } else if (cohete->estaDanado()) {
+        const Nivel1_Sputnik nivel;
+        trayectoria.desenlace = cohete->obtenerVelocidad() > nivel.obtenerVelocidadCritica()
+                                    ? DesenlaceTrayectoria::Quemadura
+                                    : DesenlaceTrayectoria::Impacto;
+    } else if (enSuelo && trayectoria.alturaApogeo > 0.0) {
+        trayectoria.desenlace = DesenlaceTrayectoria::Aterrizaje;
+        // El instante exacto del contacto, no el final del paso
+        const auto& eventos = juego.obtenerEventos();
+        for (auto it = eventos.rbegin(); it != eventos.rend(); ++it) {
+            if (it->tipo == TipoEvento::Contacto) {
+                trayectoria.tiempoFinal = it->tiempo;
+                break;
+            }
+        }
+    } else if (enSuelo) {
+        trayectoria.desenlace = DesenlaceTrayectoria::SinDespegue;
+        trayectoria.tiempoFinal = 0.0;
+    } else {
+        trayectoria.desenlace = DesenlaceTrayectoria::TiempoAgotado;
+    }
+    return trayectoria;
+}
+
+TrayectoriaPrevista BibliotecaTrayectorias::mezclar(const TrayectoriaPrevista& a,
+                                                    const TrayectoriaPrevista& b, double peso) {
+    TrayectoriaPrevista resultado;
+    if (a.desenlace != b.desenlace) {
+        resultado = peso < 0.5 ? a : b;
+    } else {
+        auto mezcla = [peso](double x, double y) { return x + (y - x) * peso; };
+
+        resultado.intervalo = INTERVALO_MUESTRA;
+        resultado.desenlace = a.desenlace;
+        resultado.tiempoFinal = mezcla(a.tiempoFinal, b.tiempoFinal);
+        resultado.alturaFinal = mezcla(a.alturaFinal, b.alturaFinal);
+        resultado.tiempoApogeo = mezcla(a.tiempoApogeo, b.tiempoApogeo);
+        resultado.alturaApogeo = mezcla(a.alturaApogeo, b.alturaApogeo);
+
+        // Cada muestra se compara con el mismo avance relativo del vuelo
+        // en las dos vecinas
+        const std::size_t muestras =
+            static_cast<std::size_t>(resultado.tiempoFinal / INTERVALO_MUESTRA) + 1;
+        resultado.alturas.reserve(muestras);
+        for (std::size_t k = 0; k < muestras; ++k) {
+            const double avance = resultado.tiempoFinal > 0.0
+                                      ? k * INTERVALO_MUESTRA / resultado.tiempoFinal
+                                      : 0.0;
+            resultado.alturas.push_back(mezcla(a.alturaEn(avance * a.tiempoFinal),
+                                               b.alturaEn(avance * b.tiempoFinal)));
+        }
+    }
+    resultado.velocidadInicial = a.velocidadInicial + (b.velocidadInicial - a.velocidadInicial) * peso;
+    resultado.exacta = false;
+    return resultado;
+}
+
+double BibliotecaTrayectorias::diferenciaMaxima(const TrayectoriaPrevista& a,
+                                                const TrayectoriaPrevista& b) {
+    const double fin = std::max(a.tiempoFinal, b.tiempoFinal);
+    double maxima = std::abs(a.alturaEn(fin) - b.alturaEn(fin));
+    for (long k = 0; k * INTERVALO_MUESTRA < fin; ++k) {
+        const double t = k * INTERVALO_MUESTRA;
+        maxima = std::max(maxima, std::abs(a.alturaEn(t) - b.alturaEn(t)));
+    }
+    return maxima;
+}
+
+TrayectoriaPrevista BibliotecaTrayectorias::interpolar(double velocidadInicial) const {
+    const auto siguiente = std::upper_bound(
+        biblioteca.begin(), biblioteca.end(), velocidadInicial,
+        [](double v, const TrayectoriaPrevista& entrada) { return v < entrada.velocidadInicial; });
+    const std::size_t i =
+        std::clamp<std::size_t>(siguiente - biblioteca.begin(), 1, biblioteca.size() - 1) - 1;
+    const TrayectoriaPrevista& a = biblioteca[i];
+    const TrayectoriaPrevista& b = biblioteca[i + 1];
+
+    TrayectoriaPrevista resultado = mezclar(
+        a, b, (velocidadInicial - a.velocidadInicial) / (b.velocidadInicial - a.velocidadInicial));
+    resultado.velocidadInicial = velocidadInicial;
+    return resultado;
+}
+
+TrayectoriaPrevista BibliotecaTrayectorias::prever(double velocidadInicial) {
+    velocidadInicial = std::clamp(velocidadInicial, 0.0, VELOCIDAD_MAXIMA);
+    if (!estaLista()) {
+        TrayectoriaPrevista vacia;
+        vacia.velocidadInicial = velocidadInicial;
+        vacia.exacta = false;
+        return vacia;
+    }
+
+    const auto entrada = std::lower_bound(
+        biblioteca.begin(), biblioteca.end(), velocidadInicial - 0.005,
+        [](const TrayectoriaPrevista& e, double v) { return e.velocidadInicial < v; });
+    if (entrada != biblioteca.end() && std::abs(entrada->velocidadInicial - velocidadInicial) < 0.005) {
+        return *entrada;
+    }
+
+    const long long k = clave(velocidadInicial);
+    {
+        std::lock_guard<std::mutex> lock(mutexCache);
+        ultimaPedida = k;
+
+        auto it = cache.find(k);
+        if (it != cache.end()) {
+            usoReciente.splice(usoReciente.begin(), usoReciente, it->second);
+            return *it->second;
+        }
+        if (pendientes.insert(k).second) {
+            grupo.encolar([this, k] { calcularEnSegundoPlano(k); });
+        }
+    }
+    return interpolar(velocidadInicial);
+}
+
+void BibliotecaTrayectorias::calcularEnSegundoPlano(long long claveVelocidad) {
+    {
+        std::lock_guard<std::mutex> lock(mutexCache);
+        if (claveVelocidad != ultimaPedida) {
+            pendientes.erase(claveVelocidad);
+            return;
+        }
+    }
+
+    TrayectoriaPrevista trayectoria = simular(claveVelocidad / 100.0, paso);
+
+    std::lock_guard<std::mutex> lock(mutexCache);
+    pendientes.erase(claveVelocidad);
+    bytesCache += trayectoria.obtenerBytes();
+    usoReciente.push_front(std::move(trayectoria));
+    cache[claveVelocidad] = usoReciente.begin();
+
+    while (bytesCache > memoriaMaxima && usoReciente.size() > 1) {
+        const TrayectoriaPrevista& vieja = usoReciente.back();
+        bytesCache -= vieja.obtenerBytes();
+        cache.erase(clave(vieja.velocidadInicial));
+        usoReciente.pop_back();
+    }
+}
+
+bool BibliotecaTrayectorias::hayCalculosPendientes() const {
+    if (!estaLista()) return true;
+    std::lock_guard<std::mutex> lock(mutexCache);
+    return !pendientes.empty();
+}
+
+std::size_t BibliotecaTrayectorias::obtenerEntradasCache() const {
+    std::lock_guard<std::mutex> lock(mutexCache);
+    return cache.size();
+}
+
+std::size_t BibliotecaTrayectorias::obtenerBytesCache() const {
+    std::lock_guard<std::mutex> lock(mutexCache);
+    return bytesCache;
+}
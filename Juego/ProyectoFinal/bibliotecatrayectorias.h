@@ -0,0 +1,120 @@
+#ifndef BIBLIOTECATRAYECTORIAS_H
+#define BIBLIOTECATRAYECTORIAS_H
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "grupohilos.h"
+
+enum class DesenlaceTrayectoria {
+    Orbita,        // Llega a los 100 km
+    Quemadura,     // Supera la velocidad crítica dentro de la atmósfera
+    Impacto,       // Vuelve a caer y se daña contra el suelo
+    Aterrizaje,    // Vuelve a caer y se posa sin daño
+    SinDespegue,   // No llega a separarse del suelo
+    TiempoAgotado
+};
+
+// Vuelo del nivel 1 con el motor apagado desde una velocidad inicial
+struct TrayectoriaPrevista {
+    double velocidadInicial = 0.0;
+    double intervalo = 1.0;        // s entre muestras de 'alturas'
+    std::vector<double> alturas;   // m, la primera en t = 0
+    double tiempoApogeo = 0.0;
+    double alturaApogeo = 0.0;
+    double tiempoFinal = 0.0;
+    double alturaFinal = 0.0;      // Donde se quema, se estrella, se posa o llega
+    DesenlaceTrayectoria desenlace = DesenlaceTrayectoria::TiempoAgotado;
+    bool exacta = true;            // false: interpolada entre dos vecinas
+
+    double alturaEn(double tiempo) const;
+    std::size_t obtenerBytes() const;
+};
+
+// Previsión instantánea de la trayectoria del nivel 1 mientras el jugador
+// elige la velocidad inicial. La biblioteca se simula en segundo plano al
+// construirse: una grilla de PASO_BIBLIOTECA m/s (PASO_BIBLIOTECA_BAJO por
+// debajo de VELOCIDAD_BAJA, donde están los saltos cortos) que después se
+// subdivide donde cambia el desenlace o donde interpolar entre dos vecinas
+// se aleja más de TOLERANCIA_BIBLIOTECA de la simulación del punto medio.
+// Entre dos entradas se interpola en tiempo normalizado, que respeta la
+// forma de la curva aunque duren distinto. Si las vecinas terminan de forma
+// distinta no se mezclan y se usa la más cercana.
+//
+// Una velocidad que no está en la biblioteca se simula en segundo plano y
+// queda en una caché LRU acotada en bytes; la siguiente consulta es exacta.
+// Solo se simula la última velocidad pedida: las que el jugador dejó atrás
+// mientras giraba el control se descartan.
+class BibliotecaTrayectorias {
+public:
+    static constexpr double VELOCIDAD_MAXIMA = 10000.0; // Igual que spinVelocidadInicial
+    static constexpr double PASO_BIBLIOTECA = 250.0;
+    static constexpr double VELOCIDAD_BAJA = 600.0;
+    static constexpr double PASO_BIBLIOTECA_BAJO = 25.0;
+    static constexpr double TOLERANCIA_BIBLIOTECA = 100.0; // m
+    static constexpr double PASO_MINIMO_BIBLIOTECA = 0.01; // m/s, la resolución del control
+    static constexpr double INTERVALO_MUESTRA = 1.0;     // s
+
+private:
+    double paso;
+    // Ordenada por velocidad inicial. Solo se lee después de que
+    // 'bibliotecaLista' pasa a true.
+    std::vector<TrayectoriaPrevista> biblioteca;
+    std::atomic<bool> bibliotecaLista;
+
+    // Caché de velocidades fuera de la biblioteca, en centésimas de m/s
+    // (la resolución del control). La lista va de la más a la menos usada.
+    mutable std::mutex mutexCache;
+    std::list<TrayectoriaPrevista> usoReciente;
+    std::unordered_map<long long, std::list<TrayectoriaPrevista>::iterator> cache;
+    std::unordered_set<long long> pendientes;
+    long long ultimaPedida;
+    std::size_t bytesCache;
+    std::size_t memoriaMaxima;
+
+    // Un solo hilo: primero construye la biblioteca y después simula la
+    // velocidad pendiente. Último miembro: se destruye primero y espera a
+    // las tareas, que usan todo lo anterior.
+    GrupoHilos grupo;
+
+    static long long clave(double velocidadInicial);
+    // Interpolación entre 'a' y 'b' con peso 0 en 'a' y 1 en 'b'
+    static TrayectoriaPrevista mezclar(const TrayectoriaPrevista& a, const TrayectoriaPrevista& b,
+                                       double peso);
+    // Mayor diferencia de altura, muestreada cada INTERVALO_MUESTRA
+    static double diferenciaMaxima(const TrayectoriaPrevista& a, const TrayectoriaPrevista& b);
+    void construirBiblioteca();
+    TrayectoriaPrevista interpolar(double velocidadInicial) const;
+    void calcularEnSegundoPlano(long long claveVelocidad);
+
+public:
+    // 'pasoFisica' debe ser el de la partida para que la previsión
+    // coincida con el vuelo. 'memoriaMaximaCache' acota los bytes de
+    // muestras guardados en la caché.
+    explicit BibliotecaTrayectorias(double pasoFisica, std::size_t memoriaMaximaCache = 1 << 20);
+
+    BibliotecaTrayectorias(const BibliotecaTrayectorias&) = delete;
+    BibliotecaTrayectorias& operator=(const BibliotecaTrayectorias&) = delete;
+
+    // true cuando terminó de simularse la biblioteca
+    bool estaLista() const;
+
+    // No espera nunca: exacta si está en la biblioteca o en la caché; si no,
+    // interpolada, y se encola su simulación. Antes de estaLista() devuelve
+    // una trayectoria vacía (sin alturas) y no encola nada.
+    TrayectoriaPrevista prever(double velocidadInicial);
+    // Incluye la construcción de la biblioteca
+    bool hayCalculosPendientes() const;
+
+    std::size_t obtenerEntradasCache() const;
+    std::size_t obtenerBytesCache() const;
+
+    // Simulación completa con Juego, la misma física que la partida
+    static TrayectoriaPrevista simular(double velocidadInicial, double pasoFisica);
+};
+
+#endif // BIBLIOTECATRAYECTORIAS_H
@@ -0,0 +1,53 @@
+#ifndef BUFFERCIRCULAR_H
+#define BUFFERCIRCULAR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Historial de capacidad fija que pisa lo más viejo al llenarse. Cada
+// elemento tiene un número de secuencia creciente, así un lector que guarda
+// el siguiente número a leer sabe qué es nuevo y si se perdió algo. No
+// reserva memoria y se copia por valor (por ejemplo en una instantánea).
+// No es seguro entre hilos: se comparte copiándolo.
+template<class T, std::size_t Capacidad>
+class BufferCircular {
+    static_assert(Capacidad >= 1, "BufferCircular necesita capacidad");
+
+private:
+    std::array<T, Capacidad> elementos;
+    std::uint64_t total; // Elementos agregados desde el inicio
+
+public:
+    BufferCircular() : elementos(), total(0) {}
+
+    void agregar(const T& elemento) {
+        elementos[total % Capacidad] = elemento;
+        ++total;
+    }
+
+    void limpiar() {
+        total = 0;
+    }
+
+    // Número de secuencia que tendrá el próximo elemento
+    std::uint64_t obtenerTotal() const {
+        return total;
+    }
+
+    // El más viejo que todavía no se pisó
+    std::uint64_t obtenerPrimero() const {
+        return total > Capacidad ? total - Capacidad : 0;
+    }
+
+    // Solo para obtenerPrimero() <= secuencia < obtenerTotal()
+    const T& obtener(std::uint64_t secuencia) const {
+        return elementos[secuencia % Capacidad];
+    }
+
+    static constexpr std::size_t capacidad() {
+        return Capacidad;
+    }
+};
+
+#endif // BUFFERCIRCULAR_H
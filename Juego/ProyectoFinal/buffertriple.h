@@ -0,0 +1,53 @@
+#ifndef BUFFERTRIPLE_H
+#define BUFFERTRIPLE_H
+
+#include <atomic>
+
+// Traspaso sin bloqueos del último valor publicado entre un único escritor y
+// un único lector. Hay tres copias: la que escribe el productor, la que lee
+// el consumidor y una intermedia que se intercambian con un solo atomic.
+// Ninguno de los dos espera nunca al otro: el escritor siempre tiene una copia
+// libre y el lector siempre ve una copia completa (nunca una a medio escribir).
+// Si el lector es más lento se pierden los valores intermedios, solo se
+// conserva el último.
+template<class T>
+class BufferTriple {
+private:
+    static constexpr unsigned MASCARA_INDICE = 3u;
+    static constexpr unsigned BIT_NUEVO = 4u; // La intermedia aún no fue leída
+
+    T copias[3];
+    std::atomic<unsigned> intermedia;
+    unsigned escritura; // Solo la toca el escritor
+    unsigned lectura;   // Solo la toca el lector
+
+public:
+    BufferTriple() : copias(), intermedia(1u), escritura(0u), lectura(2u) {}
+    explicit BufferTriple(const T& inicial)
+        : copias{inicial, inicial, inicial}, intermedia(1u), escritura(0u), lectura(2u) {}
+
+    BufferTriple(const BufferTriple&) = delete;
+    BufferTriple& operator=(const BufferTriple&) = delete;
+
+    // Lado del escritor: completar obtenerEscritura() y luego publicar()
+    T& obtenerEscritura() { return copias[escritura]; }
+
+    void publicar() {
+        const unsigned anterior = intermedia.exchange(escritura | BIT_NUEVO,
+                                                      std::memory_order_acq_rel);
+        escritura = anterior & MASCARA_INDICE;
+    }
+
+    // Lado del lector: true si había un valor nuevo y pasó a obtenerLectura()
+    bool actualizarLectura() {
+        if (!(intermedia.load(std::memory_order_relaxed) & BIT_NUEVO)) return false;
+
+        const unsigned anterior = intermedia.exchange(lectura, std::memory_order_acq_rel);
+        lectura = anterior & MASCARA_INDICE;
+        return true;
+    }
+
+    const T& obtenerLectura() const { return copias[lectura]; }
+};
+
+#endif // BUFFERTRIPLE_H
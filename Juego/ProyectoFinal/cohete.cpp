@@ -1,12 +1,13 @@
-#include "Cohete.h"
+#include "cohete.h"
 #include <algorithm>
+#include "modeloambiental.h"
 
 Cohete::Cohete()
     : velocidad(0.0), altura(0.0), posicionX(0.0), velocidadX(0.0), 
     combustible(8000.0), combustibleMaximo(8000.0),
     empuje(0.0), masa(3000.0 + 8000.0), masaSeca(3000.0),
     danado(false), tripulado(false),
-    aceleracion(0.0), velocidadAnterior(0.0){}
+    aceleracion(0.0), velocidadAnterior(0.0), velocidadImpacto(0.0){}
 
 void Cohete::actualizarEstado(double deltaTime) {
     if (deltaTime <= 0.0) return;
@@ -18,14 +19,36 @@ void Cohete::actualizarEstado(double deltaTime) {
     
     // Actualizar posición horizontal
     posicionX += velocidadX * deltaTime;
+}
+
+void Cohete::aplicarEstadoIntegrado(double nuevaAltura, double nuevaVelocidad,
+                                    double nuevoCombustible, double deltaTime) {
+    if (deltaTime <= 0.0) return;
+
+    combustible = std::clamp(nuevoCombustible, 0.0, combustibleMaximo);
+    calcularMasaActual();
+    if (!tieneCombustible()) {
+        empuje = 0.0;
+    }
 
+    aceleracion = (nuevaVelocidad - velocidadAnterior) / deltaTime;
+    velocidadAnterior = nuevaVelocidad;
+
+    velocidad = nuevaVelocidad;
+    altura = nuevaAltura;
+    posicionX += velocidadX * deltaTime;
+}
+
+void Cohete::resolverContactoSuelo(double velocidadContacto) {
     if (altura <= 0.0) {
-        if (velocidad < -300.0) {
+        velocidadImpacto = velocidadContacto;
+        if (velocidadContacto < -300.0) {
             danado = true;
         }
 
         altura = 0.0;
         velocidad = 0.0;
+        velocidadAnterior = 0.0; // La aceleración del paso siguiente parte del reposo
     }
 }
 
@@ -34,8 +57,7 @@ void Cohete::ajustarEmpuje(double nuevoEmpuje) {
         empuje = 0.0;
         return;
     }
-    const double EMPUJE_MAX = 500000.0;
-    empuje = std::clamp(nuevoEmpuje, 0.0, EMPUJE_MAX);
+    empuje = std::clamp(nuevoEmpuje, 0.0, EMPUJE_MAXIMO);
 }
 
 double Cohete::obtenerVelocidad() const {
@@ -75,10 +97,18 @@ double Cohete::obtenerMasa() const {
     return masa;
 }
 
+double Cohete::obtenerMasaSeca() const {
+    return masaSeca;
+}
+
 double Cohete::obtenerAceleracion() const {
     return aceleracion;
 }
 
+double Cohete::obtenerVelocidadImpacto() const {
+    return velocidadImpacto;
+}
+
 bool Cohete::estaDanado() const {
     return danado;
 }
@@ -173,6 +203,7 @@ void Cohete::reiniciarEstado() {
     empuje = 0.0;
     danado = false;
     aceleracion = 0.0;
+    velocidadImpacto = 0.0;
 
     combustible = combustibleMaximo;
     calcularMasaActual();
@@ -219,7 +250,7 @@ bool Cohete::tieneCombustible() const {
 }
 
 bool Cohete::estaEnAtmosfera() const {
-    return altura < 100000.0;
+    return altura < ModeloAmbiental::ALTURA_ATMOSFERA;
 }
 
 void Cohete::establecerCombustible(double comb) {
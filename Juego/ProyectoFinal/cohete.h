@@ -19,11 +19,23 @@ private:
 
     double aceleracion;
     double velocidadAnterior;
+    double velocidadImpacto; // Velocidad vertical en el último contacto con el suelo
 
 public:
+    static constexpr double EMPUJE_MAXIMO = 500000.0; // N
+
     Cohete();
 
+    // Ninguno de los dos apoya el cohete en el suelo: el nivel busca antes
+    // el instante exacto del contacto y luego llama a resolverContactoSuelo
     void actualizarEstado(double deltaTime);
+    // Carga el resultado de un integrador (altura, velocidad y combustible
+    // al final del paso) y completa el resto del estado como actualizarEstado
+    void aplicarEstadoIntegrado(double nuevaAltura, double nuevaVelocidad,
+                                double nuevoCombustible, double deltaTime);
+    // Si la altura quedó <= 0 deja el cohete apoyado y lo daña si
+    // 'velocidadContacto' supera el límite de impacto
+    void resolverContactoSuelo(double velocidadContacto);
     void ajustarEmpuje(double nuevoEmpuje);
 
     double obtenerVelocidad() const;
@@ -35,7 +47,9 @@ public:
     double obtenerPorcentajeCombustible() const;
     double obtenerEmpuje() const;
     double obtenerMasa() const;
+    double obtenerMasaSeca() const;
     double obtenerAceleracion() const;
+    double obtenerVelocidadImpacto() const;
     bool estaDanado() const;
     bool esTripulado() const;
 
@@ -0,0 +1,397 @@
+#include "cohetebatch.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "modeloambiental.h"
+#include "nivel1_sputnik.h"
+#include "nivel2_vostok.h"
+#include "nivel3_apolo11.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define COHETEBATCH_AVX2 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COHETEBATCH_SSE2 1
+#endif
+
+namespace {
+
+const double VELOCIDAD_IMPACTO_MAX = 300.0;
+const double EMPUJE_MAX = 500000.0;
+
+// Las operaciones de cada ancho de vector comparten nombre para que los
+// kernels se escriban una sola vez como plantilla. El ancho 1 (escalar)
+// procesa los cohetes que sobran al final del lote.
+struct OpsEscalar {
+    using Vector = double;
+    using Mascara = bool;
+    using Indices = int;
+    static constexpr std::size_t ANCHO = 1;
+
+    static Vector cargar(const double* p) { return *p; }
+    static void guardar(double* p, Vector a) { *p = a; }
+    static Vector difundir(double x) { return x; }
+
+    static Vector sumar(Vector a, Vector b) { return a + b; }
+    static Vector restar(Vector a, Vector b) { return a - b; }
+    static Vector multiplicar(Vector a, Vector b) { return a * b; }
+    static Vector dividir(Vector a, Vector b) { return a / b; }
+    static Vector maximo(Vector a, Vector b) { return a > b ? a : b; }
+    static Vector minimo(Vector a, Vector b) { return a < b ? a : b; }
+    static Vector copiarSigno(Vector magnitud, Vector signo) { return std::copysign(magnitud, signo); }
+
+    static Indices truncar(Vector a) { return static_cast<int>(a); }
+    static Vector aDoble(Indices k) { return static_cast<double>(k); }
+    static Vector reunir(const double* tabla, Indices k) { return tabla[k]; }
+
+    static Mascara menor(Vector a, Vector b) { return a < b; }
+    static Mascara menorIgual(Vector a, Vector b) { return a <= b; }
+    static Mascara mayor(Vector a, Vector b) { return a > b; }
+    static Mascara distinto(Vector a, Vector b) { return a != b; }
+    static Mascara y(Mascara a, Mascara b) { return a && b; }
+
+    static Vector elegir(Mascara m, Vector siVerdadero, Vector siFalso) {
+        return m ? siVerdadero : siFalso;
+    }
+    static int bits(Mascara m) { return m ? 1 : 0; }
+};
+
+#ifdef COHETEBATCH_SSE2
+struct OpsSSE2 {
+    using Vector = __m128d;
+    using Mascara = __m128d;
+    using Indices = __m128i;
+    static constexpr std::size_t ANCHO = 2;
+
+    static Vector cargar(const double* p) { return _mm_loadu_pd(p); }
+    static void guardar(double* p, Vector a) { _mm_storeu_pd(p, a); }
+    static Vector difundir(double x) { return _mm_set1_pd(x); }
+
+    static Vector sumar(Vector a, Vector b) { return _mm_add_pd(a, b); }
+    static Vector restar(Vector a, Vector b) { return _mm_sub_pd(a, b); }
+    static Vector multiplicar(Vector a, Vector b) { return _mm_mul_pd(a, b); }
+    static Vector dividir(Vector a, Vector b) { return _mm_div_pd(a, b); }
+    static Vector maximo(Vector a, Vector b) { return _mm_max_pd(a, b); }
+    static Vector minimo(Vector a, Vector b) { return _mm_min_pd(a, b); }
+    static Vector copiarSigno(Vector magnitud, Vector signo) {
+        const __m128d s = _mm_set1_pd(-0.0);
+        return _mm_or_pd(_mm_andnot_pd(s, magnitud), _mm_and_pd(s, signo));
+    }
+
+    static Indices truncar(Vector a) { return _mm_cvttpd_epi32(a); }
+    static Vector aDoble(Indices k) { return _mm_cvtepi32_pd(k); }
+    static Vector reunir(const double* tabla, Indices k) {
+        return _mm_set_pd(tabla[_mm_cvtsi128_si32(_mm_srli_si128(k, 4))],
+                          tabla[_mm_cvtsi128_si32(k)]);
+    }
+
+    static Mascara menor(Vector a, Vector b) { return _mm_cmplt_pd(a, b); }
+    static Mascara menorIgual(Vector a, Vector b) { return _mm_cmple_pd(a, b); }
+    static Mascara mayor(Vector a, Vector b) { return _mm_cmpgt_pd(a, b); }
+    static Mascara distinto(Vector a, Vector b) { return _mm_cmpneq_pd(a, b); }
+    static Mascara y(Mascara a, Mascara b) { return _mm_and_pd(a, b); }
+
+    static Vector elegir(Mascara m, Vector siVerdadero, Vector siFalso) {
+        return _mm_or_pd(_mm_and_pd(m, siVerdadero), _mm_andnot_pd(m, siFalso));
+    }
+    static int bits(Mascara m) { return _mm_movemask_pd(m); }
+};
+#endif
+
+#ifdef COHETEBATCH_AVX2
+struct OpsAVX2 {
+    using Vector = __m256d;
+    using Mascara = __m256d;
+    using Indices = __m128i;
+    static constexpr std::size_t ANCHO = 4;
+
+    static Vector cargar(const double* p) { return _mm256_loadu_pd(p); }
+    static void guardar(double* p, Vector a) { _mm256_storeu_pd(p, a); }
+    static Vector difundir(double x) { return _mm256_set1_pd(x); }
+
+    static Vector sumar(Vector a, Vector b) { return _mm256_add_pd(a, b); }
+    static Vector restar(Vector a, Vector b) { return _mm256_sub_pd(a, b); }
+    static Vector multiplicar(Vector a, Vector b) { return _mm256_mul_pd(a, b); }
+    static Vector dividir(Vector a, Vector b) { return _mm256_div_pd(a, b); }
+    static Vector maximo(Vector a, Vector b) { return _mm256_max_pd(a, b); }
+    static Vector minimo(Vector a, Vector b) { return _mm256_min_pd(a, b); }
+    static Vector copiarSigno(Vector magnitud, Vector signo) {
+        const __m256d s = _mm256_set1_pd(-0.0);
+        return _mm256_or_pd(_mm256_andnot_pd(s, magnitud), _mm256_and_pd(s, signo));
+    }
+
+    static Indices truncar(Vector a) { return _mm256_cvttpd_epi32(a); }
+    static Vector aDoble(Indices k) { return _mm256_cvtepi32_pd(k); }
+    static Vector reunir(const double* tabla, Indices k) {
+        // Cuatro cargas sueltas: la tabla es pequeña y cabe en L1, y en la
+        // mayoría de los procesadores rinden igual que vgatherdpd.
+        return _mm256_set_pd(tabla[_mm_extract_epi32(k, 3)], tabla[_mm_extract_epi32(k, 2)],
+                             tabla[_mm_extract_epi32(k, 1)], tabla[_mm_extract_epi32(k, 0)]);
+    }
+
+    static Mascara menor(Vector a, Vector b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static Mascara menorIgual(Vector a, Vector b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    static Mascara mayor(Vector a, Vector b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static Mascara distinto(Vector a, Vector b) { return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ); }
+    static Mascara y(Mascara a, Mascara b) { return _mm256_and_pd(a, b); }
+
+    static Vector elegir(Mascara m, Vector siVerdadero, Vector siFalso) {
+        return _mm256_blendv_pd(siFalso, siVerdadero, m);
+    }
+    static int bits(Mascara m) { return _mm256_movemask_pd(m); }
+};
+#endif
+
+// ModeloAmbiental::factorDensidad para h >= 0 con el mismo orden de
+// operaciones, de modo que el lote coincide bit a bit con los niveles.
+template<class O>
+typename O::Vector factorDensidad(typename O::Vector h) {
+    using V = typename O::Vector;
+    using Modelo = ModeloAmbiental;
+
+    h = O::minimo(O::maximo(h, O::difundir(0.0)), O::difundir(Modelo::ALTURA_ATMOSFERA));
+
+    const typename O::Indices k = O::truncar(O::multiplicar(h, O::difundir(Modelo::INVERSO_PASO)));
+    const V desplazamiento = O::restar(h, O::multiplicar(O::aDoble(k), O::difundir(Modelo::PASO_TABLA)));
+    const V u = O::multiplicar(desplazamiento, O::difundir(Modelo::INVERSO_ESCALA));
+
+    V p = O::difundir(Modelo::SERIE[Modelo::GRADO_SERIE]);
+    for (int n = Modelo::GRADO_SERIE - 1; n >= 0; --n) {
+        p = O::sumar(O::multiplicar(p, u), O::difundir(Modelo::SERIE[n]));
+    }
+
+    return O::multiplicar(O::reunir(Modelo::TABLA_DENSIDAD.valores, k), p);
+}
+
+struct ArreglosLote {
+    double* altura;
+    double* velocidad;
+    double* combustible;
+    double* masa;
+    const double* masaSeca;
+    double* empuje;
+    unsigned char* danado;
+};
+
+// Avanza los cohetes [i, i + ANCHO). Sigue el orden de
+// Nivel1_Sputnik/Nivel2_Vostok/Nivel3_Apolo11::aplicarFisica.
+template<class O>
+void avanzarBloque(const ArreglosLote& d, std::size_t i,
+                   const ParametrosLote& p, double deltaTime) {
+    using V = typename O::Vector;
+    using M = typename O::Mascara;
+
+    const V cero = O::difundir(0.0);
+    const V dt = O::difundir(deltaTime);
+
+    const V h0 = O::cargar(d.altura + i);
+    const V v0 = O::cargar(d.velocidad + i);
+    V h = h0;
+    V v = v0;
+    V comb = O::cargar(d.combustible + i);
+    V masa = O::cargar(d.masa + i);
+    V emp = O::cargar(d.empuje + i);
+    const V masaSeca = O::cargar(d.masaSeca + i);
+
+    // Empuje y consumo (Cohete::consumirCombustible)
+    const M conEmpuje = O::y(O::mayor(comb, cero), O::mayor(emp, cero));
+    const V aceleracion = O::dividir(emp, masa);
+    v = O::elegir(conEmpuje, O::sumar(v, O::multiplicar(aceleracion, dt)), v);
+
+    const V consumo = O::multiplicar(O::dividir(emp, O::difundir(p.factorConsumo)), dt);
+    V restante = O::restar(comb, consumo);
+    restante = O::elegir(O::menor(restante, cero), cero, restante);
+    comb = O::elegir(conEmpuje, restante, comb);
+    masa = O::elegir(conEmpuje, O::sumar(masaSeca, comb), masa);
+    emp = O::elegir(O::y(conEmpuje, O::menorIgual(comb, cero)), cero, emp);
+
+    // Gravedad
+    V g = O::difundir(p.gravedad);
+    if (p.gravedadRadial) {
+        const V radio = O::difundir(p.radio);
+        const V x = O::dividir(radio, O::sumar(radio, h));
+        g = O::multiplicar(g, O::multiplicar(x, x));
+    }
+    v = O::restar(v, O::multiplicar(g, dt));
+
+    // Resistencia del aire, solo dentro de la atmósfera
+    const M enAtmosfera = O::menor(h, O::difundir(ModeloAmbiental::ALTURA_ATMOSFERA));
+    if (p.resistencia > 0.0) {
+        const V densidad = factorDensidad<O>(h);
+        const V k = O::multiplicar(O::difundir(p.resistencia), densidad);
+        const V arrastre = O::dividir(O::multiplicar(O::multiplicar(k, v), v), masa);
+        const V frenado = O::copiarSigno(O::multiplicar(arrastre, dt), v);
+        v = O::elegir(O::y(enAtmosfera, O::distinto(v, cero)), O::restar(v, frenado), v);
+    }
+
+    // Posición (Cohete::actualizarEstado)
+    h = O::sumar(h, O::multiplicar(v, dt));
+
+    // Eventos del paso con las fórmulas de InterpolacionLineal. Los cruces
+    // son raros, así que las divisiones solo se hacen si algún carril cruzó.
+    const M suelo = O::menorIgual(h, cero);
+    const M cruceSuelo = O::y(suelo, O::mayor(h0, cero));
+    V vContacto = v;
+    if (O::bits(cruceSuelo) != 0) {
+        const V fraccion = O::dividir(O::restar(cero, h0), O::restar(h, h0));
+        vContacto = O::elegir(cruceSuelo, O::sumar(v0, O::multiplicar(fraccion, O::restar(v, v0))), v);
+    }
+
+    const V limite = O::difundir(p.velocidadLimite);
+    int dano = 0;
+    if (p.limiteSoloEnAtmosfera) {
+        // Sputnik se quema si cruza la velocidad crítica dentro de la
+        // atmósfera aunque termine el paso fuera de ella
+        const M cruceLimite = O::y(O::menorIgual(v0, limite), O::mayor(v, limite));
+        if (O::bits(cruceLimite) != 0) {
+            const V fraccion = O::dividir(O::restar(limite, v0), O::restar(v, v0));
+            const V hCruce = O::sumar(h0, O::multiplicar(fraccion, O::restar(h, h0)));
+            dano |= O::bits(O::y(cruceLimite,
+                                 O::menor(hCruce, O::difundir(ModeloAmbiental::ALTURA_ATMOSFERA))));
+        }
+    }
+
+    // Contacto con el suelo (Cohete::resolverContactoSuelo y, en la Luna,
+    // el rango de aterrizaje de Nivel3_Apolo11)
+    const V rapidezContacto = O::maximo(vContacto, O::restar(cero, vContacto));
+    dano |= O::bits(O::y(suelo, O::menor(vContacto, O::difundir(-VELOCIDAD_IMPACTO_MAX))));
+    dano |= O::bits(O::y(suelo, O::mayor(rapidezContacto, O::difundir(p.velocidadAterrizajeMax))));
+    h = O::elegir(suelo, cero, h);
+    v = O::elegir(suelo, cero, v);
+
+    // Exceso de velocidad
+    M exceso = O::mayor(v, limite);
+    if (p.limiteSoloEnAtmosfera) {
+        exceso = O::y(exceso, O::menor(h, O::difundir(ModeloAmbiental::ALTURA_ATMOSFERA)));
+    }
+    dano |= O::bits(exceso);
+
+    O::guardar(d.altura + i, h);
+    O::guardar(d.velocidad + i, v);
+    O::guardar(d.combustible + i, comb);
+    O::guardar(d.masa + i, masa);
+    O::guardar(d.empuje + i, emp);
+
+    if (dano != 0) {
+        for (std::size_t l = 0; l < O::ANCHO; ++l) {
+            if (dano & (1 << l)) d.danado[i + l] = 1;
+        }
+    }
+}
+
+// Avanza bloques completos de ANCHO cohetes desde 'inicio' y devuelve el
+// primer índice que quedó sin procesar.
+template<class O>
+std::size_t avanzarBloques(const ArreglosLote& d, std::size_t inicio, std::size_t fin,
+                           const ParametrosLote& p, double deltaTime) {
+    std::size_t i = inicio;
+    for (; i + O::ANCHO <= fin; i += O::ANCHO) {
+        avanzarBloque<O>(d, i, p, deltaTime);
+    }
+    return i;
+}
+
+} // namespace
+
+ParametrosLote ParametrosLote::desdeNivel(const Nivel1_Sputnik& nivel) {
+    return {nivel.obtenerFactorConsumo(), Nivel1_Sputnik::Cuerpo::GRAVEDAD_SUPERFICIE, true,
+            Nivel1_Sputnik::Cuerpo::RADIO, nivel.obtenerResistenciaAire(),
+            nivel.obtenerVelocidadCritica(), true,
+            std::numeric_limits<double>::infinity()};
+}
+
+ParametrosLote ParametrosLote::desdeNivel(const Nivel2_Vostok& nivel) {
+    return {nivel.obtenerFactorConsumo(), Nivel2_Vostok::Cuerpo::GRAVEDAD_SUPERFICIE, true,
+            Nivel2_Vostok::Cuerpo::RADIO, nivel.obtenerResistenciaAire(),
+            nivel.obtenerVelocidadMaxima(), false,
+            std::numeric_limits<double>::infinity()};
+}
+
+ParametrosLote ParametrosLote::desdeNivel(const Nivel3_Apolo11& nivel) {
+    return {nivel.obtenerFactorConsumo(), Nivel3_Apolo11::Cuerpo::GRAVEDAD_SUPERFICIE, false,
+            Nivel3_Apolo11::Cuerpo::RADIO, 0.0,
+            std::numeric_limits<double>::infinity(), false,
+            nivel.obtenerVelocidadAterrizajeMax()};
+}
+
+CoheteBatch::CoheteBatch(std::size_t cantidad) {
+    redimensionar(cantidad);
+}
+
+void CoheteBatch::redimensionar(std::size_t cantidad) {
+    altura.resize(cantidad, 0.0);
+    velocidad.resize(cantidad, 0.0);
+    combustible.resize(cantidad, 0.0);
+    masa.resize(cantidad, 0.0);
+    masaSeca.resize(cantidad, 0.0);
+    empuje.resize(cantidad, 0.0);
+    danado.resize(cantidad, 0);
+}
+
+std::size_t CoheteBatch::obtenerCantidad() const {
+    return altura.size();
+}
+
+void CoheteBatch::cargar(std::size_t i, const Cohete& cohete) {
+    altura[i] = cohete.obtenerAltura();
+    velocidad[i] = cohete.obtenerVelocidad();
+    combustible[i] = cohete.obtenerCombustible();
+    masa[i] = cohete.obtenerMasa();
+    masaSeca[i] = cohete.obtenerMasaSeca();
+    empuje[i] = cohete.obtenerEmpuje();
+    danado[i] = cohete.estaDanado() ? 1 : 0;
+}
+
+void CoheteBatch::volcar(std::size_t i, Cohete& cohete) const {
+    cohete.establecerMasa(masaSeca[i]);
+    cohete.establecerCombustible(combustible[i]);
+    cohete.establecerAltura(altura[i]);
+    cohete.establecerVelocidadInicial(velocidad[i]);
+    cohete.ajustarEmpuje(empuje[i]);
+    if (danado[i]) {
+        cohete.marcarDanado();
+    }
+}
+
+void CoheteBatch::ajustarEmpuje(std::size_t i, double nuevoEmpuje) {
+    if (!(combustible[i] > 0.0)) {
+        empuje[i] = 0.0;
+        return;
+    }
+    empuje[i] = std::clamp(nuevoEmpuje, 0.0, EMPUJE_MAX);
+}
+
+void CoheteBatch::avanzar(const ParametrosLote& parametros, double deltaTime) {
+    avanzar(parametros, deltaTime, 0, obtenerCantidad());
+}
+
+void CoheteBatch::avanzar(const ParametrosLote& parametros, double deltaTime,
+                          std::size_t inicio, std::size_t fin) {
+    if (deltaTime <= 0.0) return;
+    fin = std::min(fin, obtenerCantidad());
+
+    const ArreglosLote d{altura.data(), velocidad.data(), combustible.data(), masa.data(),
+                         masaSeca.data(), empuje.data(), danado.data()};
+
+    std::size_t i = inicio;
+#ifdef COHETEBATCH_AVX2
+    i = avanzarBloques<OpsAVX2>(d, i, fin, parametros, deltaTime);
+#endif
+#ifdef COHETEBATCH_SSE2
+    i = avanzarBloques<OpsSSE2>(d, i, fin, parametros, deltaTime);
+#endif
+    avanzarBloques<OpsEscalar>(d, i, fin, parametros, deltaTime);
+}
+
+const char* CoheteBatch::obtenerConjuntoInstrucciones() {
+#if defined(COHETEBATCH_AVX2)
+    return "AVX2";
+#elif defined(COHETEBATCH_SSE2)
+    return "SSE2";
+#else
+    return "escalar";
+#endif
+}
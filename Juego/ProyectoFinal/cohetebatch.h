@@ -0,0 +1,79 @@
+#ifndef COHETEBATCH_H
+#define COHETEBATCH_H
+
+#include <cstddef>
+#include <vector>
+#include "cohete.h"
+
+class Nivel1_Sputnik;
+class Nivel2_Vostok;
+class Nivel3_Apolo11;
+
+// Constantes físicas de un nivel que necesitan los kernels del lote
+struct ParametrosLote {
+    double factorConsumo;
+    double gravedad;
+    bool gravedadRadial;        // g * (R / (R + h))^2 en la Tierra, constante en la Luna
+    double radio;               // Radio del cuerpo del nivel
+    double resistencia;         // 0 = sin atmósfera
+    double velocidadLimite;     // Por encima de esta velocidad el cohete se daña
+    bool limiteSoloEnAtmosfera; // Sputnik solo se quema dentro de la atmósfera
+    double velocidadAterrizajeMax; // |v| máxima al tocar el suelo (infinito en la Tierra)
+
+    static ParametrosLote desdeNivel(const Nivel1_Sputnik& nivel);
+    static ParametrosLote desdeNivel(const Nivel2_Vostok& nivel);
+    static ParametrosLote desdeNivel(const Nivel3_Apolo11& nivel);
+};
+
+// Muchos cohetes guardados como estructura de arreglos: cada magnitud vive
+// en un arreglo contiguo para que los kernels SIMD avancen 2 (SSE2) o 4
+// (AVX2) cohetes por instrucción.
+//
+// avanzar() reproduce el paso de Euler de aplicarFisica de cada nivel en el
+// mismo orden de operaciones (empuje y consumo, gravedad, resistencia,
+// posición, contacto con el suelo y daño) y con el mismo ModeloAmbiental,
+// así que coincide bit a bit con el camino escalar, incluidos los cruces del
+// suelo y de la velocidad límite dentro del paso. No modela el movimiento
+// horizontal del nivel 3 ni la colocación inicial del descenso: quien carga
+// el lote debe dejar el cohete a la altura y velocidad de partida.
+class CoheteBatch {
+private:
+    std::vector<double> altura;
+    std::vector<double> velocidad;
+    std::vector<double> combustible;
+    std::vector<double> masa;
+    std::vector<double> masaSeca;
+    std::vector<double> empuje;
+    std::vector<unsigned char> danado;
+
+public:
+    explicit CoheteBatch(std::size_t cantidad = 0);
+
+    void redimensionar(std::size_t cantidad);
+    std::size_t obtenerCantidad() const;
+
+    void cargar(std::size_t i, const Cohete& cohete);
+    // Copia el estado vertical al cohete (marca el daño si corresponde)
+    void volcar(std::size_t i, Cohete& cohete) const;
+
+    // Mismas reglas que Cohete::ajustarEmpuje
+    void ajustarEmpuje(std::size_t i, double nuevoEmpuje);
+
+    double obtenerAltura(std::size_t i) const { return altura[i]; }
+    double obtenerVelocidad(std::size_t i) const { return velocidad[i]; }
+    double obtenerCombustible(std::size_t i) const { return combustible[i]; }
+    double obtenerMasa(std::size_t i) const { return masa[i]; }
+    double obtenerEmpuje(std::size_t i) const { return empuje[i]; }
+    bool estaDanado(std::size_t i) const { return danado[i] != 0; }
+
+    // Un paso de física para todos los cohetes o para [inicio, fin). Rangos
+    // disjuntos pueden avanzarse desde hilos distintos.
+    void avanzar(const ParametrosLote& parametros, double deltaTime);
+    void avanzar(const ParametrosLote& parametros, double deltaTime,
+                 std::size_t inicio, std::size_t fin);
+
+    // "AVX2", "SSE2" o "escalar", según lo habilitado al compilar
+    static const char* obtenerConjuntoInstrucciones();
+};
+
+#endif // COHETEBATCH_H
@@ -0,0 +1,55 @@
+#ifndef COLASPSC_H
+#define COLASPSC_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Cola circular sin bloqueos para un único productor y un único consumidor.
+// La capacidad es fija (potencia de dos) y no reserva memoria al encolar.
+// Cabeza y cola van en líneas de caché distintas para que los dos hilos no
+// se invaliden la caché mutuamente.
+template<class T, std::size_t Capacidad>
+class ColaSPSC {
+    static_assert(Capacidad >= 2 && (Capacidad & (Capacidad - 1)) == 0,
+                  "La capacidad de ColaSPSC debe ser potencia de dos");
+
+private:
+    static constexpr std::size_t MASCARA = Capacidad - 1;
+
+    std::array<T, Capacidad> elementos;
+    alignas(64) std::atomic<std::size_t> cabeza; // Próximo a leer (consumidor)
+    alignas(64) std::atomic<std::size_t> cola;   // Próximo a escribir (productor)
+
+public:
+    ColaSPSC() : elementos(), cabeza(0), cola(0) {}
+
+    ColaSPSC(const ColaSPSC&) = delete;
+    ColaSPSC& operator=(const ColaSPSC&) = delete;
+
+    // Productor. Devuelve false si la cola está llena.
+    bool encolar(const T& elemento) {
+        const std::size_t posicion = cola.load(std::memory_order_relaxed);
+        if (posicion - cabeza.load(std::memory_order_acquire) == Capacidad) return false;
+
+        elementos[posicion & MASCARA] = elemento;
+        cola.store(posicion + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor. Devuelve false si la cola está vacía.
+    bool desencolar(T& elemento) {
+        const std::size_t posicion = cabeza.load(std::memory_order_relaxed);
+        if (posicion == cola.load(std::memory_order_acquire)) return false;
+
+        elemento = elementos[posicion & MASCARA];
+        cabeza.store(posicion + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool estaVacia() const {
+        return cabeza.load(std::memory_order_acquire) == cola.load(std::memory_order_acquire);
+    }
+};
+
+#endif // COLASPSC_H
@@ -0,0 +1,63 @@
+#ifndef CUERPOCELESTE_H
+#define CUERPOCELESTE_H
+
+#include <cmath>
+
+// Datos de cada cuerpo. GRAVEDAD_SUPERFICIE es la gravedad de juego que usan
+// los niveles (redondeada), no GM / R^2.
+struct Tierra {
+    static constexpr double MASA = 5.972e24;
+    static constexpr double RADIO = 6371000.0;
+    static constexpr double GRAVEDAD_SUPERFICIE = 9.81;
+    static constexpr bool TIENE_ATMOSFERA = true;
+};
+
+struct Luna {
+    static constexpr double MASA = 7.342e22;
+    static constexpr double RADIO = 1737000.0;
+    static constexpr double GRAVEDAD_SUPERFICIE = 1.62;
+    static constexpr bool TIENE_ATMOSFERA = false;
+};
+
+// Modelo gravitatorio de un cuerpo resuelto en compilación: GM y las
+// constantes derivadas son constexpr y cada nivel elige su cuerpo con un
+// alias de tipo, así que no hay ramas por cuerpo ni productos G * M en los
+// bucles. Para agregar un cuerpo basta con otra estructura como Tierra.
+template<class Cuerpo>
+class CuerpoCeleste {
+public:
+    static constexpr double G = 6.67430e-11;
+    static constexpr double MASA = Cuerpo::MASA;
+    static constexpr double RADIO = Cuerpo::RADIO;
+    static constexpr double GM = G * MASA;
+    static constexpr double DOS_GM = 2.0 * GM;
+    static constexpr double GRAVEDAD_SUPERFICIE = Cuerpo::GRAVEDAD_SUPERFICIE;
+    static constexpr double GRAVEDAD_NEWTONIANA = GM / (RADIO * RADIO);
+    static constexpr bool TIENE_ATMOSFERA = Cuerpo::TIENE_ATMOSFERA;
+
+    // g = GM / r^2
+    static double aceleracionGravedad(double altura) {
+        const double r = RADIO + altura;
+        return GM / (r * r);
+    }
+
+    static double fuerzaGravedad(double altura, double masa) {
+        return aceleracionGravedad(altura) * masa;
+    }
+
+    // Gravedad de juego: GRAVEDAD_SUPERFICIE * (R / (R + h))^2
+    static double gravedadRelativa(double altura) {
+        const double x = RADIO / (RADIO + altura);
+        return GRAVEDAD_SUPERFICIE * (x * x);
+    }
+
+    static double velocidadOrbital(double altura) {
+        return std::sqrt(GM / (RADIO + altura));
+    }
+
+    static double velocidadEscape(double altura) {
+        return std::sqrt(DOS_GM / (RADIO + altura));
+    }
+};
+
+#endif // CUERPOCELESTE_H
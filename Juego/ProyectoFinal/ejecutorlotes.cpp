@@ -0,0 +1,111 @@
+#include "ejecutorlotes.h"
+#include "juego.h"
+#include <algorithm>
+
+namespace {
+
+ResultadoMision resumirMision(const Juego& juego) {
+    const Cohete* cohete = juego.obtenerCohete();
+
+    ResultadoMision resultado;
+    resultado.victoria = juego.haGanado();
+    resultado.terminada = juego.haGanado() || juego.haPerdido();
+    resultado.tiempo = juego.obtenerTiempoFinal();
+    resultado.combustibleRestante = cohete->obtenerCombustible();
+    resultado.alturaFinal = cohete->obtenerAltura();
+    resultado.velocidadFinal = cohete->obtenerVelocidad();
+    if (!resultado.victoria) {
+        resultado.razonDerrota = juego.obtenerRazonDerrota();
+    }
+    return resultado;
+}
+
+}
+
+EjecutorLotes::EjecutorLotes(unsigned numeroHilos)
+    : grupo((numeroHilos == 0 ? GrupoHilos::hilosDisponibles() : numeroHilos) - 1) {
+    // El hilo que llama a ejecutar() también trabaja, por eso el grupo
+    // se crea con un hilo menos de los pedidos.
+}
+
+std::vector<ResultadoMision> EjecutorLotes::ejecutar(const std::vector<Mision>& misiones) {
+    std::vector<ResultadoMision> resultados(misiones.size());
+
+    grupo.paraCada(misiones.size(), [&](std::size_t i) {
+        Juego juego;
+        juego.establecerModoSilencioso(true);
+        resultados[i] = ejecutarMision(juego, misiones[i]);
+    });
+
+    return resultados;
+}
+
+ResultadoMision EjecutorLotes::ejecutarMision(Juego& juego, const Mision& mision) {
+    prepararMision(juego, mision);
+    if (mision.autopiloto) {
+        return completarConAutopiloto(juego);
+    }
+    return completarMision(juego, mision.programa);
+}
+
+void EjecutorLotes::prepararMision(Juego& juego, const Mision& mision) {
+    juego.establecerPasoFisica(mision.pasoFisica);
+    juego.establecerIntegrador(mision.integrador, mision.tolerancia);
+    juego.establecerAvanceBalistico(mision.avanceBalistico);
+    juego.establecerSensores(mision.sensores, mision.configuracionSensores);
+    juego.iniciarNivel(mision.nivel);
+    if (mision.nivel == 3) {
+        if (mision.velocidadInicial != 0.0) {
+            juego.establecerVelocidadDescenso(mision.velocidadInicial);
+        }
+    } else {
+        // En el nivel 2 representa la velocidad heredada del nivel 1
+        juego.establecerVelocidadInicial(mision.velocidadInicial);
+    }
+    if (mision.combustibleInicial >= 0.0) {
+        juego.establecerCombustibleInicial(mision.combustibleInicial);
+    }
+    if (mision.factorResistencia != 1.0) {
+        juego.establecerResistenciaAire(juego.obtenerNivel()->obtenerResistenciaAire() *
+                                        mision.factorResistencia);
+    }
+    juego.iniciarSimulacion();
+}
+
+ResultadoMision EjecutorLotes::completarMision(Juego& juego, const ProgramaEmpuje& programa,
+                                               double tiempoMaximo) {
+    // El empuje solo cambia al empezar un tramo: entre cambios se avanza
+    // de una vez, sin volver a consultar el programa en cada paso.
+    std::size_t cursor = 0;
+    while (juego.estaEnEjecucion() && !juego.haGanado() && !juego.haPerdido()) {
+        const double t = juego.obtenerTiempoSimulacion();
+        if (t >= tiempoMaximo) break;
+
+        juego.ajustarEmpuje(programa.empujeEn(t, cursor));
+        const double limite = std::min(programa.siguienteCambio(t, cursor), tiempoMaximo);
+        if (juego.avanzarHasta(limite) == 0) {
+            break;
+        }
+    }
+
+    return resumirMision(juego);
+}
+
+ResultadoMision EjecutorLotes::completarConAutopiloto(Juego& juego, double tiempoMaximo) {
+    while (juego.estaEnEjecucion() && !juego.haGanado() && !juego.haPerdido()) {
+        if (juego.obtenerTiempoSimulacion() >= tiempoMaximo) break;
+
+        const ConsignaAlunizaje consigna = juego.calcularConsignaAutopiloto();
+        juego.ajustarEmpuje(consigna.empuje);
+        if (consigna.cambioVelocidadX != 0.0) {
+            juego.moverCoheteHorizontal(consigna.cambioVelocidadX);
+        }
+        juego.actualizar();
+    }
+
+    return resumirMision(juego);
+}
+
+unsigned EjecutorLotes::obtenerNumeroHilos() const {
+    return grupo.obtenerNumeroHilos() + 1;
+}
@@ -0,0 +1,68 @@
+#ifndef EJECUTORLOTES_H
+#define EJECUTORLOTES_H
+
+#include <limits>
+#include <string>
+#include <vector>
+#include "grupohilos.h"
+#include "programaempuje.h"
+#include "sensorescohete.h"
+#include "sistemafisica.h"
+
+class Juego;
+
+// Descripción de una misión independiente para simular sin interfaz.
+struct Mision {
+    int nivel = 1;
+    double velocidadInicial = 0.0;   // Nivel 2: heredada del 1. Nivel 3: vertical al empezar
+                                     // el descenso (negativa; 0 deja la del nivel)
+    double combustibleInicial = -1.0; // Negativo: el tanque lleno del nivel
+    double factorResistencia = 1.0;  // Multiplica el arrastre del nivel
+    ProgramaEmpuje programa;
+    TipoIntegrador integrador = TipoIntegrador::Euler;
+    double pasoFisica = 0.1;
+    double tolerancia = 1e-6;        // Solo para Dormand-Prince
+    bool avanceBalistico = false;    // Saltar los planeos en forma cerrada
+    bool autopiloto = false;         // Nivel 3: PilotoAlunizaje en lugar del programa
+    bool sensores = false;           // El piloto vuela con la estimación de sensores con ruido
+    ConfiguracionSensores configuracionSensores;
+};
+
+struct ResultadoMision {
+    bool victoria;
+    double tiempo;               // Instante exacto del evento que terminó la misión
+    double combustibleRestante;
+    double alturaFinal;
+    double velocidadFinal;
+    std::string razonDerrota;
+    bool terminada = true;       // false si se cortó por tiempoMaximo antes del final
+};
+
+// Ejecuta lotes de misiones de Juego en paralelo usando todos los núcleos.
+class EjecutorLotes {
+private:
+    GrupoHilos grupo;
+
+public:
+    // numeroHilos == 0 usa todos los núcleos disponibles
+    explicit EjecutorLotes(unsigned numeroHilos = 0);
+
+    std::vector<ResultadoMision> ejecutar(const std::vector<Mision>& misiones);
+
+    // Corre una misión completa sobre 'juego' hasta victoria o derrota.
+    static ResultadoMision ejecutarMision(Juego& juego, const Mision& mision);
+    // Configura 'juego' con las condiciones de la misión y la inicia
+    static void prepararMision(Juego& juego, const Mision& mision);
+
+    // Sigue una partida ya iniciada aplicando 'programa' (tiempos absolutos
+    // de simulación) hasta victoria, derrota o 'tiempoMaximo'.
+    static ResultadoMision completarMision(Juego& juego, const ProgramaEmpuje& programa,
+                                           double tiempoMaximo = std::numeric_limits<double>::infinity());
+    // Igual, pero cada paso sigue la consigna del piloto automático del nivel 3
+    static ResultadoMision completarConAutopiloto(Juego& juego,
+                                                  double tiempoMaximo = std::numeric_limits<double>::infinity());
+
+    unsigned obtenerNumeroHilos() const;
+};
+
+#endif // EJECUTORLOTES_H
@@ -0,0 +1,30 @@
+#ifndef ESTADOJUEGO_H
+#define ESTADOJUEGO_H
+
+#include <cstddef>
+#include "agentehal69.h"
+#include "cohete.h"
+#include "monitortelemetria.h"
+#include "nivel.h"
+
+// Todo lo que cambia durante una partida, por valor y sin memoria dinámica:
+// restaurarlo sobre un Juego con el mismo nivel cargado (o sobre uno nuevo,
+// que carga el nivel) deja la simulación exactamente en ese punto.
+struct EstadoJuego {
+    int nivel = 0;
+    long paso = 0;                      // Pasos de física desde el inicio del nivel
+    Cohete cohete;
+    Cohete coheteAnterior;
+    EstadoNivel estadoNivel;
+    EstadoHAL estadoHAL;
+    MonitorTelemetria telemetria;
+    double tiempoSimulacion = 0.0;
+    double tiempoControl = 0.0;
+    double tiempoFinal = 0.0;
+    std::size_t eventosRegistrados = 0; // El registro solo crece: se recorta a este largo
+    bool enEjecucion = false;
+    bool victoria = false;
+    bool derrota = false;
+};
+
+#endif // ESTADOJUEGO_H
@@ -0,0 +1,103 @@
+#include "evaluadorrobustez.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "generadorsplitmix.h"
+#include "juego.h"
+
+namespace {
+
+double percentil(const std::vector<double>& ordenados, double p) {
+    if (ordenados.empty()) return 0.0;
+    const std::size_t rango = static_cast<std::size_t>(std::ceil(p * ordenados.size()));
+    return ordenados[std::clamp<std::size_t>(rango, 1, ordenados.size()) - 1];
+}
+
+} // namespace
+
+EvaluadorRobustez::EvaluadorRobustez(unsigned numeroHilos)
+    : grupo((numeroHilos == 0 ? GrupoHilos::hilosDisponibles() : numeroHilos) - 1) {
+    // Como en EjecutorLotes, el hilo que llama a evaluar() también trabaja
+}
+
+Mision EvaluadorRobustez::perturbar(const Mision& base, const Dispersiones& dispersiones,
+                                    std::uint64_t semilla, std::size_t indice) {
+    GeneradorSplitMix generador(semilla, indice);
+
+    // Se sortean siempre las cuatro variables para que cada una use los
+    // mismos números aunque otra esté desactivada
+    const double zEmpuje = generador.normal();
+    const double zResistencia = generador.normal();
+    const double zCombustible = generador.normal();
+    const double zDescenso = generador.normal();
+
+    Mision mision = base;
+    // Cada escenario con sensores lee su propio ruido
+    mision.configuracionSensores.semilla = generador.siguiente();
+    mision.programa = base.programa.escalado(std::max(0.0, 1.0 + dispersiones.empuje * zEmpuje));
+    mision.factorResistencia = base.factorResistencia *
+                               std::max(0.0, 1.0 + dispersiones.resistenciaAire * zResistencia);
+
+    if (dispersiones.combustible > 0.0) {
+        // Los niveles arrancan con el tanque lleno, que es el mismo en todos;
+        // Juego recorta a esa capacidad
+        const double nominal = base.combustibleInicial >= 0.0 ? base.combustibleInicial
+                                                               : Cohete().obtenerCombustibleMaximo();
+        mision.combustibleInicial = std::max(0.0, nominal * (1.0 + dispersiones.combustible * zCombustible));
+    }
+
+    if (base.nivel == 3) {
+        // Nunca arranca subiendo ni detenido (0 pediría la del nivel)
+        const double nominal = base.velocidadInicial != 0.0
+                                   ? base.velocidadInicial
+                                   : Nivel3_Apolo11().obtenerVelocidadDescensoInicial();
+        mision.velocidadInicial = std::min(-0.1, nominal + dispersiones.velocidadDescenso * zDescenso);
+    }
+
+    return mision;
+}
+
+ResultadoRobustez EvaluadorRobustez::evaluar(const Mision& base, const Dispersiones& dispersiones,
+                                             std::size_t escenarios, std::uint64_t semilla) {
+    std::vector<ResultadoMision> resultados(escenarios);
+
+    grupo.paraCada(escenarios, [&](std::size_t i) {
+        Juego juego;
+        juego.establecerModoSilencioso(true);
+        resultados[i] = EjecutorLotes::ejecutarMision(juego, perturbar(base, dispersiones, semilla, i));
+    });
+
+    // El resumen se arma en orden de índice: no depende del reparto
+    ResultadoRobustez resumen;
+    resumen.escenarios = escenarios;
+
+    std::vector<double> combustibles;
+    for (const ResultadoMision& r : resultados) {
+        if (r.victoria) {
+            combustibles.push_back(r.combustibleRestante);
+        } else {
+            ++resumen.razonesDerrota[r.razonDerrota];
+        }
+    }
+    resumen.victorias = combustibles.size();
+
+    if (escenarios > 0) {
+        const double n = static_cast<double>(escenarios);
+        const double p = resumen.victorias / n;
+        const double z = 1.96;
+        resumen.probabilidadExito = p;
+        resumen.margenExito95 = z * std::sqrt(p * (1.0 - p) / n + z * z / (4.0 * n * n)) /
+                                (1.0 + z * z / n);
+    }
+
+    std::sort(combustibles.begin(), combustibles.end());
+    resumen.combustibleP5 = percentil(combustibles, 0.05);
+    resumen.combustibleP50 = percentil(combustibles, 0.50);
+    resumen.combustibleP95 = percentil(combustibles, 0.95);
+
+    return resumen;
+}
+
+unsigned EvaluadorRobustez::obtenerNumeroHilos() const {
+    return grupo.obtenerNumeroHilos() + 1;
+}
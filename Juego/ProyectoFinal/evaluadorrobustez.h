@@ -0,0 +1,56 @@
+#ifndef EVALUADORROBUSTEZ_H
+#define EVALUADORROBUSTEZ_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include "ejecutorlotes.h"
+#include "grupohilos.h"
+
+// Desvíos estándar de las perturbaciones (0 desactiva cada una)
+struct Dispersiones {
+    double empuje = 0.02;           // Fracción del empuje pedido (eficiencia del motor)
+    double resistenciaAire = 0.10;  // Fracción del coeficiente de arrastre del nivel
+    double combustible = 0.02;      // Fracción del combustible de partida
+    double velocidadDescenso = 5.0; // m/s, solo nivel 3
+};
+
+struct ResultadoRobustez {
+    std::size_t escenarios = 0;
+    std::size_t victorias = 0;
+    double probabilidadExito = 0.0;
+    double margenExito95 = 0.0; // Semiancho del intervalo de Wilson al 95 %
+
+    // Combustible restante (kg) en los escenarios ganados
+    double combustibleP5 = 0.0;
+    double combustibleP50 = 0.0;
+    double combustibleP95 = 0.0;
+
+    // Cantidad de derrotas por Juego::obtenerRazonDerrota
+    std::map<std::string, std::size_t> razonesDerrota;
+};
+
+// Corre una misión (programa de empuje y condiciones iniciales) contra
+// miles de escenarios perturbados en paralelo. Cada escenario toma sus
+// números de una secuencia propia derivada de (semilla, índice), así que el
+// resultado no depende de cuántos hilos haya ni de cómo se repartan.
+class EvaluadorRobustez {
+private:
+    GrupoHilos grupo;
+
+public:
+    // numeroHilos == 0 usa todos los núcleos disponibles
+    explicit EvaluadorRobustez(unsigned numeroHilos = 0);
+
+    ResultadoRobustez evaluar(const Mision& base, const Dispersiones& dispersiones,
+                              std::size_t escenarios, std::uint64_t semilla = 1);
+
+    // Escenario 'indice': la misión base con sus perturbaciones aplicadas
+    static Mision perturbar(const Mision& base, const Dispersiones& dispersiones,
+                            std::uint64_t semilla, std::size_t indice);
+
+    unsigned obtenerNumeroHilos() const;
+};
+
+#endif // EVALUADORROBUSTEZ_H
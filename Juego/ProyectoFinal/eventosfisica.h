@@ -0,0 +1,90 @@
+#ifndef EVENTOSFISICA_H
+#define EVENTOSFISICA_H
+
+#include "sistemafisica.h"
+
+// Cruces de umbral que se detectan dentro de un paso de física
+enum class TipoEvento {
+    AlturaObjetivo,  // Sube por encima de la altura objetivo del nivel
+    Contacto,        // Toca el suelo bajando
+    SinCombustible,  // Se agota el combustible
+    LimiteVelocidad  // Supera la velocidad máxima del nivel
+};
+
+struct EventoFisica {
+    TipoEvento tipo;
+    double instante;        // Segundos desde el inicio del paso
+    EstadoDinamico estado;  // Estado exacto en ese instante
+};
+
+inline const char* obtenerNombreEvento(TipoEvento tipo) {
+    switch (tipo) {
+    case TipoEvento::AlturaObjetivo:  return "Altura objetivo";
+    case TipoEvento::Contacto:        return "Contacto con el suelo";
+    case TipoEvento::SinCombustible:  return "Sin combustible";
+    case TipoEvento::LimiteVelocidad: return "Limite de velocidad";
+    }
+    return "";
+}
+
+// Estado dentro de un paso de Euler: interpolación lineal entre el estado
+// inicial y el final, que es la salida densa de orden 1 del método. Los
+// cruces se resuelven en forma cerrada; CoheteBatch repite estas mismas
+// fórmulas para coincidir bit a bit.
+class InterpolacionLineal {
+private:
+    EstadoDinamico inicio;
+    EstadoDinamico fin;
+
+public:
+    InterpolacionLineal(const EstadoDinamico& y0, const EstadoDinamico& y1)
+        : inicio(y0), fin(y1) {}
+
+    // Fracción del paso en que 'magnitud' vale 'umbral' (los extremos deben
+    // estar a lados opuestos del umbral)
+    double cruce(double EstadoDinamico::* magnitud, double umbral) const {
+        const double a = inicio.*magnitud;
+        return (umbral - a) / (fin.*magnitud - a);
+    }
+
+    EstadoDinamico estado(double fraccion) const {
+        return {inicio.altura + fraccion * (fin.altura - inicio.altura),
+                inicio.velocidad + fraccion * (fin.velocidad - inicio.velocidad),
+                inicio.combustible + fraccion * (fin.combustible - inicio.combustible)};
+    }
+};
+
+// Estado dentro de un paso de RK4, Verlet o Dormand-Prince: se vuelve a
+// integrar desde el inicio del paso con el mismo método, así que el cruce
+// tiene la precisión del integrador sin importar el largo del paso.
+// 'propagar(duracion)' devuelve el estado tras 'duracion' segundos.
+template<class Propagar>
+class InterpolacionIntegrada {
+private:
+    const Propagar& propagar;
+    EstadoDinamico inicio;
+    EstadoDinamico fin;
+    double deltaTime;
+
+    static constexpr double TOLERANCIA = 1e-10; // En fracción del paso
+
+public:
+    InterpolacionIntegrada(const Propagar& p, const EstadoDinamico& y0,
+                           const EstadoDinamico& y1, double dt)
+        : propagar(p), inicio(y0), fin(y1), deltaTime(dt) {}
+
+    double cruce(double EstadoDinamico::* magnitud, double umbral) const {
+        auto g = [&](double fraccion) {
+            return propagar(fraccion * deltaTime).*magnitud - umbral;
+        };
+        return SistemaFisica::buscarRaiz(g, 0.0, inicio.*magnitud - umbral,
+                                         1.0, fin.*magnitud - umbral, TOLERANCIA);
+    }
+
+    EstadoDinamico estado(double fraccion) const {
+        if (fraccion >= 1.0) return fin;
+        return propagar(fraccion * deltaTime);
+    }
+};
+
+#endif // EVENTOSFISICA_H
@@ -0,0 +1,87 @@
+#include "exploradoralternativas.h"
+#include "juego.h"
+#include <algorithm>
+
+ExploradorAlternativas::ExploradorAlternativas(unsigned numeroHilos, double horizonteSegundos)
+    : grupo(numeroHilos == 0 ? std::max(1u, GrupoHilos::hilosDisponibles() - 1) : numeroHilos),
+    horizonte(horizonteSegundos) {
+}
+
+ExploradorAlternativas::~ExploradorAlternativas() {
+    // Las tareas aún en cola terminan enseguida; el grupo las espera
+    descartar();
+}
+
+void ExploradorAlternativas::lanzar(const Juego& juego, const std::vector<ProgramaEmpuje>& alternativas) {
+    descartar();
+
+    auto exploracion = std::make_shared<Exploracion>();
+    exploracion->origen = juego.capturarEstado();
+    exploracion->pasoFisica = juego.obtenerPasoFisica();
+    exploracion->integrador = juego.obtenerIntegrador();
+    exploracion->tolerancia = juego.obtenerToleranciaIntegrador();
+    exploracion->avanceBalistico = juego.tieneAvanceBalistico();
+
+    const double inicio = exploracion->origen.tiempoSimulacion;
+    exploracion->tiempoMaximo = inicio + horizonte;
+
+    // Pasar los programas a tiempo absoluto una sola vez
+    exploracion->programas.resize(alternativas.size());
+    for (std::size_t i = 0; i < alternativas.size(); ++i) {
+        for (const ProgramaEmpuje::Tramo& tramo : alternativas[i].obtenerTramos()) {
+            exploracion->programas[i].agregarTramo(inicio + tramo.tiempoInicio, tramo.empuje);
+        }
+    }
+    exploracion->resultados.resize(alternativas.size());
+    exploracion->pendientes = alternativas.size();
+
+    actual = exploracion;
+    for (std::size_t i = 0; i < alternativas.size(); ++i) {
+        grupo.encolar([exploracion, i]() {
+            correrAlternativa(*exploracion, i);
+            exploracion->pendientes.fetch_sub(1, std::memory_order_acq_rel);
+        });
+    }
+}
+
+void ExploradorAlternativas::correrAlternativa(Exploracion& exploracion, std::size_t indice) {
+    // Si ya se pidió otra exploración no vale la pena empezar esta copia
+    if (exploracion.descartada.load(std::memory_order_relaxed)) return;
+
+    Juego juego;
+    juego.establecerModoSilencioso(true);
+    juego.establecerPasoFisica(exploracion.pasoFisica);
+    juego.establecerIntegrador(exploracion.integrador, exploracion.tolerancia);
+    juego.establecerAvanceBalistico(exploracion.avanceBalistico);
+    juego.restaurarEstado(exploracion.origen);
+
+    exploracion.resultados[indice] = EjecutorLotes::completarMision(
+        juego, exploracion.programas[indice], exploracion.tiempoMaximo);
+}
+
+void ExploradorAlternativas::descartar() {
+    if (actual) {
+        actual->descartada.store(true, std::memory_order_relaxed);
+        actual.reset();
+    }
+}
+
+bool ExploradorAlternativas::hayExploracion() const {
+    return actual != nullptr;
+}
+
+bool ExploradorAlternativas::estaLista() const {
+    return actual && actual->pendientes.load(std::memory_order_acquire) == 0;
+}
+
+const std::vector<ResultadoMision>& ExploradorAlternativas::obtenerResultados() const {
+    return actual->resultados;
+}
+
+double ExploradorAlternativas::obtenerTiempoOrigen() const {
+    return actual ? actual->origen.tiempoSimulacion : 0.0;
+}
+
+unsigned ExploradorAlternativas::obtenerNumeroHilos() const {
+    return grupo.obtenerNumeroHilos();
+}
@@ -0,0 +1,65 @@
+#ifndef EXPLORADORALTERNATIVAS_H
+#define EXPLORADORALTERNATIVAS_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "ejecutorlotes.h"
+#include "estadojuego.h"
+#include "grupohilos.h"
+#include "programaempuje.h"
+
+class Juego;
+
+// Muestra qué pasaría si la partida siguiera de otra forma: copia el estado
+// actual por valor y corre cada alternativa hasta el final en su propio
+// Juego, repartidas en un grupo de hilos. lanzar() no espera; quien lo llama
+// consulta estaLista() en cada frame mientras la partida sigue.
+class ExploradorAlternativas {
+private:
+    // Todo lo que necesitan las tareas; lo comparten por shared_ptr para que
+    // una exploración descartada pueda terminar sin tocar la nueva
+    struct Exploracion {
+        EstadoJuego origen;
+        double pasoFisica = 0.1;
+        TipoIntegrador integrador = TipoIntegrador::Euler;
+        double tolerancia = 1e-6;
+        bool avanceBalistico = false;
+        double tiempoMaximo = 0.0;
+        std::vector<ProgramaEmpuje> programas; // Tiempos absolutos
+        std::vector<ResultadoMision> resultados;
+        std::atomic<std::size_t> pendientes{0};
+        std::atomic<bool> descartada{false};
+    };
+
+    GrupoHilos grupo;
+    std::shared_ptr<Exploracion> actual;
+    double horizonte;
+
+    static void correrAlternativa(Exploracion& exploracion, std::size_t indice);
+
+public:
+    // numeroHilos == 0 deja un núcleo libre para la simulación en vivo.
+    // 'horizonteSegundos' acota cuánto tiempo simulado sigue cada copia.
+    explicit ExploradorAlternativas(unsigned numeroHilos = 0, double horizonteSegundos = 600.0);
+    ~ExploradorAlternativas();
+
+    ExploradorAlternativas(const ExploradorAlternativas&) = delete;
+    ExploradorAlternativas& operator=(const ExploradorAlternativas&) = delete;
+
+    // Los tiempos de cada programa son relativos al instante actual de
+    // 'juego'. Una exploración anterior sin terminar se descarta.
+    void lanzar(const Juego& juego, const std::vector<ProgramaEmpuje>& alternativas);
+    void descartar();
+
+    bool hayExploracion() const;
+    bool estaLista() const;
+    // Solo válido con estaLista(); mismo orden que las alternativas
+    const std::vector<ResultadoMision>& obtenerResultados() const;
+    double obtenerTiempoOrigen() const;
+
+    unsigned obtenerNumeroHilos() const;
+};
+
+#endif // EXPLORADORALTERNATIVAS_H
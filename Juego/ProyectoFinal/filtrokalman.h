@@ -0,0 +1,172 @@
+#ifndef FILTROKALMAN_H
+#define FILTROKALMAN_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+// Filtro de Kalman lineal con N variables de estado y M medidas. Todas las
+// matrices son arreglos de tamaño fijo, así que no reserva memoria, se copia
+// por valor y el compilador desenrolla los bucles. El modelo (F, Q, H, R)
+// lo pasa quien lo usa en cada llamada, porque suele depender del paso.
+template<std::size_t N, std::size_t M>
+class FiltroKalman {
+    static_assert(N >= 1 && M >= 1 && M <= N, "FiltroKalman necesita 1 <= M <= N");
+
+public:
+    using Vector = std::array<double, N>;
+    using Matriz = std::array<std::array<double, N>, N>;
+    using Medida = std::array<double, M>;
+    using Observacion = std::array<std::array<double, N>, M>;   // H
+    using RuidoMedida = std::array<std::array<double, M>, M>;   // R
+
+private:
+    Vector x;
+    Matriz P;
+
+public:
+    FiltroKalman() : x(), P() {}
+
+    void iniciar(const Vector& estado, const Matriz& covarianza) {
+        x = estado;
+        P = covarianza;
+    }
+
+    // x = F x + u, P = F P F' + Q
+    void predecir(const Matriz& F, const Vector& u, const Matriz& Q) {
+        Vector siguiente{};
+        Matriz FP{};
+        for (std::size_t i = 0; i < N; ++i) {
+            double suma = u[i];
+            for (std::size_t k = 0; k < N; ++k) {
+                suma += F[i][k] * x[k];
+                for (std::size_t j = 0; j < N; ++j) {
+                    FP[i][j] += F[i][k] * P[k][j];
+                }
+            }
+            siguiente[i] = suma;
+        }
+        x = siguiente;
+
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < N; ++j) {
+                double suma = Q[i][j];
+                for (std::size_t k = 0; k < N; ++k) {
+                    suma += FP[i][k] * F[j][k];
+                }
+                P[i][j] = suma;
+            }
+        }
+    }
+
+    // Fusiona la medida z = H x + ruido. Devuelve false (y no corrige) si la
+    // covarianza de la innovación no es definida positiva.
+    bool corregir(const Medida& z, const Observacion& H, const RuidoMedida& R) {
+        // P H' (N x M) y S = H P H' + R (M x M)
+        std::array<std::array<double, M>, N> PHt{};
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t m = 0; m < M; ++m) {
+                double suma = 0.0;
+                for (std::size_t k = 0; k < N; ++k) {
+                    suma += P[i][k] * H[m][k];
+                }
+                PHt[i][m] = suma;
+            }
+        }
+        RuidoMedida S = R;
+        for (std::size_t a = 0; a < M; ++a) {
+            for (std::size_t b = 0; b < M; ++b) {
+                for (std::size_t k = 0; k < N; ++k) {
+                    S[a][b] += H[a][k] * PHt[k][b];
+                }
+            }
+        }
+
+        // Cholesky de S: L L' = S
+        RuidoMedida L{};
+        for (std::size_t a = 0; a < M; ++a) {
+            for (std::size_t b = 0; b <= a; ++b) {
+                double suma = S[a][b];
+                for (std::size_t k = 0; k < b; ++k) {
+                    suma -= L[a][k] * L[b][k];
+                }
+                if (a == b) {
+                    if (!(suma > 0.0)) return false;
+                    L[a][a] = std::sqrt(suma);
+                } else {
+                    L[a][b] = suma / L[b][b];
+                }
+            }
+        }
+
+        // Innovación
+        Medida innovacion{};
+        for (std::size_t m = 0; m < M; ++m) {
+            double prevista = 0.0;
+            for (std::size_t k = 0; k < N; ++k) {
+                prevista += H[m][k] * x[k];
+            }
+            innovacion[m] = z[m] - prevista;
+        }
+
+        // Cada fila de K = P H' S^-1 resuelve S k = (fila de P H')'
+        std::array<std::array<double, M>, N> K{};
+        for (std::size_t i = 0; i < N; ++i) {
+            Medida y{};
+            for (std::size_t a = 0; a < M; ++a) {
+                double suma = PHt[i][a];
+                for (std::size_t k = 0; k < a; ++k) {
+                    suma -= L[a][k] * y[k];
+                }
+                y[a] = suma / L[a][a];
+            }
+            for (std::size_t a = M; a-- > 0;) {
+                double suma = y[a];
+                for (std::size_t k = a + 1; k < M; ++k) {
+                    suma -= L[k][a] * K[i][k];
+                }
+                K[i][a] = suma / L[a][a];
+            }
+        }
+
+        // x += K innovación, P -= K (H P) con H P = (P H')' por simetría
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t m = 0; m < M; ++m) {
+                x[i] += K[i][m] * innovacion[m];
+            }
+        }
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < N; ++j) {
+                double suma = 0.0;
+                for (std::size_t m = 0; m < M; ++m) {
+                    suma += K[i][m] * PHt[j][m];
+                }
+                P[i][j] -= suma;
+            }
+        }
+        // Los redondeos no deben romper la simetría
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = i + 1; j < N; ++j) {
+                const double media = 0.5 * (P[i][j] + P[j][i]);
+                P[i][j] = media;
+                P[j][i] = media;
+            }
+        }
+        return true;
+    }
+
+    const Vector& obtenerEstado() const {
+        return x;
+    }
+
+    // Para imponer límites físicos después de corregir
+    void establecerComponente(std::size_t i, double valor) {
+        x[i] = valor;
+    }
+
+    const Matriz& obtenerCovarianza() const {
+        return P;
+    }
+};
+
+#endif // FILTROKALMAN_H
@@ -0,0 +1,45 @@
+#ifndef GENERADORSPLITMIX_H
+#define GENERADORSPLITMIX_H
+
+#include <cmath>
+#include <cstdint>
+
+// SplitMix64: estado de 64 bits, sin reservas y con la misma secuencia en
+// cualquier plataforma (las distribuciones de <random> no lo garantizan).
+// Derivar un generador por (semilla, índice) da secuencias independientes
+// que no dependen de qué hilo procesa cada índice.
+class GeneradorSplitMix {
+private:
+    std::uint64_t estado;
+
+public:
+    explicit GeneradorSplitMix(std::uint64_t semilla, std::uint64_t indice = 0)
+        : estado(semilla ^ (indice * 0xD1B54A32D192ED03ull)) {
+        siguiente(); // Separa semillas consecutivas
+    }
+
+    std::uint64_t siguiente() {
+        std::uint64_t z = (estado += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniforme en (0, 1)
+    double uniforme() {
+        return (static_cast<double>(siguiente() >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+    }
+
+    // Entero uniforme en [0, n)
+    std::uint64_t entero(std::uint64_t n) {
+        return static_cast<std::uint64_t>(uniforme() * static_cast<double>(n)) % n;
+    }
+
+    // Normal estándar por Box-Muller
+    double normal() {
+        const double PI = 3.14159265358979323846;
+        return std::sqrt(-2.0 * std::log(uniforme())) * std::cos(2.0 * PI * uniforme());
+    }
+};
+
+#endif // GENERADORSPLITMIX_H
@@ -0,0 +1,109 @@
+#include "grupohilos.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+GrupoHilos::GrupoHilos(unsigned numeroHilos)
+    : detener(false) {
+    hilos.reserve(numeroHilos);
+    for (unsigned i = 0; i < numeroHilos; ++i) {
+        hilos.emplace_back(&GrupoHilos::bucleTrabajador, this);
+    }
+}
+
+GrupoHilos::~GrupoHilos() {
+    {
+        std::lock_guard<std::mutex> lock(mutexTareas);
+        detener = true;
+    }
+    hayTareas.notify_all();
+
+    for (std::thread& hilo : hilos) {
+        if (hilo.joinable()) {
+            hilo.join();
+        }
+    }
+}
+
+unsigned GrupoHilos::obtenerNumeroHilos() const {
+    return static_cast<unsigned>(hilos.size());
+}
+
+unsigned GrupoHilos::hilosDisponibles() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n > 0 ? n : 1;
+}
+
+void GrupoHilos::encolar(std::function<void()> tarea) {
+    {
+        std::lock_guard<std::mutex> lock(mutexTareas);
+        tareas.push_back(std::move(tarea));
+    }
+    hayTareas.notify_one();
+}
+
+void GrupoHilos::bucleTrabajador() {
+    for (;;) {
+        std::function<void()> tarea;
+        {
+            std::unique_lock<std::mutex> lock(mutexTareas);
+            hayTareas.wait(lock, [this] { return detener || !tareas.empty(); });
+
+            if (detener && tareas.empty()) {
+                return;
+            }
+
+            tarea = std::move(tareas.front());
+            tareas.pop_front();
+        }
+        tarea();
+    }
+}
+
+void GrupoHilos::paraCada(std::size_t cantidad,
+                          const std::function<void(std::size_t)>& funcion) {
+    if (cantidad == 0) return;
+
+    // Los índices se reparten en bloques pequeños con un contador atómico,
+    // así un hilo que termina antes toma trabajo de los demás.
+    const std::size_t trabajadores = hilos.size() + 1;
+    const std::size_t bloque = std::max<std::size_t>(1, cantidad / (trabajadores * 16));
+
+    struct Estado {
+        std::atomic<std::size_t> siguiente{0};
+        std::atomic<std::size_t> pendientes{0};
+        std::mutex mutexFin;
+        std::condition_variable fin;
+    };
+    auto estado = std::make_shared<Estado>();
+
+    auto trabajar = [estado, cantidad, bloque, &funcion]() {
+        for (;;) {
+            std::size_t inicio = estado->siguiente.fetch_add(bloque);
+            if (inicio >= cantidad) break;
+
+            std::size_t final = std::min(cantidad, inicio + bloque);
+            for (std::size_t i = inicio; i < final; ++i) {
+                funcion(i);
+            }
+        }
+    };
+
+    const std::size_t ayudantes = std::min(hilos.size(), (cantidad + bloque - 1) / bloque);
+    estado->pendientes = ayudantes;
+
+    for (std::size_t h = 0; h < ayudantes; ++h) {
+        encolar([estado, trabajar]() {
+            trabajar();
+            if (estado->pendientes.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(estado->mutexFin);
+                estado->fin.notify_all();
+            }
+        });
+    }
+
+    trabajar();
+
+    std::unique_lock<std::mutex> lock(estado->mutexFin);
+    estado->fin.wait(lock, [&estado] { return estado->pendientes.load() == 0; });
+}
@@ -0,0 +1,43 @@
+#ifndef GRUPOHILOS_H
+#define GRUPOHILOS_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Grupo de hilos persistente. No depende de Qt para poder usarse tanto en la
+// interfaz como en las herramientas de línea de comandos.
+class GrupoHilos {
+private:
+    std::vector<std::thread> hilos;
+    std::deque<std::function<void()>> tareas;
+    std::mutex mutexTareas;
+    std::condition_variable hayTareas;
+    bool detener;
+
+    void bucleTrabajador();
+
+public:
+    // Con numeroHilos == 0 todo el trabajo de paraCada() lo hace quien llama
+    explicit GrupoHilos(unsigned numeroHilos = hilosDisponibles());
+    ~GrupoHilos();
+
+    GrupoHilos(const GrupoHilos&) = delete;
+    GrupoHilos& operator=(const GrupoHilos&) = delete;
+
+    unsigned obtenerNumeroHilos() const;
+
+    void encolar(std::function<void()> tarea);
+
+    // Ejecuta funcion(i) para i en [0, cantidad) repartiendo índices entre
+    // todos los hilos (incluido el que llama) y espera a que terminen.
+    void paraCada(std::size_t cantidad, const std::function<void(std::size_t)>& funcion);
+
+    static unsigned hilosDisponibles();
+};
+
+#endif // GRUPOHILOS_H
@@ -1,19 +1,37 @@
-#include "Juego.h"
+#include "juego.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <type_traits>
 
 Juego::Juego()
-    : nivelNumero(0),
+    : siguienteInformeHAL(0),
+    nivelNumero(0),
+    pasoActual(0),
     tiempoSimulacion(0.0),
     tiempoControl(0.0),
     deltaTime(0.1),
+    acumuladorTiempo(0.0),
     tiempoMaximo(600.0),
+    tiempoFinal(0.0),
+    integradorFisica(TipoIntegrador::Euler),
+    toleranciaIntegrador(1e-6),
     enEjecucion(false),
     pausado(false),
     victoria(false),
-    derrota(false) {
+    derrota(false),
+    silencioso(false),
+    avanceBalistico(false),
+    reproduciendo(false),
+    halAsincrono(false),
+    factorTiempo(1.0),
+    factorTiempoEfectivo(1.0),
+    presupuestoTiempoReal(0.008),
+    aceleracionInterrumpida(false) {
 
     cohete = std::make_unique<Cohete>();
     agenteHAL = std::make_unique<AgenteHAL69>();
@@ -32,7 +50,9 @@ void Juego::iniciarNivel(int numeroNivel) {
     enEjecucion = false;
     pausado = false;
 
-    imprimirInformacionNivel();
+    if (!silencioso) {
+        imprimirInformacionNivel();
+    }
 }
 
 void Juego::iniciarNivelDesdeVictoria(int numeroNivel) {
@@ -55,9 +75,11 @@ void Juego::iniciarNivelDesdeVictoria(int numeroNivel) {
         cohete->establecerCombustible(combustibleActual);
         cohete->establecerAltura(0.0); // Reiniciar altura
 
-        std::cout << "\n=== Transición Nivel 1 -> Nivel 2 ===\n";
-        std::cout << "Velocidad heredada: " << velocidadActual << " m/s\n";
-        std::cout << "Combustible heredado: " << combustibleActual << " kg\n\n";
+        if (!silencioso) {
+            std::cout << "\n=== Transición Nivel 1 -> Nivel 2 ===\n";
+            std::cout << "Velocidad heredada: " << velocidadActual << " m/s\n";
+            std::cout << "Combustible heredado: " << combustibleActual << " kg\n\n";
+        }
 
     } else if (numeroNivel == 3) {
         // Del nivel 2 al 3: heredar solo combustible, velocidad en 0
@@ -67,38 +89,43 @@ void Juego::iniciarNivelDesdeVictoria(int numeroNivel) {
         cohete->establecerPosicionX(0.0);  // Iniciar en el centro
         cohete->establecerVelocidadX(0.0);
 
-        std::cout << "\n=== Transición Nivel 2 -> Nivel 3 ===\n";
-        std::cout << "Velocidad inicial: 0.0 m/s (descenso)\n";
-        std::cout << "Combustible heredado: " << combustibleActual << " kg\n";
-        std::cout << "Altura inicial: 15000 m\n\n";
+        if (!silencioso) {
+            std::cout << "\n=== Transición Nivel 2 -> Nivel 3 ===\n";
+            std::cout << "Velocidad inicial: 0.0 m/s (descenso)\n";
+            std::cout << "Combustible heredado: " << combustibleActual << " kg\n";
+            std::cout << "Altura inicial: 15000 m\n\n";
+        }
     }
 
     // NO establecer enEjecucion aquí - solo se establece cuando se inicia la simulación
     enEjecucion = false;
     pausado = false;
 
-    imprimirInformacionNivel();
+    if (!silencioso) {
+        imprimirInformacionNivel();
+    }
 }
 
 void Juego::inicializarNivel(int numeroNivel) {
     switch (numeroNivel) {
     case 1:
-        nivelActual = std::make_unique<Nivel1_Sputnik>();
+        nivelActual.emplace<Nivel1_Sputnik>();
         tiempoMaximo = 600.0;
         break;
     case 2:
-        nivelActual = std::make_unique<Nivel2_Vostok>();
+        nivelActual.emplace<Nivel2_Vostok>();
         tiempoMaximo = 2000.0;
         break;
     case 3:
-        nivelActual = std::make_unique<Nivel3_Apolo11>();
+        nivelActual.emplace<Nivel3_Apolo11>().iniciarDescenso();
         tiempoMaximo = 2000.0;
-        dynamic_cast<Nivel3_Apolo11*>(nivelActual.get())->iniciarDescenso();
         break;
     default:
-        nivelActual = std::make_unique<Nivel1_Sputnik>();
+        nivelActual.emplace<Nivel1_Sputnik>();
         break;
     }
+
+    obtenerNivelBase()->establecerIntegrador(integradorFisica, toleranciaIntegrador);
 }
 
 void Juego::configurarCoheteParaNivel(int nivel) {
@@ -135,32 +162,218 @@ void Juego::configurarCoheteParaNivel(int nivel) {
 
 
 void Juego::actualizar() {
-    if (!enEjecucion || pausado || victoria || derrota) {
-        return;
+    ejecutarPasos(1, tiempoMaximo);
+}
+
+int Juego::avanzar(int pasos) {
+    return ejecutarPasos(pasos, tiempoMaximo);
+}
+
+int Juego::avanzarHasta(double tiempoLimite) {
+    return ejecutarPasos(std::numeric_limits<int>::max(), tiempoLimite);
+}
+
+// Un único std::visit por llamada; dentro del bucle el tipo del nivel es
+// conocido y aplicarFisica/verificarVictoria no pasan por la vtable.
+int Juego::ejecutarPasos(int maxPasos, double tiempoLimite) {
+    return std::visit([&](auto& nivel) -> int {
+        if constexpr (std::is_same_v<std::decay_t<decltype(nivel)>, std::monostate>) {
+            return 0;
+        } else {
+            return ejecutarPasos(nivel, maxPasos, tiempoLimite);
+        }
+    }, nivelActual);
+}
+
+template<class NivelT>
+int Juego::ejecutarPasos(NivelT& nivel, int maxPasos, double tiempoLimite) {
+    int pasos = 0;
+
+    while (pasos < maxPasos) {
+        if (!enEjecucion || pausado || victoria || derrota) {
+            break;
+        }
+
+        if (tiempoSimulacion >= tiempoMaximo) {
+            derrota = true;
+            tiempoFinal = tiempoSimulacion;
+            break;
+        }
+
+        if (tiempoSimulacion >= tiempoLimite) {
+            break;
+        }
+
+        if (avanceBalistico) {
+            const int saltados = planear(nivel, maxPasos - pasos, tiempoLimite);
+            if (saltados > 0) {
+                pasos += saltados;
+                if (rebobinador) registrarPasoRebobinado();
+                continue;
+            }
+        }
+
+        coheteAnterior = *cohete;
+
+        // El consumo de combustible y el contacto con el suelo se manejan
+        // dentro de aplicarFisica de cada nivel
+        nivel.aplicarFisica(cohete.get(), deltaTime);
+        const std::vector<EventoFisica>& eventos = nivel.obtenerEventosPaso();
+        if (!eventos.empty()) {
+            registrarEventos(eventos);
+        }
+
+        const double inicioPaso = tiempoSimulacion;
+        tiempoSimulacion += deltaTime;
+        tiempoControl += deltaTime;
+        ++pasos;
+        ++pasoActual;
+
+        if (!silencioso) {
+            observarTelemetria(nivel);
+        }
+        if (sensores) {
+            observarSensores(nivel, deltaTime);
+        }
+
+        manejarEventosPeriodicos();
+
+        verificarEstado(nivel);
+
+        if (victoria || derrota) {
+            tiempoFinal = inicioPaso + calcularTiempoFinal(eventos);
+        }
+
+        if (rebobinador) registrarPasoRebobinado();
     }
 
-    if (tiempoSimulacion >= tiempoMaximo) {
-        derrota = true;
-        return;
+    return pasos;
+}
+
+template<class NivelT>
+void Juego::observarTelemetria(const NivelT& nivel) {
+    // El empuje y la masa que usó el nivel son los del inicio del paso
+    const double empuje = coheteAnterior.tieneCombustible() ? coheteAnterior.obtenerEmpuje() : 0.0;
+
+    LecturaTelemetria lectura;
+    lectura.tiempo = tiempoSimulacion;
+    lectura.paso = deltaTime;
+    lectura.aceleracion = cohete->obtenerAceleracion();
+    lectura.propulsion = empuje / coheteAnterior.obtenerMasa() -
+                         nivel.obtenerGravedadEn(coheteAnterior.obtenerAltura());
+    lectura.consumo = (coheteAnterior.obtenerCombustible() - cohete->obtenerCombustible()) / deltaTime;
+    lectura.consumoEsperado = empuje / nivel.obtenerFactorConsumo();
+    lectura.combustible = cohete->obtenerCombustible();
+    lectura.enAtmosfera = cohete->estaEnAtmosfera();
+    lectura.continuo = !(empuje > 0.0 && !cohete->tieneCombustible());
+    telemetria.observar(lectura);
+}
+
+template<class NivelT>
+void Juego::observarSensores(const NivelT& nivel, double duracion) {
+    // Lo que sabe la computadora de a bordo: el empuje pedido y el consumo
+    // que implica, no el arrastre ni el combustible real
+    const double empuje = coheteAnterior.tieneCombustible() ? coheteAnterior.obtenerEmpuje() : 0.0;
+    const double altura = sensores->estaCalibrado() ? sensores->obtenerEstimacion().altura
+                                                    : cohete->obtenerAltura();
+    sensores->observar(*cohete, tiempoSimulacion, duracion, empuje,
+                       empuje / nivel.obtenerFactorConsumo(), nivel.obtenerGravedadEn(altura));
+}
+
+int Juego::avanzarTiempoReal(double segundosReales) {
+    if (!enEjecucion || pausado || victoria || derrota) {
+        acumuladorTiempo = 0.0;
+        return 0;
     }
 
-    aplicarFisicaNivel();
+    // Si la aplicación estuvo bloqueada se descarta el exceso en lugar
+    // de intentar recuperarlo todo de golpe.
+    const double real = std::clamp(segundosReales, 0.0, RETRASO_MAXIMO);
+    acumuladorTiempo += real * factorTiempo;
+
+    const auto inicio = std::chrono::steady_clock::now();
+    const double tiempoInicial = tiempoSimulacion;
+
+    int pasos = 0;
+    while (acumuladorTiempo >= deltaTime) {
+        int bloque = 1;
+
+        if (factorTiempo > 1.0) {
+            // Cerca de un evento se vuelve a 1x y se descarta el tiempo
+            // acelerado pendiente
+            const double margen = estimarTiempoHastaEvento() - HORIZONTE_EVENTO;
+            if (margen <= 0.0) {
+                factorTiempo = 1.0;
+                aceleracionInterrumpida = true;
+                acumuladorTiempo = std::min(acumuladorTiempo, real);
+                continue;
+            }
 
-    tiempoSimulacion += deltaTime;
-    tiempoControl += deltaTime;
+            // Bloques cortos: ni pasar de largo el horizonte ni el presupuesto
+            const double pasosHastaHorizonte = std::floor(margen / deltaTime);
+            bloque = static_cast<int>(std::min({acumuladorTiempo / deltaTime,
+                                                static_cast<double>(BLOQUE_ACELERADO),
+                                                std::max(1.0, pasosHastaHorizonte)}));
+        }
 
-    manejarEventosPeriodicos();
+        const int hechos = avanzar(bloque);
+        acumuladorTiempo -= bloque * deltaTime;
+        pasos += hechos;
+
+        if (!enEjecucion || victoria || derrota) {
+            acumuladorTiempo = 0.0;
+            break;
+        }
+
+        // Sin CPU para tanta aceleración: se pierde el resto en lugar de
+        // arrastrar el atraso a la próxima llamada
+        if (factorTiempo > 1.0 &&
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count()
+                > presupuestoTiempoReal) {
+            acumuladorTiempo = std::fmod(acumuladorTiempo, deltaTime);
+            break;
+        }
+    }
+
+    if (real > 0.0) {
+        factorTiempoEfectivo = (tiempoSimulacion - tiempoInicial) / real;
+    }
 
-    verificarEstado();
+    return pasos;
 }
 
-void Juego::aplicarFisicaNivel() {
-    if (!nivelActual || !cohete) return;
+double Juego::estimarTiempoHastaEvento() const {
+    const Nivel* nivel = obtenerNivelBase();
+    if (!nivel) return std::numeric_limits<double>::infinity();
 
-    nivelActual->aplicarFisica(cohete.get(), deltaTime);
-    // El consumo de combustible se maneja dentro de aplicarFisica de cada nivel
-    // consumirCombustiblePorEmpuje(); // Comentado porque cada nivel maneja su propio consumo
-    manejarColisionSuelo();
+    const double h = cohete->obtenerAltura();
+    const double v = cohete->obtenerVelocidad();
+    const double objetivo = nivel->obtenerAlturaObjetivo();
+    double t = std::numeric_limits<double>::infinity();
+
+    // Altura objetivo subiendo y suelo bajando, a velocidad constante
+    if (v > 0.0 && h < objetivo) {
+        t = std::min(t, (objetivo - h) / v);
+    }
+    if (v < 0.0 && h > 0.0) {
+        t = std::min(t, h / -v);
+    }
+
+    // Límite de velocidad con la aceleración del último paso
+    const double aceleracion = (v - coheteAnterior.obtenerVelocidad()) / deltaTime;
+    const double limite = nivel->obtenerVelocidadMaxima();
+    if (aceleracion > 0.0 && v < limite) {
+        t = std::min(t, (limite - v) / aceleracion);
+    }
+
+    // Combustible bajo con el consumo del último paso
+    const double consumo = (coheteAnterior.obtenerCombustible() - cohete->obtenerCombustible()) / deltaTime;
+    if (consumo > 0.0) {
+        const double reserva = cohete->obtenerCombustibleMaximo() * AVISO_COMBUSTIBLE / 100.0;
+        t = std::min(t, std::max(0.0, cohete->obtenerCombustible() - reserva) / consumo);
+    }
+
+    return t;
 }
 
 void Juego::consumirCombustiblePorEmpuje() {
@@ -181,38 +394,83 @@ void Juego::consumirCombustiblePorEmpuje() {
     }
 }
 
-void Juego::manejarColisionSuelo() {
-    if (cohete->obtenerAltura() <= 0.0) {
-        double velocidadImpacto = cohete->obtenerVelocidad();
+template<class NivelT>
+int Juego::planear(NivelT& nivel, int maxPasos, double tiempoLimite) {
+    const double duracionPlaneo = nivel.calcularPlaneo(cohete.get());
+    if (!(duracionPlaneo > 0.0)) return 0;
+
+    // Pasos completos antes del que contiene el umbral: ese paso se integra
+    // normalmente y detectarEventos ubica el cruce exacto
+    double pasosLibres = std::ceil(duracionPlaneo / deltaTime) - 1.0;
+    pasosLibres = std::min(pasosLibres, std::ceil((tiempoLimite - tiempoSimulacion) / deltaTime));
+    pasosLibres = std::min(pasosLibres, std::ceil((tiempoMaximo - tiempoSimulacion) / deltaTime));
+    pasosLibres = std::min(pasosLibres, static_cast<double>(maxPasos));
+    if (!silencioso) {
+        pasosLibres = std::min(pasosLibres,
+                               std::ceil((INTERVALO_CONTROL - tiempoControl) / deltaTime) - 1.0);
+    }
 
-        if (nivelNumero == 3) {
-            // Usar el rango definido en Nivel3_Apolo11
-            auto* apolo = dynamic_cast<Nivel3_Apolo11*>(nivelActual.get());
-            double vImpactoAbs = std::abs(velocidadImpacto);
+    // Un salto de un solo paso no ahorra nada
+    if (pasosLibres < 2.0) return 0;
+    const int pasos = static_cast<int>(pasosLibres);
+    const double duracion = pasos * deltaTime;
+
+    // coheteAnterior queda un paso antes del final, como tras un paso normal
+    nivel.aplicarPlaneo(cohete.get(), duracion - deltaTime);
+    coheteAnterior = *cohete;
+    nivel.aplicarPlaneo(cohete.get(), deltaTime);
+
+    tiempoSimulacion += duracion;
+    tiempoControl += duracion;
+    pasoActual += pasos;
+    if (sensores) {
+        observarSensores(nivel, duracion);
+    }
 
-            if (apolo) {
-                double vMin = apolo->obtenerVelocidadAterrizajeMin();
-                double vMax = apolo->obtenerVelocidadAterrizajeMax();
+    verificarEstado(nivel);
+    if (victoria || derrota) {
+        tiempoFinal = tiempoSimulacion;
+    }
 
-                if (vImpactoAbs < vMin || vImpactoAbs > vMax) {
-                    cohete->marcarDanado();
-                }
-            } else {
-                if (vImpactoAbs > 5.0) {
-                    cohete->marcarDanado();
-                }
-            }
+    return pasos;
+}
 
-            cohete->establecerAltura(0.0);
-            cohete->establecerVelocidad(0.0);
+void Juego::registrarEventos(const std::vector<EventoFisica>& eventos) {
+    for (const EventoFisica& evento : eventos) {
+        const double tiempo = tiempoSimulacion + evento.instante;
+        registroEventos.push_back({tiempo, evento.tipo, evento.estado});
+
+        if (!silencioso && !reproduciendo) {
+            std::cout << std::fixed << std::setprecision(3)
+                      << "t=" << tiempo << " s | " << obtenerNombreEvento(evento.tipo)
+                      << " | h=" << evento.estado.altura << " m"
+                      << " | v=" << evento.estado.velocidad << " m/s"
+                      << " | fuel=" << evento.estado.combustible << " kg\n";
         }
     }
 }
 
-void Juego::verificarEstado() {
-    if (!nivelActual || !cohete) return;
+// Segundos desde el inicio del último paso hasta el evento que terminó la
+// partida: en una victoria el cruce del objetivo o el alunizaje, en una
+// derrota el primer evento del paso. Sin eventos, el final del paso.
+double Juego::calcularTiempoFinal(const std::vector<EventoFisica>& eventos) const {
+    if (eventos.empty()) return deltaTime;
+
+    if (victoria) {
+        for (const EventoFisica& evento : eventos) {
+            if (evento.tipo == TipoEvento::AlturaObjetivo || evento.tipo == TipoEvento::Contacto) {
+                return evento.instante;
+            }
+        }
+        return deltaTime;
+    }
+
+    return eventos.front().instante;
+}
 
-    if (nivelActual->verificarVictoria(cohete.get())) {
+template<class NivelT>
+void Juego::verificarEstado(NivelT& nivel) {
+    if (nivel.verificarVictoria(cohete.get())) {
         victoria = true;
         enEjecucion = false;
         return;
@@ -224,32 +482,68 @@ void Juego::verificarEstado() {
         return;
     }
 
-    // Para nivel 2: verificar si se quedó sin combustible antes de llegar
-    if (nivelNumero == 2) {
-        if (!cohete->tieneCombustible() &&
-            cohete->obtenerAltura() < nivelActual->obtenerAlturaObjetivo()) {
-            derrota = true;
-            enEjecucion = false;
-            return;
-        }
-    } else {
-        // Para otros niveles
-        if (!cohete->tieneCombustible() &&
-            cohete->obtenerAltura() < nivelActual->obtenerAlturaObjetivo()) {
-            derrota = true;
-            enEjecucion = false;
-            return;
-        }
+    // Sin combustible antes de llegar al objetivo
+    if (!cohete->tieneCombustible() &&
+        cohete->obtenerAltura() < nivel.obtenerAlturaObjetivo()) {
+        derrota = true;
+        enEjecucion = false;
     }
 }
 
+Nivel* Juego::obtenerNivelBase() {
+    return std::visit([](auto& nivel) -> Nivel* {
+        if constexpr (std::is_same_v<std::decay_t<decltype(nivel)>, std::monostate>) {
+            return nullptr;
+        } else {
+            return &nivel;
+        }
+    }, nivelActual);
+}
+
+const Nivel* Juego::obtenerNivelBase() const {
+    return const_cast<Juego*>(this)->obtenerNivelBase();
+}
+
 void Juego::manejarEventosPeriodicos() {
+    if (silencioso) return;
+
     if (agenteHAL && tiempoControl >= INTERVALO_CONTROL) {
-        agenteHAL->analizarEstado(nivelNumero, *nivelActual, *cohete, tiempoSimulacion);
+        // Al rebobinar el análisis ya se mostró; solo se repite el reloj
+        if (!reproduciendo && halAsincrono) {
+            muestrasHAL.agregar({nivelNumero, tiempoSimulacion, obtenerCohetePercibido(),
+                                 telemetria.obtenerResumen()});
+        } else if (!reproduciendo) {
+            agenteHAL->analizarEstado(nivelNumero, *obtenerNivelBase(), obtenerCohetePercibido(),
+                                      telemetria.obtenerResumen(), tiempoSimulacion);
+            imprimirInformesHAL();
+        }
         tiempoControl = 0.0;
     }
 }
 
+void Juego::imprimirInformesHAL() {
+    const HistorialAvisos& avisos = agenteHAL->obtenerAvisos();
+
+    std::uint64_t i = std::max(siguienteInformeHAL, avisos.obtenerPrimero());
+    for (; i < avisos.obtenerTotal(); ++i) {
+        const AvisoHAL& aviso = avisos.obtener(i);
+        if (canalDe(aviso.codigo) == CanalAviso::Consola) {
+            imprimirAvisoHAL(aviso);
+        }
+    }
+    siguienteInformeHAL = i;
+}
+
+void Juego::imprimirAvisoHAL(const AvisoHAL& aviso) const {
+    const Nivel* nivel = obtenerNivelBase();
+    if (!nivel) return;
+
+    char texto[256];
+    formatearAviso(aviso, texto, sizeof(texto));
+    std::cout << "HAL-69 [" << nivel->obtenerNombre() << " | t=" << aviso.tiempo << " s]: "
+              << texto << std::endl;
+}
+
 void Juego::imprimirEstadoConsola() const {
     if (!cohete) return;
 
@@ -264,12 +558,13 @@ void Juego::imprimirEstadoConsola() const {
 }
 
 void Juego::imprimirInformacionNivel() const {
-    if (!nivelActual) return;
+    const Nivel* nivel = obtenerNivelBase();
+    if (!nivel) return;
 
     std::cout << "\n=== Nivel " << nivelNumero << ": "
-              << nivelActual->obtenerNombre() << " ===\n";
-    std::cout << nivelActual->obtenerDescripcion() << "\n";
-    std::cout << "Objetivo: " << nivelActual->obtenerObjetivo() << "\n\n";
+              << nivel->obtenerNombre() << " ===\n";
+    std::cout << nivel->obtenerDescripcion() << "\n";
+    std::cout << "Objetivo: " << nivel->obtenerObjetivo() << "\n\n";
 
     if (nivelNumero == 1) {
         std::cout << "Configuracion del cohete:\n";
@@ -323,7 +618,7 @@ std::string Juego::obtenerRazonDerrota() const {
             }
         } else if (nivelNumero == 3 && cohete->obtenerAltura() <= 0.0) {
             // Verificar si no aterrizó en la zona correcta
-            auto* apolo = dynamic_cast<Nivel3_Apolo11*>(nivelActual.get());
+            auto* apolo = std::get_if<Nivel3_Apolo11>(&nivelActual);
             if (apolo && !apolo->verificarAterrizajeEnZona(cohete.get())) {
                 return "Perdiste la mision: El cohete no aterrizo en la zona de aterrizaje correcta";
             } else {
@@ -351,6 +646,7 @@ std::string Juego::obtenerRazonDerrota() const {
 void Juego::ajustarEmpuje(double nuevoEmpuje) {
     if (cohete) {
         cohete->ajustarEmpuje(nuevoEmpuje);
+        registrarEntrada(TipoEntrada::Empuje, nuevoEmpuje);
     }
 }
 
@@ -358,6 +654,173 @@ void Juego::moverCoheteHorizontal(double deltaX) {
     if (cohete && nivelNumero == 3 && enEjecucion && !pausado) {
         // Ajustar velocidad horizontal en nivel 3
         cohete->ajustarVelocidadX(deltaX);
+        registrarEntrada(TipoEntrada::VelocidadHorizontal, deltaX);
+    }
+}
+
+void Juego::registrarEntrada(TipoEntrada tipo, double valor) {
+    if (rebobinador && enEjecucion && !reproduciendo) {
+        rebobinador->registrarEntrada({pasoActual, tipo, valor});
+    }
+}
+
+void Juego::aplicarEntrada(const EntradaControl& entrada) {
+    switch (entrada.tipo) {
+    case TipoEntrada::Empuje:
+        cohete->ajustarEmpuje(entrada.valor);
+        break;
+    case TipoEntrada::VelocidadHorizontal:
+        cohete->ajustarVelocidadX(entrada.valor);
+        break;
+    }
+}
+
+void Juego::registrarPasoRebobinado() {
+    if (!reproduciendo && rebobinador->registrarPaso(pasoActual)) {
+        rebobinador->guardarPunto(capturarEstado());
+    }
+}
+
+EstadoJuego Juego::capturarEstado() const {
+    EstadoJuego estado;
+    estado.nivel = nivelNumero;
+    estado.paso = pasoActual;
+    estado.cohete = *cohete;
+    estado.coheteAnterior = coheteAnterior;
+    if (const Nivel* nivel = obtenerNivelBase()) {
+        estado.estadoNivel = nivel->capturarEstado();
+    }
+    estado.estadoHAL = agenteHAL->capturarEstado();
+    estado.telemetria = telemetria;
+    estado.tiempoSimulacion = tiempoSimulacion;
+    estado.tiempoControl = tiempoControl;
+    estado.tiempoFinal = tiempoFinal;
+    estado.eventosRegistrados = registroEventos.size();
+    estado.enEjecucion = enEjecucion;
+    estado.victoria = victoria;
+    estado.derrota = derrota;
+    return estado;
+}
+
+void Juego::restaurarEstado(const EstadoJuego& estado) {
+    if (estado.nivel <= 0) return;
+
+    if (estado.nivel != nivelNumero || !obtenerNivelBase()) {
+        nivelNumero = estado.nivel;
+        inicializarNivel(estado.nivel);
+    }
+
+    pasoActual = estado.paso;
+    *cohete = estado.cohete;
+    coheteAnterior = estado.coheteAnterior;
+    obtenerNivelBase()->restaurarEstado(estado.estadoNivel);
+    agenteHAL->restaurarEstado(estado.estadoHAL);
+    telemetria = estado.telemetria;
+    tiempoSimulacion = estado.tiempoSimulacion;
+    tiempoControl = estado.tiempoControl;
+    tiempoFinal = estado.tiempoFinal;
+    if (registroEventos.size() > estado.eventosRegistrados) {
+        registroEventos.resize(estado.eventosRegistrados);
+    }
+    enEjecucion = estado.enEjecucion;
+    victoria = estado.victoria;
+    derrota = estado.derrota;
+    pausado = false;
+    acumuladorTiempo = 0.0;
+    // Las lecturas en camino no se guardan: el filtro vuelve a calibrarse
+    // con una lectura, y las siguientes repiten el ruido del tramo original
+    if (sensores) {
+        sensores->reiniciar();
+    }
+}
+
+bool Juego::rebobinarA(long paso) {
+    if (!rebobinador || rebobinador->obtenerPasoMinimo() < 0) return false;
+
+    paso = std::clamp(paso, rebobinador->obtenerPasoMinimo(), rebobinador->obtenerPasoMaximo());
+    const EstadoJuego* punto = rebobinador->buscarPunto(paso);
+    if (!punto) return false;
+
+    restaurarEstado(*punto);
+
+    // Rehacer los pasos que faltan con las entradas registradas, en bloques
+    // entre una entrada y la siguiente
+    reproduciendo = true;
+    const EntradaControl* entrada = rebobinador->primeraEntrada(pasoActual);
+    const EntradaControl* fin = rebobinador->finEntradas();
+    while (pasoActual < paso && enEjecucion && !victoria && !derrota) {
+        while (entrada != fin && entrada->paso == pasoActual) {
+            aplicarEntrada(*entrada);
+            ++entrada;
+        }
+
+        const long hasta = (entrada != fin) ? std::min(entrada->paso, paso) : paso;
+        if (avanzar(static_cast<int>(hasta - pasoActual)) == 0) {
+            break;
+        }
+    }
+    reproduciendo = false;
+
+    pausado = enEjecucion;
+    return true;
+}
+
+void Juego::establecerHALAsincrono(bool activar) {
+    halAsincrono = activar;
+}
+
+void Juego::establecerModoSilencioso(bool activar) {
+    silencioso = activar;
+}
+
+void Juego::establecerAvanceBalistico(bool activar) {
+    avanceBalistico = activar;
+}
+
+void Juego::establecerRebobinado(bool activar, std::size_t presupuestoBytes) {
+    if (!activar) {
+        rebobinador.reset();
+        return;
+    }
+
+    rebobinador = std::make_unique<Rebobinador>(presupuestoBytes);
+    if (enEjecucion) {
+        rebobinador->reiniciar(capturarEstado());
+    }
+}
+
+void Juego::establecerSensores(bool activar, const ConfiguracionSensores& configuracion) {
+    if (!activar) {
+        sensores.reset();
+        return;
+    }
+
+    sensores = std::make_unique<SensoresCohete>(configuracion);
+}
+
+void Juego::establecerFactorTiempo(double factor) {
+    factorTiempo = std::clamp(factor, 1.0, FACTOR_TIEMPO_MAXIMO);
+    factorTiempoEfectivo = factorTiempo;
+    aceleracionInterrumpida = false;
+}
+
+void Juego::establecerPresupuestoTiempoReal(double segundos) {
+    if (segundos > 0.0) {
+        presupuestoTiempoReal = segundos;
+    }
+}
+
+void Juego::establecerPasoFisica(double paso) {
+    if (paso > 0.0) {
+        deltaTime = paso;
+    }
+}
+
+void Juego::establecerIntegrador(TipoIntegrador tipo, double tolerancia) {
+    integradorFisica = tipo;
+    toleranciaIntegrador = tolerancia;
+    if (Nivel* nivel = obtenerNivelBase()) {
+        nivel->establecerIntegrador(tipo, tolerancia);
     }
 }
 
@@ -365,6 +828,12 @@ void Juego::iniciarSimulacion() {
     if (nivelNumero > 0 && !victoria && !derrota) {
         enEjecucion = true;
         pausado = false;
+        acumuladorTiempo = 0.0;
+        coheteAnterior = *cohete;
+
+        if (rebobinador) {
+            rebobinador->reiniciar(capturarEstado());
+        }
     }
 }
 
@@ -374,14 +843,34 @@ void Juego::establecerVelocidadInicial(double velocidad) {
     }
 }
 
+void Juego::establecerVelocidadDescenso(double velocidad) {
+    if (auto* apolo = std::get_if<Nivel3_Apolo11>(&nivelActual)) {
+        apolo->establecerVelocidadDescensoInicial(velocidad);
+    }
+}
+
 void Juego::establecerAlturaInicial(double altura) {
     if (cohete) {
         cohete->establecerAltura(altura);
     }
 }
 
+void Juego::establecerCombustibleInicial(double combustible) {
+    if (cohete) {
+        cohete->establecerCombustible(combustible);
+    }
+}
+
+void Juego::establecerResistenciaAire(double resistencia) {
+    if (Nivel* nivel = obtenerNivelBase()) {
+        nivel->establecerResistenciaAire(resistencia);
+    }
+}
+
 bool Juego::verificarVictoriaNivel() const {
-    return nivelActual && cohete && nivelActual->verificarVictoria(cohete.get());
+    // verificarVictoria no es const en la interfaz de Nivel
+    Nivel* nivel = const_cast<Juego*>(this)->obtenerNivelBase();
+    return nivel && cohete && nivel->verificarVictoria(cohete.get());
 }
 
 bool Juego::verificarDerrotaNivel() const {
@@ -396,6 +885,7 @@ void Juego::pausar() {
 
 void Juego::reanudar() {
     pausado = false;
+    acumuladorTiempo = 0.0;
 }
 
 void Juego::reiniciarNivel() {
@@ -413,8 +903,19 @@ void Juego::siguienteNivel() {
 }
 
 void Juego::limpiarEstadoAnterior() {
+    pasoActual = 0;
+    if (rebobinador) {
+        rebobinador->vaciar();
+    }
     tiempoSimulacion = 0.0;
     tiempoControl = 0.0;
+    acumuladorTiempo = 0.0;
+    tiempoFinal = 0.0;
+    registroEventos.clear();
+    telemetria.reiniciar();
+    if (sensores) {
+        sensores->reiniciar();
+    }
     victoria = false;
     derrota = false;
 }
@@ -423,14 +924,39 @@ const Cohete* Juego::obtenerCohete() const {
     return cohete.get();
 }
 
+const Cohete* Juego::obtenerCoheteAnterior() const {
+    return &coheteAnterior;
+}
+
 const Nivel* Juego::obtenerNivel() const {
-    return nivelActual.get();
+    return obtenerNivelBase();
 }
 
 AgenteHAL69* Juego::obtenerAgenteHAL() {
     return agenteHAL.get();
 }
 
+const MuestrasHAL& Juego::obtenerMuestrasHAL() const {
+    return muestrasHAL;
+}
+
+const ResumenTelemetria& Juego::obtenerTelemetria() const {
+    return telemetria.obtenerResumen();
+}
+
+bool Juego::tieneSensores() const {
+    return sensores != nullptr;
+}
+
+const EstimacionCohete* Juego::obtenerEstimacion() const {
+    if (!sensores || !sensores->estaCalibrado()) return nullptr;
+    return &sensores->obtenerEstimacion();
+}
+
+Cohete Juego::obtenerCohetePercibido() const {
+    return sensores ? sensores->percibir(*cohete) : *cohete;
+}
+
 void Juego::simularNivel1Interactivo(double velocidadInicial) {
     iniciarNivel(1);
     velocidadInicial=1000;
@@ -494,19 +1020,30 @@ void Juego::simularNivel3Interactivo() {
 }
 
 double Juego::calcularVelocidadIdealActual() const {
-    if (nivelNumero == 3 && nivelActual) {
-        auto* apolo = dynamic_cast<Nivel3_Apolo11*>(nivelActual.get());
-        if (apolo && cohete) {
+    if (auto* apolo = std::get_if<Nivel3_Apolo11>(&nivelActual)) {
+        if (cohete) {
             return apolo->obtenerVelocidadIdeal(cohete->obtenerAltura());
         }
     }
     return 0.0;
 }
 
+ConsignaAlunizaje Juego::calcularConsignaAutopiloto() const {
+    if (auto* apolo = std::get_if<Nivel3_Apolo11>(&nivelActual)) {
+        if (cohete) {
+            const PilotoAlunizaje piloto(*apolo, deltaTime);
+            const EstimacionCohete* estimacion = obtenerEstimacion();
+            if (!estimacion) return piloto.calcular(*cohete);
+            return piloto.calcular(sensores->percibir(*cohete),
+                                   {estimacion->desvioAltura, estimacion->desvioVelocidad});
+        }
+    }
+    return {};
+}
+
 std::string Juego::obtenerFaseActual() const {
-    if (nivelNumero == 3 && nivelActual && cohete) {
-        auto* apolo = dynamic_cast<Nivel3_Apolo11*>(nivelActual.get());
-        if (apolo) {
+    if (auto* apolo = std::get_if<Nivel3_Apolo11>(&nivelActual)) {
+        if (cohete) {
             return apolo->obtenerFaseDescenso(cohete.get());
         }
     }
@@ -519,3 +1056,18 @@ bool Juego::haGanado() const { return victoria; }
 bool Juego::haPerdido() const { return derrota; }
 int Juego::obtenerNivelActual() const { return nivelNumero; }
 double Juego::obtenerTiempoSimulacion() const { return tiempoSimulacion; }
+bool Juego::estaEnModoSilencioso() const { return silencioso; }
+bool Juego::tieneAvanceBalistico() const { return avanceBalistico; }
+double Juego::obtenerFactorTiempo() const { return factorTiempo; }
+long Juego::obtenerPasoActual() const { return pasoActual; }
+bool Juego::tieneRebobinado() const { return rebobinador != nullptr; }
+long Juego::obtenerPasoMinimoRebobinado() const { return rebobinador ? rebobinador->obtenerPasoMinimo() : -1; }
+long Juego::obtenerPasoMaximoRebobinado() const { return rebobinador ? rebobinador->obtenerPasoMaximo() : -1; }
+double Juego::obtenerFactorTiempoEfectivo() const { return factorTiempoEfectivo; }
+bool Juego::seInterrumpioAceleracion() const { return aceleracionInterrumpida; }
+double Juego::obtenerPasoFisica() const { return deltaTime; }
+TipoIntegrador Juego::obtenerIntegrador() const { return integradorFisica; }
+double Juego::obtenerToleranciaIntegrador() const { return toleranciaIntegrador; }
+double Juego::obtenerFactorInterpolacion() const { return acumuladorTiempo / deltaTime; }
+double Juego::obtenerTiempoFinal() const { return (victoria || derrota) ? tiempoFinal : tiempoSimulacion; }
+const std::vector<EventoRegistrado>& Juego::obtenerEventos() const { return registroEventos; }
@@ -1,39 +1,112 @@
 #ifndef JUEGO_H
 #define JUEGO_H
 
+#include <cstdint>
 #include <memory>
 #include <string>
-#include "Cohete.h"
-#include "Nivel.h"
-#include "Nivel1_Sputnik.h"
-#include "Nivel2_Vostok.h"
-#include "Nivel3_Apolo11.h"
-#include "AgenteHAL69.h"
+#include <variant>
+#include <vector>
+#include "cohete.h"
+#include "nivel.h"
+#include "nivel1_sputnik.h"
+#include "nivel2_vostok.h"
+#include "nivel3_apolo11.h"
+#include "agentehal69.h"
+#include "pilotoalunizaje.h"
+#include "rebobinador.h"
+#include "sensorescohete.h"
+
+// Los niveles se guardan por valor en un variant: el bucle de física se
+// instancia una vez por tipo de nivel y las llamadas a aplicarFisica y
+// verificarVictoria se resuelven en compilación.
+using VarianteNivel = std::variant<std::monostate, Nivel1_Sputnik, Nivel2_Vostok, Nivel3_Apolo11>;
+
+// Evento de física con su instante en tiempo de simulación
+struct EventoRegistrado {
+    double tiempo;
+    TipoEvento tipo;
+    EstadoDinamico estado;
+};
 
 class Juego {
 private:
     std::unique_ptr<Cohete> cohete;
-    std::unique_ptr<Nivel> nivelActual;
+    VarianteNivel nivelActual;
     std::unique_ptr<AgenteHAL69> agenteHAL;
+    std::uint64_t siguienteInformeHAL; // Primer aviso de HAL sin imprimir
+    std::unique_ptr<Rebobinador> rebobinador; // Nulo si no se guarda historial
+
+    // Estado del cohete al inicio del último paso (para interpolar el dibujo)
+    Cohete coheteAnterior;
 
     int nivelNumero;
+    long pasoActual;         // Pasos de física desde el inicio del nivel
     double tiempoSimulacion;
     double tiempoControl;
     double deltaTime;
+    double acumuladorTiempo; // Tiempo real pendiente de simular (paso fijo)
     double tiempoMaximo;
+    double tiempoFinal;      // Instante exacto en que terminó la partida
+    std::vector<EventoRegistrado> registroEventos;
+    TipoIntegrador integradorFisica;
+    double toleranciaIntegrador;
     bool enEjecucion;
     bool pausado;
     bool victoria;
     bool derrota;
+    bool silencioso; // Sin salida por consola ni análisis de HAL (simulación por lotes)
+    bool avanceBalistico; // Saltar en forma cerrada los tramos sin empuje ni resistencia
+    bool reproduciendo;   // Rehaciendo pasos al rebobinar: ni se registran ni se imprimen
+    bool halAsincrono;    // El informe de HAL lo analiza otro hilo a partir de muestrasHAL
+    MuestrasHAL muestrasHAL;
+    MonitorTelemetria telemetria; // Se alimenta en cada paso salvo en modo silencioso
+    std::unique_ptr<SensoresCohete> sensores; // Nulo si HAL y el piloto leen el estado exacto
+
+    // Aceleración de tiempo: segundos simulados por segundo real. Solo
+    // cambia cuántos pasos fijos se dan por llamada, nunca el paso, así que
+    // la trayectoria es la misma que a 1x.
+    double factorTiempo;
+    double factorTiempoEfectivo;   // Logrado en la última llamada
+    double presupuestoTiempoReal;  // Segundos reales máximos por llamada acelerada
+    bool aceleracionInterrumpida;  // Volvió sola a 1x cerca de un evento
 
     const double INTERVALO_CONTROL = 10.0;
     const double INTERVALO_IMPRESION = 10.0;
+    const double RETRASO_MAXIMO = 0.25; // Tiempo real máximo a recuperar tras un bloqueo
+    const double FACTOR_TIEMPO_MAXIMO = 1000.0;
+    const double HORIZONTE_EVENTO = 10.0;  // Segundos simulados de aviso antes de un evento
+    const double AVISO_COMBUSTIBLE = 10.0; // % de combustible que cuenta como evento
+    const int BLOQUE_ACELERADO = 256;      // Pasos entre revisiones de eventos y presupuesto
 
     void inicializarNivel(int numeroNivel);
-    void aplicarFisicaNivel();
-    void verificarEstado();
     void consumirCombustiblePorEmpuje();
-    void manejarColisionSuelo();
+    void registrarEventos(const std::vector<EventoFisica>& eventos);
+    double calcularTiempoFinal(const std::vector<EventoFisica>& eventos) const;
+    void registrarPasoRebobinado();
+    void registrarEntrada(TipoEntrada tipo, double valor);
+    void aplicarEntrada(const EntradaControl& entrada);
+    void imprimirInformesHAL();
+
+    // Bucle de pasos para un tipo de nivel concreto
+    template<class NivelT>
+    int ejecutarPasos(NivelT& nivel, int maxPasos, double tiempoLimite);
+    template<class NivelT>
+    void verificarEstado(NivelT& nivel);
+    // Pasa el último paso (de coheteAnterior a cohete) al monitor de telemetría
+    template<class NivelT>
+    void observarTelemetria(const NivelT& nivel);
+    // Pasa a los sensores los 'duracion' segundos que terminan en el paso actual
+    template<class NivelT>
+    void observarSensores(const NivelT& nivel, double duracion);
+    // Salta de una vez los pasos completos de planeo que caben antes del
+    // próximo umbral del nivel, de tiempoLimite y del próximo análisis de
+    // HAL. Devuelve los pasos saltados (0 si no conviene saltar).
+    template<class NivelT>
+    int planear(NivelT& nivel, int maxPasos, double tiempoLimite);
+    int ejecutarPasos(int maxPasos, double tiempoLimite);
+
+    Nivel* obtenerNivelBase();
+    const Nivel* obtenerNivelBase() const;
 
 public:
     Juego();
@@ -45,6 +118,13 @@ public:
     void iniciarNivel2();
     void iniciarNivel3();
     void actualizar();
+    // Varios pasos seguidos con un solo despacho por tipo de nivel. Se
+    // detienen al terminar la partida; avanzarHasta también cuando el tiempo
+    // simulado llega a tiempoLimite. Devuelven los pasos simulados.
+    int avanzar(int pasos);
+    int avanzarHasta(double tiempoLimite);
+    // Avanza segundosReales * factorTiempo de simulación a paso fijo
+    int avanzarTiempoReal(double segundosReales);
     void pausar();
     void reanudar();
     void reiniciarNivel();
@@ -52,9 +132,32 @@ public:
 
     void ajustarEmpuje(double nuevoEmpuje);
     void establecerVelocidadInicial(double velocidad);
+    // Nivel 3: velocidad vertical con la que empieza el descenso
+    void establecerVelocidadDescenso(double velocidad);
     void establecerAlturaInicial(double altura);
+    // Antes de iniciarSimulacion: combustible de partida (hasta la capacidad
+    // del tanque) y coeficiente de arrastre del nivel cargado
+    void establecerCombustibleInicial(double combustible);
+    void establecerResistenciaAire(double resistencia);
     void iniciarSimulacion();
     void moverCoheteHorizontal(double deltaX);  // Para nivel 3 - control de teclado
+    void establecerModoSilencioso(bool activar);
+    // El informe periódico de HAL no se analiza dentro del paso: solo se
+    // guarda una muestra en obtenerMuestrasHAL() para que lo haga otro hilo
+    void establecerHALAsincrono(bool activar);
+    void establecerPasoFisica(double paso);
+    void establecerIntegrador(TipoIntegrador tipo, double tolerancia = 1e-6);
+    void establecerAvanceBalistico(bool activar);
+    // Guarda un historial para rebobinar dentro de 'presupuestoBytes'
+    void establecerRebobinado(bool activar, std::size_t presupuestoBytes = 1 << 20);
+    // HAL, el piloto automático y la telemetría de la interfaz pasan a ver
+    // la estimación de sensores con ruido y retraso en lugar del estado exacto
+    void establecerSensores(bool activar, const ConfiguracionSensores& configuracion = ConfiguracionSensores());
+    // 1 = tiempo real, hasta FACTOR_TIEMPO_MAXIMO. Cerca de un evento
+    // (altura objetivo, suelo, límite de velocidad, combustible bajo) vuelve
+    // sola a 1x.
+    void establecerFactorTiempo(double factor);
+    void establecerPresupuestoTiempoReal(double segundos);
 
     bool estaEnEjecucion() const;
     bool estaPausado() const;
@@ -62,13 +165,54 @@ public:
     bool haPerdido() const;
     int obtenerNivelActual() const;
     double obtenerTiempoSimulacion() const;
+    bool estaEnModoSilencioso() const;
+    bool tieneAvanceBalistico() const;
+    double obtenerFactorTiempo() const;
+    double obtenerFactorTiempoEfectivo() const;
+    bool seInterrumpioAceleracion() const;
+    // Segundos simulados estimados hasta el próximo evento con el estado
+    // y el consumo del último paso (infinito si no se espera ninguno)
+    double estimarTiempoHastaEvento() const;
+    double obtenerPasoFisica() const;
+    TipoIntegrador obtenerIntegrador() const;
+    double obtenerToleranciaIntegrador() const;
+    double obtenerFactorInterpolacion() const;
+    // Con la partida terminada, el instante del evento que la decidió
+    // (cruce de la altura objetivo, contacto...) en lugar del final del paso
+    double obtenerTiempoFinal() const;
+    const std::vector<EventoRegistrado>& obtenerEventos() const;
+
+    // Copia por valor del estado de la partida. restaurarEstado carga el
+    // nivel si hace falta; el resultado sigue exactamente igual que el
+    // original con las mismas entradas.
+    EstadoJuego capturarEstado() const;
+    void restaurarEstado(const EstadoJuego& estado);
+
+    // Vuelve al paso indicado (recortado al rango del historial) desde el
+    // punto de control anterior y rehaciendo las entradas registradas. La
+    // partida queda en pausa; el futuro anterior se descarta recién cuando
+    // se simula un paso nuevo o llega una entrada.
+    bool rebobinarA(long paso);
+    long obtenerPasoActual() const;
+    bool tieneRebobinado() const;
+    long obtenerPasoMinimoRebobinado() const;
+    long obtenerPasoMaximoRebobinado() const;
 
     const Cohete* obtenerCohete() const;
+    const Cohete* obtenerCoheteAnterior() const;
     const Nivel* obtenerNivel() const;
     AgenteHAL69* obtenerAgenteHAL();
+    const MuestrasHAL& obtenerMuestrasHAL() const;
+    const ResumenTelemetria& obtenerTelemetria() const;
+    bool tieneSensores() const;
+    // Nulo sin sensores o antes de la primera lectura
+    const EstimacionCohete* obtenerEstimacion() const;
+    // El cohete como lo ven HAL y el piloto: el real sin sensores
+    Cohete obtenerCohetePercibido() const;
 
     void imprimirEstadoConsola() const;
     void imprimirInformacionNivel() const;
+    void imprimirAvisoHAL(const AvisoHAL& aviso) const;
     std::string obtenerResumenEstado() const;
 
     void simularNivel1Interactivo(double velocidadInicial);
@@ -80,6 +224,8 @@ public:
     std::string obtenerRazonDerrota() const;
 
     double calcularVelocidadIdealActual() const;
+    // Lo que haría el piloto automático ahora (nivel 3; vacío en otro nivel)
+    ConsignaAlunizaje calcularConsignaAutopiloto() const;
     std::string obtenerFaseActual() const;
     std::string obtenerRecomendacionHAL() const;
 
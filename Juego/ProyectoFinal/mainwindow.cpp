@@ -1,8 +1,15 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "tablaalunizaje.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
 #include <QMessageBox>
+#include <QPushButton>
+#include <QSignalBlocker>
 #include <QVBoxLayout>
 #include <QFocusEvent>
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 
@@ -11,9 +18,18 @@ MainWindow::MainWindow(QWidget *parent)
     , ui(new Ui::MainWindow)
     , nivel1Completado(false)
     , nivel2Completado(false)
+    , siguienteAvisoHAL(0)
 {
     ui->setupUi(this);
 
+    // Proyectar la tabla de alunizaje de HAL-69 ahora y no en el primer
+    // consejo del nivel 3. Se busca junto al ejecutable, no en el
+    // directorio de trabajo; si falta, HAL usa solo el piloto.
+    const QString rutaTabla = QDir(QCoreApplication::applicationDirPath())
+                                  .filePath(TablaAlunizaje::RUTA_PREDETERMINADA);
+    const bool hayTabla =
+        TablaAlunizaje::compartida(QFile::encodeName(rutaTabla).toStdString()).estaCargada();
+
     // Inicializar el juego
     inicializarJuego();
 
@@ -23,6 +39,12 @@ MainWindow::MainWindow(QWidget *parent)
     // Timer para actualización del juego
     timerJuego = new QTimer(this);
     connect(timerJuego, &QTimer::timeout, this, &MainWindow::actualizarJuego);
+    timerAlternativas = new QTimer(this);
+    connect(timerAlternativas, &QTimer::timeout, this, &MainWindow::esperarAlternativas);
+    timerPrevision = new QTimer(this);
+    connect(timerPrevision, &QTimer::timeout, this, &MainWindow::esperarPrevision);
+    timerPerfil = new QTimer(this);
+    connect(timerPerfil, &QTimer::timeout, this, &MainWindow::esperarPerfilOptimo);
 
     // Configuración inicial de controles
     ui->sliderEmpuje->setValue(0);
@@ -38,6 +60,11 @@ MainWindow::MainWindow(QWidget *parent)
 
     // Mensaje inicial de HAL
     agregarMensajeHAL("HAL-69: Sistemas iniciados. Completa el Nivel 1 para desbloquear más niveles.");
+    if(!hayTabla) {
+        agregarMensajeHAL(QString("HAL-69: Sin tabla de alunizaje en %1: en el nivel 3 solo comparo con el piloto automático. "
+                                  "Se genera con SimuladorLotes --generar-tabla-alunizaje %1")
+                              .arg(QDir::toNativeSeparators(rutaTabla)));
+    }
     
     // Asegurar que la ventana principal pueda recibir eventos de teclado
     setFocusPolicy(Qt::StrongFocus);
@@ -53,7 +80,20 @@ MainWindow::~MainWindow()
 
 void MainWindow::inicializarJuego()
 {
-    juego = std::make_unique<Juego>();
+    simulacion = std::make_unique<SimulacionConcurrente>(1.0 / FRECUENCIA_FISICA_HZ);
+    // La biblioteca de previsiones del nivel 1 se simula en segundo plano
+    // (unos 2 s con un núcleo); mostrarPrevision() espera a que esté
+    bibliotecaTrayectorias = std::make_unique<BibliotecaTrayectorias>(1.0 / FRECUENCIA_FISICA_HZ);
+}
+
+const InstantaneaJuego& MainWindow::estadoJuego() const
+{
+    return simulacion->obtenerInstantanea();
+}
+
+const InstantaneaJuego& MainWindow::ordenar(TipoComando tipo, double valor)
+{
+    return simulacion->esperarComando(simulacion->enviar(tipo, valor));
 }
 
 void MainWindow::inicializarWidgetVisualizacion()
@@ -76,19 +116,21 @@ void MainWindow::inicializarWidgetVisualizacion()
 
 void MainWindow::on_btnNivel1_clicked()
 {
-    juego->iniciarNivel(1);
+    simulacion->enviar(TipoComando::IniciarNivel, 1);
 
     // Establecer velocidad inicial desde el campo de entrada
     double velocidadInicial = ui->spinVelocidadInicial->value();
-    juego->establecerVelocidadInicial(velocidadInicial);
+    const InstantaneaJuego& estado = ordenar(TipoComando::EstablecerVelocidadInicial, velocidadInicial);
 
     ui->labelNombreNivel->setText("SPUTNIK 1957");
     ui->labelDescripcionNivel->setText(
-        QString::fromStdString(juego->obtenerNivel()->obtenerDescripcion())
+        QString::fromStdString(estado.descripcionNivel)
         );
 
-    widgetVisualizacion->actualizarNivel(juego->obtenerNivel(), 1);
-    widgetVisualizacion->actualizarCohete(juego->obtenerCohete());
+    widgetVisualizacion->actualizarNivel(estado.alturaObjetivo, 1);
+    ui->btnPerfilOptimo->setEnabled(false);
+    widgetVisualizacion->actualizarCohete(&estado.cohete);
+    mostrarPrevision();
 
     // Habilitar campo de velocidad inicial solo para nivel 1
     ui->spinVelocidadInicial->setEnabled(true);
@@ -99,6 +141,7 @@ void MainWindow::on_btnNivel1_clicked()
 
     ui->btnIniciar->setEnabled(true);
     ui->btnReiniciar->setEnabled(true);
+    actualizarAlternativas();
     actualizarTelemetria();
 }
 
@@ -112,15 +155,16 @@ void MainWindow::on_btnNivel2_clicked()
         return;
     }
     
-    juego->iniciarNivel(2);
+    const InstantaneaJuego& estado = ordenar(TipoComando::IniciarNivel, 2);
 
     ui->labelNombreNivel->setText("VOSTOK 1 - 1961");
     ui->labelDescripcionNivel->setText(
-        QString::fromStdString(juego->obtenerNivel()->obtenerDescripcion())
+        QString::fromStdString(estado.descripcionNivel)
         );
 
-    widgetVisualizacion->actualizarNivel(juego->obtenerNivel(), 2);
-    widgetVisualizacion->actualizarCohete(juego->obtenerCohete());
+    widgetVisualizacion->actualizarNivel(estado.alturaObjetivo, 2);
+    ui->btnPerfilOptimo->setEnabled(!perfilEnCurso.valid());
+    widgetVisualizacion->actualizarCohete(&estado.cohete);
 
     // Deshabilitar campo de velocidad inicial para otros niveles
     ui->spinVelocidadInicial->setEnabled(false);
@@ -130,6 +174,7 @@ void MainWindow::on_btnNivel2_clicked()
 
     ui->btnIniciar->setEnabled(true);
     ui->btnReiniciar->setEnabled(true);
+    actualizarAlternativas();
     actualizarTelemetria();
 }
 
@@ -143,15 +188,16 @@ void MainWindow::on_btnNivel3_clicked()
         return;
     }
     
-    juego->iniciarNivel(3);
+    const InstantaneaJuego& estado = ordenar(TipoComando::IniciarNivel, 3);
 
     ui->labelNombreNivel->setText("APOLO 11 - 1969");
     ui->labelDescripcionNivel->setText(
-        QString::fromStdString(juego->obtenerNivel()->obtenerDescripcion())
+        QString::fromStdString(estado.descripcionNivel)
         );
 
-    widgetVisualizacion->actualizarNivel(juego->obtenerNivel(), 3);
-    widgetVisualizacion->actualizarCohete(juego->obtenerCohete());
+    widgetVisualizacion->actualizarNivel(estado.alturaObjetivo, 3);
+    ui->btnPerfilOptimo->setEnabled(false);
+    widgetVisualizacion->actualizarCohete(&estado.cohete);
 
     // Deshabilitar campo de velocidad inicial para otros niveles
     ui->spinVelocidadInicial->setEnabled(false);
@@ -166,6 +212,7 @@ void MainWindow::on_btnNivel3_clicked()
     setFocus();
     activateWindow();
     
+    actualizarAlternativas();
     actualizarTelemetria();
 }
 
@@ -175,20 +222,26 @@ void MainWindow::on_btnNivel3_clicked()
 
 void MainWindow::on_btnIniciar_clicked()
 {
-    if(!juego->estaEnEjecucion() && juego->obtenerNivelActual() > 0) {
+    if(!estadoJuego().enEjecucion && estadoJuego().nivel > 0) {
         // Iniciar simulación en el juego
-        juego->iniciarSimulacion();
+        ordenar(TipoComando::IniciarSimulacion);
         
         // Iniciar timer y animación
-        timerJuego->start(100); // Actualizar cada 100ms
+        timerJuego->start(INTERVALO_FRAME_MS);
+        relojFrame.start();
         widgetVisualizacion->iniciarAnimacion();
 
         ui->btnIniciar->setEnabled(false);
         ui->btnPausar->setEnabled(true);
         ui->btnPausar->setText("⏸ PAUSAR");
+        ui->btnPerfilOptimo->setEnabled(false);
+        actualizarAlternativas();
+        // La previsión es con el motor apagado: en vuelo ya no vale
+        timerPrevision->stop();
+        widgetVisualizacion->limpiarPrevision();
 
         // Asegurar foco para nivel 3 (control con teclado)
-        if(juego->obtenerNivelActual() == 3) {
+        if(estadoJuego().nivel == 3) {
             setFocus();
             activateWindow();
             agregarMensajeHAL("HAL-69: Simulación iniciada. Usa las flechas ← → para mover el cohete horizontalmente. ¡Buena suerte!");
@@ -206,10 +259,11 @@ void MainWindow::on_btnIniciar_clicked()
 
 void MainWindow::on_btnPausar_clicked()
 {
-    if(juego->estaPausado()) {
+    if(estadoJuego().pausado) {
         // Reanudar
-        juego->reanudar();
-        timerJuego->start(100);
+        ordenar(TipoComando::Reanudar);
+        timerJuego->start(INTERVALO_FRAME_MS);
+        relojFrame.start();
         widgetVisualizacion->iniciarAnimacion();
 
         ui->btnPausar->setText("⏸ PAUSAR");
@@ -218,7 +272,7 @@ void MainWindow::on_btnPausar_clicked()
         ui->labelEstado->setText("🟢 EN PROGRESO");
     } else {
         // Pausar
-        juego->pausar();
+        ordenar(TipoComando::Pausar);
         timerJuego->stop();
         widgetVisualizacion->detenerAnimacion();
         
@@ -244,23 +298,30 @@ void MainWindow::on_btnReiniciar_clicked()
     // Limpiar teclas presionadas al reiniciar
     teclasPresionadas.clear();
 
-    juego->reiniciarNivel();
+    unsigned long long orden = simulacion->enviar(TipoComando::ReiniciarNivel);
 
     // Reestablecer velocidad inicial si es el nivel 1
-    if(juego->obtenerNivelActual() == 1) {
+    if(estadoJuego().nivel == 1) {
         double velocidadInicial = ui->spinVelocidadInicial->value();
-        juego->establecerVelocidadInicial(velocidadInicial);
+        orden = simulacion->enviar(TipoComando::EstablecerVelocidadInicial, velocidadInicial);
     }
 
+    const InstantaneaJuego& estado = simulacion->esperarComando(orden);
+
     widgetVisualizacion->reiniciar();
-    widgetVisualizacion->actualizarCohete(juego->obtenerCohete());
+    widgetVisualizacion->actualizarCohete(&estado.cohete);
 
     ui->sliderEmpuje->setValue(0);
     ui->btnIniciar->setEnabled(true);
     ui->btnPausar->setEnabled(false);
+    ui->btnPerfilOptimo->setEnabled(estado.nivel == 2 && !perfilEnCurso.valid());
     ui->btnPausar->setText("⏸ PAUSAR");
 
     agregarMensajeHAL("HAL-69: Nivel reiniciado. Sistemas listos.");
+    actualizarAlternativas();
+    if(estado.nivel == 1) {
+        mostrarPrevision();
+    }
 
     ui->labelEstado->setText("⚪ LISTO");
     ui->labelEstado->setStyleSheet(
@@ -273,7 +334,7 @@ void MainWindow::on_btnReiniciar_clicked()
 
 void MainWindow::on_sliderEmpuje_valueChanged(int value)
 {
-    juego->ajustarEmpuje(static_cast<double>(value));
+    simulacion->enviar(TipoComando::AjustarEmpuje, static_cast<double>(value));
 
     ui->labelEmpujeValor->setText(QString("%1 N").arg(value));
 }
@@ -281,10 +342,127 @@ void MainWindow::on_sliderEmpuje_valueChanged(int value)
 void MainWindow::on_spinVelocidadInicial_valueChanged(double value)
 {
     // Si el nivel 1 está cargado pero no iniciado, actualizar la velocidad inicial
-    if(juego->obtenerNivelActual() == 1 && !juego->estaEnEjecucion()) {
-        juego->establecerVelocidadInicial(value);
-        widgetVisualizacion->actualizarCohete(juego->obtenerCohete());
+    if(estadoJuego().nivel == 1 && !estadoJuego().enEjecucion) {
+        const InstantaneaJuego& estado = ordenar(TipoComando::EstablecerVelocidadInicial, value);
+        widgetVisualizacion->actualizarCohete(&estado.cohete);
+        mostrarPrevision();
+    }
+}
+
+void MainWindow::on_comboAceleracion_currentIndexChanged(int index)
+{
+    if(index < 0) return;
+
+    // Solo cambia cuántos pasos fijos se dan por frame: la trayectoria es
+    // la misma que a x1
+    simulacion->enviar(TipoComando::EstablecerFactorTiempo, FACTORES_TIEMPO[index]);
+}
+
+void MainWindow::on_checkSensores_toggled(bool activar)
+{
+    simulacion->enviar(TipoComando::EstablecerSensores, activar ? 1.0 : 0.0);
+}
+
+void MainWindow::on_btnExplorar_clicked()
+{
+    // Con el motor apagado se toma como referencia un décimo del máximo
+    double referencia = estadoJuego().cohete.obtenerEmpuje();
+    if(referencia <= 0.0) {
+        referencia = ui->sliderEmpuje->maximum() / 10.0;
+    }
+
+    ordenar(TipoComando::ExplorarEmpujes, referencia);
+    ui->labelAlternativas->setText("Explorando alternativas...");
+    timerAlternativas->start(INTERVALO_FRAME_MS);
+}
+
+void MainWindow::on_btnPerfilOptimo_clicked()
+{
+    const InstantaneaJuego& estado = estadoJuego();
+    if(estado.nivel != 2 || estado.enEjecucion || perfilEnCurso.valid()) return;
+
+    // Parte de la velocidad y el combustible con que empieza este intento
+    ConfiguracionOptimizador config;
+    config.velocidadInicial = estado.cohete.obtenerVelocidad();
+    config.combustibleInicial = estado.cohete.obtenerCombustible();
+
+    // Tarda unos segundos: corre en otro hilo y la interfaz sigue
+    // respondiendo. Deja un núcleo libre para la simulación en vivo.
+    if(!optimizador) {
+        optimizador = std::make_unique<OptimizadorVostok>(
+            std::max(1u, GrupoHilos::hilosDisponibles() - 1));
+    }
+    OptimizadorVostok* buscador = optimizador.get();
+    perfilEnCurso = std::async(std::launch::async, [buscador, config]() {
+        PerfilOptimo perfil;
+        perfil.config = config;
+        perfil.resultado = buscador->optimizar(config);
+        if(perfil.resultado.factible) {
+            perfil.puntos = OptimizadorVostok::muestrear(
+                OptimizadorVostok::crearMision(config, perfil.resultado.programa), 1.0);
+        }
+        return perfil;
+    });
+
+    ui->btnPerfilOptimo->setEnabled(false);
+    agregarMensajeHAL("HAL-69: Buscando el perfil de empuje óptimo...");
+    timerPerfil->start(INTERVALO_FRAME_MS);
+}
+
+void MainWindow::esperarPerfilOptimo()
+{
+    if(perfilEnCurso.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+
+    timerPerfil->stop();
+    const PerfilOptimo perfil = perfilEnCurso.get();
+    const InstantaneaJuego& estado = estadoJuego();
+    ui->btnPerfilOptimo->setEnabled(estado.nivel == 2 && !estado.enEjecucion);
+
+    const ConfiguracionOptimizador& config = perfil.config;
+    const ResultadoOptimizacion& resultado = perfil.resultado;
+    if(!resultado.factible) {
+        widgetVisualizacion->limpiarPerfiles();
+        agregarMensajeHAL(QString("HAL-69: Con %1 m/s y %2 kg de combustible ningún programa de empuje llega a la órbita.")
+                              .arg(config.velocidadInicial, 0, 'f', 0)
+                              .arg(config.combustibleInicial, 0, 'f', 0));
+        return;
     }
+
+    const QString rutaPrograma = QDir(QCoreApplication::applicationDirPath())
+                                     .filePath(ARCHIVO_PROGRAMA_OPTIMO);
+    const bool guardado = resultado.programa.guardar(QFile::encodeName(rutaPrograma).toStdString());
+
+    // Si mientras tanto se cambió de nivel el perfil ya no tiene dónde dibujarse
+    if(estado.nivel == 2) {
+        QVector<QPointF> referencia;
+        referencia.reserve(static_cast<int>(perfil.puntos.size()));
+        for(const PuntoTrayectoria& punto : perfil.puntos) {
+            referencia.append(QPointF(punto.tiempo, punto.altura));
+        }
+        widgetVisualizacion->establecerPerfilReferencia(referencia);
+    }
+
+    QString tramos;
+    for(const ProgramaEmpuje::Tramo& tramo : resultado.programa.obtenerTramos()) {
+        tramos += QString("\n  desde %1 s: %2 N").arg(tramo.tiempoInicio, 0, 'f', 1).arg(tramo.empuje, 0, 'f', 0);
+    }
+    agregarMensajeHAL(QString("HAL-69: Perfil óptimo: %1 kg de combustible, llega en %2 s.%3%4")
+                          .arg(resultado.combustibleUsado, 0, 'f', 0)
+                          .arg(resultado.mision.tiempo, 0, 'f', 1)
+                          .arg(tramos)
+                          .arg(guardado ? QString("\nGuardado en %1.").arg(QDir::toNativeSeparators(rutaPrograma)) : QString()));
+}
+
+void MainWindow::on_sliderRebobinado_sliderMoved(int value)
+{
+    // Mientras se arrastra solo se muestra el instante; se rebobina al soltar
+    ui->labelRebobinado->setText(QString("Rebobinar: %1 s")
+                                     .arg(value / FRECUENCIA_FISICA_HZ, 0, 'f', 1));
+}
+
+void MainWindow::on_sliderRebobinado_sliderReleased()
+{
+    rebobinar(ui->sliderRebobinado->value());
 }
 
 // ============================================================================
@@ -293,89 +471,262 @@ void MainWindow::on_spinVelocidadInicial_valueChanged(double value)
 
 void MainWindow::actualizarJuego()
 {
-    if(!juego->estaEnEjecucion() || juego->estaPausado()) {
+    // La física avanza sola en su hilo; aquí solo se toma la última
+    // instantánea publicada y se mandan los controles del frame
+    simulacion->actualizarInstantanea();
+    const InstantaneaJuego& estado = estadoJuego();
+
+    // Tiempo real transcurrido desde el frame anterior
+    double dtReal = relojFrame.nsecsElapsed() / 1e9;
+    relojFrame.restart();
+
+    // La partida pudo terminar entre dos frames: mostrar el estado final
+    if(estado.victoria || estado.derrota) {
+        actualizarInterfaz();
+        actualizarRebobinado();
+        verificarEstadoJuego();
+        return;
+    }
+
+    if(!estado.enEjecucion || estado.pausado) {
         return;
     }
 
     // Procesar movimiento con teclado para nivel 3
-    if(juego->obtenerNivelActual() == 3) {
-        // El timer se ejecuta cada 100ms (0.1 segundos)
-        // Aumentamos significativamente la aceleración para que el movimiento sea más notorio
-        double aceleracionHorizontal = 15.0; // m/s² por frame (ajustado para movimiento más rápido y visible)
+    if(estado.nivel == 3) {
+        // Los valores están pensados por cada 0.1 s; se escalan con la
+        // duración real del frame para que no dependan de los FPS
+        double escalaFrame = dtReal / 0.1;
+        double aceleracionHorizontal = 15.0 * escalaFrame;
+        double cambioEmpuje = 10000.0 * escalaFrame;
         
         if(teclasPresionadas.contains(Qt::Key_Left)) {
-            juego->moverCoheteHorizontal(-aceleracionHorizontal);
+            simulacion->enviar(TipoComando::MoverHorizontal, -aceleracionHorizontal);
         }
         if(teclasPresionadas.contains(Qt::Key_Right)) {
-            juego->moverCoheteHorizontal(aceleracionHorizontal);
+            simulacion->enviar(TipoComando::MoverHorizontal, aceleracionHorizontal);
         }
         if(teclasPresionadas.contains(Qt::Key_Up)) {
             // Aumentar empuje gradualmente
-            double empujeActual = juego->obtenerCohete()->obtenerEmpuje();
-            double nuevoEmpuje = empujeActual + 10000.0;
-            juego->ajustarEmpuje(nuevoEmpuje);
+            double empujeActual = estado.cohete.obtenerEmpuje();
+            double nuevoEmpuje = empujeActual + cambioEmpuje;
+            simulacion->enviar(TipoComando::AjustarEmpuje, nuevoEmpuje);
             ui->sliderEmpuje->setValue(static_cast<int>(nuevoEmpuje));
         }
         if(teclasPresionadas.contains(Qt::Key_Down)) {
             // Disminuir empuje gradualmente
-            double empujeActual = juego->obtenerCohete()->obtenerEmpuje();
-            double nuevoEmpuje = empujeActual - 10000.0;
-            juego->ajustarEmpuje(nuevoEmpuje);
+            double empujeActual = estado.cohete.obtenerEmpuje();
+            double nuevoEmpuje = empujeActual - cambioEmpuje;
+            simulacion->enviar(TipoComando::AjustarEmpuje, nuevoEmpuje);
             ui->sliderEmpuje->setValue(static_cast<int>(nuevoEmpuje));
         }
     }
 
-    // Actualizar la simulación
-    juego->actualizar();
-
     // Actualizar la interfaz
     actualizarInterfaz();
+    actualizarAceleracion();
+    actualizarRebobinado();
+    actualizarAlternativas();
     
-    // Obtener mensaje de HAL69 y mostrarlo si hay algo importante
-    std::string mensajeHAL = juego->obtenerAgenteHAL()->obtenerMensajeUI(
-        juego->obtenerNivelActual(),
-        *juego->obtenerNivel(),
-        *juego->obtenerCohete(),
-        juego->obtenerTiempoSimulacion()
-    );
-    
-    // Solo mostrar mensajes importantes (no vacíos) y no repetirlos constantemente
-    static std::string ultimoMensajeHAL = "";
-    static int contadorMensajes = 0;
-    
-    if(!mensajeHAL.empty() && mensajeHAL != ultimoMensajeHAL) {
-        // Mostrar mensaje cada 2 segundos aproximadamente (cada 20 actualizaciones)
-        if(contadorMensajes % 20 == 0) {
-            agregarMensajeHAL(QString::fromStdString(mensajeHAL));
-            ultimoMensajeHAL = mensajeHAL;
-        }
-        contadorMensajes++;
-    } else if(mensajeHAL.empty()) {
-        ultimoMensajeHAL = "";
-        contadorMensajes = 0;
+    // Consejos de HAL69 nuevos desde el último frame. La simulación ya los
+    // filtró (sin repetir ni atropellarse); el texto se arma solo aquí.
+    const HistorialAvisos& avisos = estado.avisosHAL;
+    siguienteAvisoHAL = std::max(siguienteAvisoHAL, avisos.obtenerPrimero());
+    for (; siguienteAvisoHAL < avisos.obtenerTotal(); ++siguienteAvisoHAL) {
+        const AvisoHAL& aviso = avisos.obtener(siguienteAvisoHAL);
+        if (canalDe(aviso.codigo) != CanalAviso::Interfaz) continue;
+
+        char texto[256];
+        formatearAviso(aviso, texto, sizeof(texto));
+        agregarMensajeHAL("HAL-69: " + QString::fromUtf8(texto));
     }
-
-    // Verificar estado (victoria/derrota)
-    verificarEstadoJuego();
 }
 
 void MainWindow::actualizarInterfaz()
 {
+    const InstantaneaJuego& estado = estadoJuego();
+
     // Actualizar telemetría
     actualizarTelemetria();
 
-    // Actualizar visualización
-    widgetVisualizacion->actualizarCohete(juego->obtenerCohete());
+    // Corrida del jugador para el gráfico contra el perfil óptimo
+    if(estado.nivel == 2) {
+        widgetVisualizacion->agregarPuntoJugador(estado.tiempoSimulacion, estado.cohete.obtenerAltura());
+    }
+
+    // El camino previsto lo calcula la simulación; aquí solo se copia
+    widgetVisualizacion->establecerPrediccion(estado.prevision, estado.marcasPrevision,
+                                              estado.tiempoSimulacion);
+
+    // Actualizar visualización interpolando entre los dos últimos pasos de física
+    widgetVisualizacion->actualizarCohete(&estado.cohete,
+                                          &estado.coheteAnterior,
+                                          estado.factorInterpolacion);
+}
+
+void MainWindow::actualizarAceleracion()
+{
+    const InstantaneaJuego& estado = estadoJuego();
+
+    // La simulación volvió sola a x1 cerca de un evento
+    if(estado.aceleracionInterrumpida && ui->comboAceleracion->currentIndex() != 0) {
+        ui->comboAceleracion->setCurrentIndex(0);
+        agregarMensajeHAL("HAL-69: Evento próximo. Aceleración de tiempo desactivada.");
+    }
+
+    // Si falta CPU la aceleración lograda puede ser menor que la pedida
+    if(estado.factorTiempo > 1.0) {
+        ui->labelAceleracion->setText(QString("Aceleración de tiempo (real x%1):")
+                                          .arg(estado.factorTiempoEfectivo, 0, 'f', 0));
+    } else {
+        ui->labelAceleracion->setText("Aceleración de tiempo:");
+    }
+}
+
+void MainWindow::esperarAlternativas()
+{
+    // Con el juego en pausa timerJuego no corre: este timer toma la
+    // instantánea hasta que llegan los resultados
+    simulacion->actualizarInstantanea();
+    actualizarAlternativas();
+    if(!estadoJuego().explorandoAlternativas) {
+        timerAlternativas->stop();
+    }
+}
+
+void MainWindow::mostrarPrevision()
+{
+    if(!bibliotecaTrayectorias->estaLista()) {
+        widgetVisualizacion->limpiarPrevision();
+        if(!timerPrevision->isActive()) {
+            timerPrevision->start(INTERVALO_FRAME_MS);
+        }
+        return;
+    }
+
+    const TrayectoriaPrevista prevision =
+        bibliotecaTrayectorias->prever(ui->spinVelocidadInicial->value());
+    widgetVisualizacion->establecerPrevision(prevision);
+
+    // Mientras tanto se ve la interpolada; la exacta llega en unos ms
+    if(prevision.exacta) {
+        timerPrevision->stop();
+    } else if(!timerPrevision->isActive()) {
+        timerPrevision->start(INTERVALO_FRAME_MS);
+    }
+}
+
+void MainWindow::esperarPrevision()
+{
+    const InstantaneaJuego& estado = estadoJuego();
+    if(estado.nivel != 1 || estado.enEjecucion) {
+        timerPrevision->stop();
+        return;
+    }
+    if(!bibliotecaTrayectorias->hayCalculosPendientes()) {
+        mostrarPrevision();
+    }
+}
+
+void MainWindow::actualizarAlternativas()
+{
+    const InstantaneaJuego& estado = estadoJuego();
+
+    ui->btnExplorar->setEnabled(estado.enEjecucion && !estado.victoria && !estado.derrota);
+    if(estado.explorandoAlternativas) return;
+
+    if(estado.alternativas.empty()) {
+        ui->labelAlternativas->clear();
+        return;
+    }
+
+    QString texto = QString("Desde t = %1 s, con empuje fijo:").arg(estado.tiempoAlternativas, 0, 'f', 1);
+    for(const AlternativaEmpuje& alternativa : estado.alternativas) {
+        const ResultadoMision& r = alternativa.resultado;
+        QString desenlace;
+        if(r.victoria) {
+            desenlace = QString("✅ %1 s, %2 kg").arg(r.tiempo, 0, 'f', 1).arg(r.combustibleRestante, 0, 'f', 0);
+        } else if(r.terminada) {
+            desenlace = QString("💥 %1 s").arg(r.tiempo, 0, 'f', 1);
+        } else {
+            desenlace = "⏳ sin terminar";
+        }
+        texto += QString("\n%1 N → %2").arg(alternativa.empuje, 7, 'f', 0).arg(desenlace);
+    }
+    ui->labelAlternativas->setText(texto);
+}
+
+void MainWindow::actualizarRebobinado()
+{
+    const InstantaneaJuego& estado = estadoJuego();
+
+    // No mover el slider mientras el jugador lo arrastra
+    if(ui->sliderRebobinado->isSliderDown()) return;
+
+    const bool hayHistorial = estado.pasoMinimoRebobinado >= 0;
+    ui->sliderRebobinado->setEnabled(hayHistorial);
+    if(hayHistorial) {
+        ui->sliderRebobinado->setRange(static_cast<int>(estado.pasoMinimoRebobinado),
+                                       static_cast<int>(estado.pasoMaximoRebobinado));
+    } else {
+        ui->sliderRebobinado->setRange(0, 0);
+    }
+    ui->sliderRebobinado->setValue(static_cast<int>(estado.pasoActual));
+    ui->labelRebobinado->setText(QString("Rebobinar: %1 s")
+                                     .arg(estado.tiempoSimulacion, 0, 'f', 1));
+}
+
+void MainWindow::rebobinar(long paso)
+{
+    // La simulación rehace los pasos desde el punto de control más cercano
+    // y queda en pausa en el instante pedido
+    const InstantaneaJuego& estado = ordenar(TipoComando::Rebobinar, static_cast<double>(paso));
+
+    timerJuego->stop();
+    teclasPresionadas.clear();
+
+    // Quitar la explosión si se venía de una derrota
+    widgetVisualizacion->reiniciar();
+    widgetVisualizacion->actualizarCohete(&estado.cohete);
+    widgetVisualizacion->detenerAnimacion();
+
+    // Mostrar el empuje de ese instante sin mandarlo como orden nueva: una
+    // orden nueva descartaría el futuro que todavía se puede volver a ver
+    {
+        const QSignalBlocker bloqueo(ui->sliderEmpuje);
+        ui->sliderEmpuje->setValue(static_cast<int>(estado.cohete.obtenerEmpuje()));
+    }
+    ui->labelEmpujeValor->setText(QString("%1 N").arg(static_cast<int>(estado.cohete.obtenerEmpuje())));
+
+    ui->btnIniciar->setEnabled(false);
+    ui->btnPausar->setEnabled(estado.enEjecucion);
+    if(estado.pausado) {
+        ui->btnPausar->setText("▶ REANUDAR");
+        ui->labelEstado->setText("🟡 PAUSADO");
+        ui->labelEstado->setStyleSheet(
+            "font-size: 14px; font-weight: bold; color: #ffaa00; "
+            "padding: 10px; background-color: #16213e; border-radius: 5px;"
+            );
+    }
+
+    agregarMensajeHAL(QString("HAL-69: Rebobinado a %1 s. Reanuda para continuar desde ahí.")
+                          .arg(estado.tiempoSimulacion, 0, 'f', 1));
+
+    actualizarTelemetria();
+    actualizarRebobinado();
+    actualizarAlternativas();
 }
 
 void MainWindow::actualizarTelemetria()
 {
-    const Cohete* cohete = juego->obtenerCohete();
-    if(!cohete) return;
+    const InstantaneaJuego& estado = estadoJuego();
+    // Con sensores se muestra lo mismo que ven HAL y el piloto
+    const Cohete* cohete = &estado.cohetePercibido;
+    if(estado.nivel == 0) return;
 
     // Tiempo
     ui->labelTiempo->setText(QString("%1 s").arg(
-        juego->obtenerTiempoSimulacion(), 0, 'f', 1
+        estado.tiempoSimulacion, 0, 'f', 1
         ));
 
     // Altura
@@ -388,9 +739,9 @@ void MainWindow::actualizarTelemetria()
 
     // Cambiar color según velocidad peligrosa
     QString colorVel = "#e94560"; // Color normal
-    if(juego->obtenerNivelActual() == 1 && velocidad > 7000) {
+    if(estado.nivel == 1 && velocidad > 7000) {
         colorVel = "#ff0000"; // Rojo peligro
-    } else if(juego->obtenerNivelActual() == 2 &&
+    } else if(estado.nivel == 2 &&
                (velocidad < 2000 || velocidad > 9000)) {
         colorVel = "#ff6600"; // Naranja advertencia
     }
@@ -421,15 +772,34 @@ void MainWindow::actualizarTelemetria()
     ui->labelMasa->setText(QString("%1 kg").arg(
         cohete->obtenerMasa(), 0, 'f', 0
         ));
+
+    // Empuje recomendado por el piloto automático junto al del jugador
+    if(estado.nivel == 3) {
+        const ConsignaAlunizaje& consigna = estado.autopiloto;
+        QString texto = QString("%1 kN (tú: %2 kN)")
+                            .arg(consigna.empuje / 1000.0, 0, 'f', 0)
+                            .arg(cohete->obtenerEmpuje() / 1000.0, 0, 'f', 0);
+        if(consigna.cambioVelocidadX < -1.0) {
+            texto += "\n← corregir hacia la izquierda";
+        } else if(consigna.cambioVelocidadX > 1.0) {
+            texto += "\n→ corregir hacia la derecha";
+        }
+        ui->labelAutopiloto->setText(texto);
+        ui->labelAutopiloto->setStyleSheet(
+            QString("font-size: 13px; font-weight: bold; color: %1;")
+                .arg(consigna.alcanza ? "#00d4ff" : "#ff0000"));
+    } else {
+        ui->labelAutopiloto->setText("—");
+    }
 }
 
 void MainWindow::verificarEstadoJuego()
 {
-    if(juego->haGanado()) {
+    if(estadoJuego().victoria) {
         timerJuego->stop();
         widgetVisualizacion->detenerAnimacion();
         mostrarMensajeVictoria();
-    } else if(juego->haPerdido()) {
+    } else if(estadoJuego().derrota) {
         // Detener la simulación pero mantener la animación para mostrar la explosión
         timerJuego->stop();
         // NO detener la animación aquí para que la explosión se pueda animar
@@ -441,7 +811,7 @@ void MainWindow::verificarEstadoJuego()
 void MainWindow::mostrarMensajeVictoria()
 {
     // Marcar el nivel como completado
-    int nivelActual = juego->obtenerNivelActual();
+    int nivelActual = estadoJuego().nivel;
     if(nivelActual == 1) {
         nivel1Completado = true;
     } else if(nivelActual == 2) {
@@ -459,7 +829,7 @@ void MainWindow::mostrarMensajeVictoria()
 
     QString mensajeHAL = QString("HAL-69: ¡MISIÓN EXITOSA! Nivel %1 completado en %2 segundos.")
                              .arg(nivelActual)
-                             .arg(juego->obtenerTiempoSimulacion(), 0, 'f', 1);
+                             .arg(estadoJuego().tiempoSimulacion, 0, 'f', 1);
 
     agregarMensajeHAL(mensajeHAL);
 
@@ -474,10 +844,10 @@ void MainWindow::mostrarMensajeVictoria()
                            "Tiempo: %2 segundos\n"
                            "Combustible restante: %3%\n"
                            "Velocidad final: %4 m/s")
-                       .arg(juego->obtenerNivelActual())
-                       .arg(juego->obtenerTiempoSimulacion(), 0, 'f', 1)
-                       .arg(juego->obtenerCohete()->obtenerPorcentajeCombustible(), 0, 'f', 1)
-                       .arg(juego->obtenerCohete()->obtenerVelocidad(), 0, 'f', 1));
+                       .arg(nivelActual)
+                       .arg(estadoJuego().tiempoSimulacion, 0, 'f', 1)
+                       .arg(estadoJuego().cohete.obtenerPorcentajeCombustible(), 0, 'f', 1)
+                       .arg(estadoJuego().cohete.obtenerVelocidad(), 0, 'f', 1));
 
     msgBox.setStyleSheet(
         "QMessageBox { background-color: #1a1a2e; } "
@@ -488,7 +858,7 @@ void MainWindow::mostrarMensajeVictoria()
         "QPushButton:hover { background-color: #e94560; color: white; }"
         );
 
-    if(juego->obtenerNivelActual() < 3) {
+    if(nivelActual < 3) {
         msgBox.setInformativeText("¿Quieres continuar al siguiente nivel?");
         msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
         msgBox.setDefaultButton(QMessageBox::Yes);
@@ -496,20 +866,21 @@ void MainWindow::mostrarMensajeVictoria()
         int respuesta = msgBox.exec();
 
         if(respuesta == QMessageBox::Yes) {
-            int siguienteNivel = juego->obtenerNivelActual() + 1;
+            int siguienteNivel = nivelActual + 1;
 
             switch(siguienteNivel) {
             case 2:
                 // Iniciar nivel 2 heredando velocidad y combustible del nivel 1
-                juego->iniciarNivelDesdeVictoria(2);
+                ordenar(TipoComando::IniciarNivelDesdeVictoria, 2);
 
                 ui->labelNombreNivel->setText("VOSTOK 1 - 1961");
                 ui->labelDescripcionNivel->setText(
-                    QString::fromStdString(juego->obtenerNivel()->obtenerDescripcion())
+                    QString::fromStdString(estadoJuego().descripcionNivel)
                     );
 
-                widgetVisualizacion->actualizarNivel(juego->obtenerNivel(), 2);
-                widgetVisualizacion->actualizarCohete(juego->obtenerCohete());
+                widgetVisualizacion->actualizarNivel(estadoJuego().alturaObjetivo, 2);
+                ui->btnPerfilOptimo->setEnabled(!perfilEnCurso.valid());
+                widgetVisualizacion->actualizarCohete(&estadoJuego().cohete);
 
                 ui->spinVelocidadInicial->setEnabled(false);
                 ui->labelVelocidadInicial->setEnabled(false);
@@ -518,25 +889,27 @@ void MainWindow::mostrarMensajeVictoria()
                                           "Velocidad heredada: %1 m/s\n"
                                           "Combustible heredado: %2 kg\n"
                                           "Objetivo: Mantén velocidad entre 2000-9000 m/s.")
-                                      .arg(juego->obtenerCohete()->obtenerVelocidad(), 0, 'f', 1)
-                                      .arg(juego->obtenerCohete()->obtenerCombustible(), 0, 'f', 1));
+                                      .arg(estadoJuego().cohete.obtenerVelocidad(), 0, 'f', 1)
+                                      .arg(estadoJuego().cohete.obtenerCombustible(), 0, 'f', 1));
 
                 ui->btnIniciar->setEnabled(true);
                 ui->btnReiniciar->setEnabled(true);
+                actualizarAlternativas();
                 actualizarTelemetria();
                 break;
 
             case 3:
                 // Iniciar nivel 3 heredando solo combustible del nivel 2
-                juego->iniciarNivelDesdeVictoria(3);
+                ordenar(TipoComando::IniciarNivelDesdeVictoria, 3);
 
                 ui->labelNombreNivel->setText("APOLO 11 - 1969");
                 ui->labelDescripcionNivel->setText(
-                    QString::fromStdString(juego->obtenerNivel()->obtenerDescripcion())
+                    QString::fromStdString(estadoJuego().descripcionNivel)
                     );
 
-                widgetVisualizacion->actualizarNivel(juego->obtenerNivel(), 3);
-                widgetVisualizacion->actualizarCohete(juego->obtenerCohete());
+                widgetVisualizacion->actualizarNivel(estadoJuego().alturaObjetivo, 3);
+                ui->btnPerfilOptimo->setEnabled(false);
+                widgetVisualizacion->actualizarCohete(&estadoJuego().cohete);
 
                 ui->spinVelocidadInicial->setEnabled(false);
                 ui->labelVelocidadInicial->setEnabled(false);
@@ -546,10 +919,11 @@ void MainWindow::mostrarMensajeVictoria()
                                           "Altura inicial: 15 km\n"
                                           "Velocidad inicial: 0 m/s (descenso)\n"
                                           "Objetivo: Aterrizar con velocidad ≤ 5 m/s.")
-                                      .arg(juego->obtenerCohete()->obtenerCombustible(), 0, 'f', 1));
+                                      .arg(estadoJuego().cohete.obtenerCombustible(), 0, 'f', 1));
 
                 ui->btnIniciar->setEnabled(true);
                 ui->btnReiniciar->setEnabled(true);
+                actualizarAlternativas();
                 actualizarTelemetria();
                 break;
             }
@@ -568,7 +942,7 @@ void MainWindow::mostrarMensajeDerrota()
         "padding: 10px; background-color: #16213e; border-radius: 5px;"
         );
 
-    QString razon = QString::fromStdString(juego->obtenerRazonDerrota());
+    QString razon = QString::fromStdString(estadoJuego().razonDerrota);
     agregarMensajeHAL("HAL-69: Misión fallida. " + razon);
 
     ui->btnIniciar->setEnabled(false);
@@ -581,12 +955,20 @@ void MainWindow::mostrarMensajeDerrota()
                            "Razón: %1\n"
                            "Tiempo: %2 segundos")
                        .arg(razon)
-                       .arg(juego->obtenerTiempoSimulacion(), 0, 'f', 1));
+                       .arg(estadoJuego().tiempoSimulacion, 0, 'f', 1));
 
     msgBox.setInformativeText("¿Quieres intentarlo de nuevo?");
     msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
     msgBox.setDefaultButton(QMessageBox::Yes);
 
+    // Con historial también se puede volver unos segundos antes del fallo
+    QPushButton* botonRebobinar = nullptr;
+    if(estadoJuego().pasoMinimoRebobinado >= 0) {
+        botonRebobinar = msgBox.addButton(
+            QString("⏪ Rebobinar %1 s").arg(SEGUNDOS_REBOBINADO_DERROTA, 0, 'f', 0),
+            QMessageBox::ActionRole);
+    }
+
     msgBox.setStyleSheet(
         "QMessageBox { background-color: #1a1a2e; } "
         "QLabel { color: #eee; font-size: 12px; } "
@@ -598,7 +980,10 @@ void MainWindow::mostrarMensajeDerrota()
 
     int respuesta = msgBox.exec();
 
-    if(respuesta == QMessageBox::Yes) {
+    if(botonRebobinar && msgBox.clickedButton() == botonRebobinar) {
+        const long pasosAtras = static_cast<long>(SEGUNDOS_REBOBINADO_DERROTA * FRECUENCIA_FISICA_HZ);
+        rebobinar(estadoJuego().pasoActual - pasosAtras);
+    } else if(respuesta == QMessageBox::Yes) {
         on_btnReiniciar_clicked();
     }
 }
@@ -665,7 +1050,8 @@ void MainWindow::verificarYBloquearNivel(int nivel)
 void MainWindow::keyPressEvent(QKeyEvent *event)
 {
     // Solo procesar teclas cuando el nivel 3 está activo y en ejecución
-    if(juego->obtenerNivelActual() == 3 && juego->estaEnEjecucion() && !juego->estaPausado()) {
+    const InstantaneaJuego& estado = estadoJuego();
+    if(estado.nivel == 3 && estado.enEjecucion && !estado.pausado) {
         // Agregar la tecla al conjunto de teclas presionadas
         teclasPresionadas.insert(event->key());
         
@@ -685,7 +1071,7 @@ void MainWindow::keyPressEvent(QKeyEvent *event)
 void MainWindow::keyReleaseEvent(QKeyEvent *event)
 {
     // Remover la tecla del conjunto cuando se suelta
-    if(juego->obtenerNivelActual() == 3) {
+    if(estadoJuego().nivel == 3) {
         teclasPresionadas.remove(event->key());
         
         switch(event->key()) {
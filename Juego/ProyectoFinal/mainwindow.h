@@ -3,11 +3,17 @@
 
 #include <QMainWindow>
 #include <QTimer>
+#include <QElapsedTimer>
 #include <QKeyEvent>
 #include <QFocusEvent>
 #include <QSet>
+#include <cstdint>
+#include <future>
 #include <memory>
-#include "Juego.h"
+#include <vector>
+#include "bibliotecatrayectorias.h"
+#include "optimizadorvostok.h"
+#include "simulacionconcurrente.h"
 #include "visualizacionwidget.h"
 
 QT_BEGIN_NAMESPACE
@@ -41,17 +47,55 @@ private slots:
     void on_btnReiniciar_clicked();
     void on_sliderEmpuje_valueChanged(int value);
     void on_spinVelocidadInicial_valueChanged(double value);
+    void on_comboAceleracion_currentIndexChanged(int index);
+    void on_checkSensores_toggled(bool activar);
+    void on_sliderRebobinado_sliderMoved(int value);
+    void on_sliderRebobinado_sliderReleased();
+    void on_btnExplorar_clicked();
+    void on_btnPerfilOptimo_clicked();
 
     // Slot para actualización
     void actualizarJuego();
     void actualizarInterfaz();
+    void esperarAlternativas();
+    void esperarPrevision();
+    void esperarPerfilOptimo();
 
 private:
     Ui::MainWindow *ui;
 
-    // Componentes del juego
-    std::unique_ptr<Juego> juego;
+    // Componentes del juego. La física corre en el hilo de 'simulacion';
+    // la interfaz le manda órdenes y dibuja la última instantánea publicada.
+    std::unique_ptr<SimulacionConcurrente> simulacion;
     QTimer* timerJuego;
+    QTimer* timerAlternativas; // Espera los "¿y si...?" aunque el juego esté en pausa
+    QTimer* timerPrevision;    // Espera la simulación exacta de la previsión del nivel 1
+    QTimer* timerPerfil;       // Espera el perfil óptimo del nivel 2
+    std::unique_ptr<BibliotecaTrayectorias> bibliotecaTrayectorias;
+    QElapsedTimer relojFrame; // Tiempo real entre frames (controles de teclado)
+
+    // El timer solo marca los frames; la física avanza a paso fijo en su
+    // propio hilo según el tiempo real.
+    static constexpr int INTERVALO_FRAME_MS = 16;
+    static constexpr double FRECUENCIA_FISICA_HZ = 1000.0;
+    // Opciones de comboAceleracion, en el mismo orden
+    static constexpr double FACTORES_TIEMPO[] = {1.0, 10.0, 100.0, 1000.0};
+    // Archivo, junto al ejecutable, donde se guarda el programa óptimo del
+    // nivel 2 (se puede cargar con ProgramaEmpuje::cargar o con
+    // SimuladorLotes --programa)
+    static constexpr const char* ARCHIVO_PROGRAMA_OPTIMO = "programa_vostok.txt";
+    // Perfil óptimo del nivel 2: se busca fuera del hilo de la interfaz con
+    // un optimizador que se crea en el primer pedido y se reusa
+    struct PerfilOptimo {
+        ConfiguracionOptimizador config;
+        ResultadoOptimizacion resultado;
+        std::vector<PuntoTrayectoria> puntos; // Trayectoria del mejor programa
+    };
+    std::unique_ptr<OptimizadorVostok> optimizador;
+    std::future<PerfilOptimo> perfilEnCurso; // Válido mientras se busca
+
+    // Cuánto retrocede "Rebobinar" desde el mensaje de derrota
+    static constexpr double SEGUNDOS_REBOBINADO_DERROTA = 5.0;
 
     // Widget de visualización
     VisualizacionWidget* widgetVisualizacion;
@@ -63,11 +107,22 @@ private:
     bool nivel1Completado;
     bool nivel2Completado;
 
+    // Primer aviso de HAL que todavía no se mostró
+    std::uint64_t siguienteAvisoHAL;
+
     // Métodos auxiliares
+    const InstantaneaJuego& estadoJuego() const;
+    // Envía la orden y espera el estado que ya la incluye (unos pocos ms)
+    const InstantaneaJuego& ordenar(TipoComando tipo, double valor = 0.0);
     void inicializarJuego();
     void inicializarWidgetVisualizacion();
     void actualizarTelemetria();
     void actualizarEstadoLabel();
+    void actualizarAceleracion();
+    void actualizarRebobinado();
+    void actualizarAlternativas();
+    void mostrarPrevision();
+    void rebobinar(long paso);
     void agregarMensajeHAL(const QString& mensaje);
     void verificarEstadoJuego();
     void mostrarMensajeVictoria();
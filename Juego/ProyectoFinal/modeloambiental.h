@@ -0,0 +1,100 @@
+#ifndef MODELOAMBIENTAL_H
+#define MODELOAMBIENTAL_H
+
+#include <algorithm>
+#include <cmath>
+
+// Modelo único de atmósfera que usan todos los niveles, el lote SIMD y
+// SistemaFisica, para no evaluar exp() en cada paso. La gravedad de cada
+// cuerpo está en CuerpoCeleste.
+//
+// Densidad relativa: exp(-h / H) con H = 10 km hasta los 100 km. Se guarda
+// en una tabla constexpr de 1001 nodos (uno cada 100 m) y entre nodos se
+// multiplica por exp(-d / H), d < 100 m, con su serie de Taylor de grado 5.
+// Error relativo máximo:
+//   - nodos: unos pocos ulp del redondeo de la serie (< 2e-15)
+//   - serie: (d / H)^6 / 6! <= 0.01^6 / 720 < 1.4e-15
+// es decir, menos de 1e-14 respecto de std::exp en todo el rango.
+class ModeloAmbiental {
+public:
+    static constexpr double ALTURA_ESCALA = 10000.0;
+    static constexpr double ALTURA_ATMOSFERA = 100000.0;
+    static constexpr double PASO_TABLA = 100.0;
+    static constexpr int NODOS_TABLA = 1001;
+    static constexpr double INVERSO_PASO = 1.0 / PASO_TABLA;
+    static constexpr double INVERSO_ESCALA = 1.0 / ALTURA_ESCALA;
+
+    // Coeficientes de exp(-u) = sum(c_n * u^n), n = 0..GRADO_SERIE
+    static constexpr int GRADO_SERIE = 5;
+    static constexpr double SERIE[GRADO_SERIE + 1] = {
+        1.0, -1.0, 1.0 / 2.0, -1.0 / 6.0, 1.0 / 24.0, -1.0 / 120.0};
+
+    struct TablaDensidad {
+        double valores[NODOS_TABLA];
+
+        constexpr TablaDensidad();
+    };
+
+    // exp(-k / 100) para k = 0..1000 (8 KB, cabe en L1), generada al compilar
+    static const TablaDensidad TABLA_DENSIDAD;
+
+    // exp(-h / H). Para h < 0 (etapas intermedias de un integrador bajo el
+    // suelo) se usa std::exp; por encima de 100 km se satura.
+    static double factorDensidad(double altura) {
+        if (altura < 0.0) return std::exp(-altura * INVERSO_ESCALA);
+        altura = std::min(altura, ALTURA_ATMOSFERA);
+
+        const int k = static_cast<int>(altura * INVERSO_PASO);
+        const double u = (altura - k * PASO_TABLA) * INVERSO_ESCALA;
+        return TABLA_DENSIDAD.valores[k] * serieExpNegativa(u);
+    }
+
+    // Polinomio de la serie en forma de Horner; el lote SIMD repite el
+    // mismo orden de operaciones para dar resultados idénticos.
+    static double serieExpNegativa(double u) {
+        double p = SERIE[GRADO_SERIE];
+        for (int n = GRADO_SERIE - 1; n >= 0; --n) {
+            p = p * u + SERIE[n];
+        }
+        return p;
+    }
+
+private:
+    // exp(-x) = 1 / exp(x) en tiempo de compilación. La serie de exp(x)
+    // con x >= 0 solo suma términos positivos, así que no hay cancelación.
+    // Solo se usa para generar la tabla.
+    static constexpr double expNegativaConstante(double x) {
+        double termino = 1.0;
+        double suma = 1.0;
+        for (int n = 1; n < 60 && termino > suma * 1e-18; ++n) {
+            termino *= x / n;
+            suma += termino;
+        }
+        return 1.0 / suma;
+    }
+};
+
+constexpr ModeloAmbiental::TablaDensidad::TablaDensidad() : valores() {
+    // exp(-k / 100) = exp(-entero) * exp(-fraccion / 100): solo 111 series
+    // en lugar de 1001, para no agotar el límite de pasos constexpr de los
+    // compiladores.
+    const int POR_UNIDAD = static_cast<int>(ALTURA_ESCALA / PASO_TABLA);
+    const int UNIDADES = (NODOS_TABLA - 1) / POR_UNIDAD + 1;
+
+    double enteros[UNIDADES] = {};
+    double fracciones[POR_UNIDAD] = {};
+    for (int a = 0; a < UNIDADES; ++a) {
+        enteros[a] = expNegativaConstante(a);
+    }
+    for (int b = 0; b < POR_UNIDAD; ++b) {
+        fracciones[b] = expNegativaConstante(static_cast<double>(b) / POR_UNIDAD);
+    }
+
+    for (int k = 0; k < NODOS_TABLA; ++k) {
+        valores[k] = enteros[k / POR_UNIDAD] * fracciones[k % POR_UNIDAD];
+    }
+}
+
+inline constexpr ModeloAmbiental::TablaDensidad ModeloAmbiental::TABLA_DENSIDAD{};
+
+#endif // MODELOAMBIENTAL_H
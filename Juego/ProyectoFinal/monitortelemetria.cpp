@@ -0,0 +1,98 @@
+#include "monitortelemetria.h"
+#include <algorithm>
+#include <cmath>
+
+MonitorTelemetria::MonitorTelemetria()
+    : varianzaArrastre(0.0),
+    observado(0.0),
+    hayConsumo(false),
+    hayArrastre(false),
+    alfa(0.0),
+    pasoAlfa(0.0) {
+}
+
+void MonitorTelemetria::reiniciar() {
+    resumen = ResumenTelemetria();
+    varianzaArrastre = 0.0;
+    observado = 0.0;
+    hayConsumo = false;
+    hayArrastre = false;
+}
+
+void MonitorTelemetria::observar(const LecturaTelemetria& lectura) {
+    if (lectura.paso <= 0.0) return;
+
+    // El paso casi nunca cambia: la exponencial se calcula una vez
+    if (lectura.paso != pasoAlfa) {
+        alfa = 1.0 - std::exp(-lectura.paso / CONSTANTE_TIEMPO);
+        pasoAlfa = lectura.paso;
+    }
+
+    // Consumo y aceleración: la primera lectura da el valor inicial de las medias
+    if (!hayConsumo) {
+        resumen.aceleracion = lectura.aceleracion;
+        resumen.consumo = lectura.consumo;
+        resumen.consumoEsperado = lectura.consumoEsperado;
+        hayConsumo = true;
+    } else {
+        resumen.aceleracion += alfa * (lectura.aceleracion - resumen.aceleracion);
+        resumen.consumo += alfa * (lectura.consumo - resumen.consumo);
+        resumen.consumoEsperado += alfa * (lectura.consumoEsperado - resumen.consumoEsperado);
+    }
+
+    resumen.segundosHastaVacio = resumen.consumo > CONSUMO_MINIMO
+        ? lectura.combustible / resumen.consumo
+        : std::numeric_limits<double>::infinity();
+
+    const bool juzgar = observado >= CALENTAMIENTO;
+
+    // Las dos medias se arrastran igual, así que con el consumo normal la
+    // diferencia es cero aunque el empuje cambie
+    const double exceso = resumen.consumo - resumen.consumoEsperado;
+    if (juzgar && exceso > std::max(EXCESO_MINIMO, TOLERANCIA_CONSUMO * resumen.consumoEsperado)) {
+        detectar(AnomaliaTelemetria::ConsumoExcesivo, lectura.tiempo, exceso);
+    }
+
+    if (!lectura.continuo) return;
+
+    // Frenado que no explican empuje ni gravedad: en la atmósfera es el
+    // arrastre; fuera debería ser cero
+    const double arrastre = lectura.propulsion - lectura.aceleracion;
+    if (!hayArrastre) {
+        resumen.arrastre = arrastre;
+        hayArrastre = true;
+        return;
+    }
+
+    const double desvio = arrastre - resumen.arrastre;
+    if (juzgar) {
+        const double limite = DESVIOS_ANOMALIA * std::sqrt(varianzaArrastre);
+        if (std::abs(desvio) * lectura.paso > SALTO_MINIMO && std::abs(desvio) > limite) {
+            detectar(AnomaliaTelemetria::SaltoVelocidad, lectura.tiempo, -desvio * lectura.paso);
+        } else if (lectura.enAtmosfera && desvio > std::max(limite, PICO_MINIMO)) {
+            detectar(AnomaliaTelemetria::PicoArrastre, lectura.tiempo, desvio);
+        }
+    }
+
+    resumen.arrastre += alfa * desvio;
+    varianzaArrastre = (1.0 - alfa) * (varianzaArrastre + alfa * desvio * desvio);
+    observado += lectura.paso;
+}
+
+void MonitorTelemetria::detectar(AnomaliaTelemetria anomalia, double tiempo, double magnitud) {
+    resumen.anomalia = anomalia;
+    resumen.tiempoAnomalia = tiempo;
+    resumen.magnitudAnomalia = magnitud;
+}
+
+const ResumenTelemetria& MonitorTelemetria::obtenerResumen() const {
+    return resumen;
+}
+
+AnomaliaTelemetria MonitorTelemetria::anomaliaVigente(const ResumenTelemetria& resumen, double tiempo) {
+    if (resumen.anomalia == AnomaliaTelemetria::Ninguna ||
+        tiempo - resumen.tiempoAnomalia >= VIGENCIA) {
+        return AnomaliaTelemetria::Ninguna;
+    }
+    return resumen.anomalia;
+}
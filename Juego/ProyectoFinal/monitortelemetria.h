@@ -0,0 +1,84 @@
+#ifndef MONITORTELEMETRIA_H
+#define MONITORTELEMETRIA_H
+
+#include <cstdint>
+#include <limits>
+
+enum class AnomaliaTelemetria : std::uint8_t {
+    Ninguna,
+    ConsumoExcesivo, // El combustible baja más rápido de lo que pide el empuje
+    PicoArrastre,    // El aire frena mucho más que en los últimos segundos
+    SaltoVelocidad   // La velocidad cambió en un paso sin que nada lo explique
+};
+
+// Lo que se mide en un paso de física
+struct LecturaTelemetria {
+    double tiempo = 0.0;          // s simulados al final del paso
+    double paso = 0.0;            // s
+    double aceleracion = 0.0;     // m/s² medida por diferencias (Cohete::obtenerAceleracion)
+    double propulsion = 0.0;      // m/s² que explican el empuje y la gravedad
+    double consumo = 0.0;         // kg/s medidos
+    double consumoEsperado = 0.0; // kg/s según el empuje y el nivel
+    double combustible = 0.0;     // kg al final del paso
+    bool enAtmosfera = false;
+    // Falso si en el paso hubo un corte que la aceleración no puede seguir
+    // (se agotó el combustible a mitad del paso)
+    bool continuo = true;
+};
+
+// Lo que el monitor sabe del vuelo en un instante. Es chico y va por valor
+// en las muestras de HAL y en el estado de la partida.
+struct ResumenTelemetria {
+    double aceleracion = 0.0;      // m/s², media móvil
+    double consumo = 0.0;          // kg/s, media móvil
+    double consumoEsperado = 0.0;  // kg/s, media móvil
+    double arrastre = 0.0;         // m/s² de frenado que no explican empuje ni gravedad
+    double segundosHastaVacio = std::numeric_limits<double>::infinity(); // Al consumo medio
+
+    AnomaliaTelemetria anomalia = AnomaliaTelemetria::Ninguna; // La última detectada
+    double tiempoAnomalia = 0.0;
+    double magnitudAnomalia = 0.0; // kg/s de más, m/s² de más o m/s del salto
+};
+
+// Estadísticas del vuelo en línea: medias móviles exponenciales con memoria
+// de CONSTANTE_TIEMPO segundos, así que cada paso cuesta lo mismo y la
+// memoria no crece. El arrastre es el residuo entre la aceleración que
+// explican empuje y gravedad y la medida; contra su media y su varianza se
+// buscan los picos y los saltos de velocidad. No usa memoria dinámica: se
+// copia tal cual con el resto de la partida.
+class MonitorTelemetria {
+public:
+    static constexpr double CONSTANTE_TIEMPO = 2.0;    // s
+    static constexpr double CALENTAMIENTO = 1.0;       // s observados antes de juzgar
+    static constexpr double TOLERANCIA_CONSUMO = 0.05; // Fracción del consumo esperado
+    static constexpr double EXCESO_MINIMO = 0.5;       // kg/s
+    static constexpr double DESVIOS_ANOMALIA = 6.0;    // Desvíos estándar del residuo
+    static constexpr double PICO_MINIMO = 0.5;         // m/s² sobre el arrastre medio
+    static constexpr double SALTO_MINIMO = 2.0;        // m/s en un paso
+    static constexpr double CONSUMO_MINIMO = 1e-3;     // kg/s: por debajo no se proyecta
+    static constexpr double VIGENCIA = 5.0;            // s que una anomalía sigue vigente
+
+private:
+    ResumenTelemetria resumen;
+    double varianzaArrastre;
+    double observado;     // s con arrastre medido desde reiniciar()
+    bool hayConsumo;      // Ya hay medias de consumo
+    bool hayArrastre;     // Ya hay media de arrastre
+    double alfa;          // Peso de cada lectura para pasoAlfa
+    double pasoAlfa;
+
+    void detectar(AnomaliaTelemetria anomalia, double tiempo, double magnitud);
+
+public:
+    MonitorTelemetria();
+
+    void reiniciar();
+    void observar(const LecturaTelemetria& lectura);
+
+    const ResumenTelemetria& obtenerResumen() const;
+    // La última anomalía de 'resumen' si se detectó hace menos de VIGENCIA
+    // segundos
+    static AnomaliaTelemetria anomaliaVigente(const ResumenTelemetria& resumen, double tiempo);
+};
+
+#endif // MONITORTELEMETRIA_H
@@ -1,10 +1,12 @@
-#include "Nivel.h"
+#include "nivel.h"
 
 Nivel::Nivel(const std::string& nom, double altObj, double velMax,
              double velMinAterrizaje, double grav, double resist)
     : nombre(nom), alturaObjetivo(altObj), velocidadMaxima(velMax),
     velocidadMinimaAterrizaje(velMinAterrizaje),
-    gravedadLocal(grav), resistenciaAire(resist) {
+    gravedadLocal(grav), resistenciaAire(resist),
+    integrador(TipoIntegrador::Euler), toleranciaIntegrador(1e-6),
+    pasoAdaptativo(0.0), pasosUltimaIntegracion(0) {
 }
 
 Nivel::~Nivel() {
@@ -33,3 +35,69 @@ double Nivel::obtenerVelocidadMaxima() const {
 double Nivel::obtenerVelocidadMinimaAterrizaje() const {
     return velocidadMinimaAterrizaje;
 }
+
+void Nivel::establecerResistenciaAire(double resistencia) {
+    resistenciaAire = std::max(0.0, resistencia);
+}
+
+void Nivel::establecerIntegrador(TipoIntegrador tipo, double tolerancia) {
+    integrador = tipo;
+    toleranciaIntegrador = tolerancia > 0.0 ? tolerancia : 1e-6;
+    pasoAdaptativo = 0.0;
+}
+
+TipoIntegrador Nivel::obtenerIntegrador() const {
+    return integrador;
+}
+
+int Nivel::obtenerPasosUltimaIntegracion() const {
+    return pasosUltimaIntegracion;
+}
+
+const std::vector<EventoFisica>& Nivel::obtenerEventosPaso() const {
+    return eventos;
+}
+
+EstadoNivel Nivel::capturarEstado() const {
+    EstadoNivel estado;
+    estado.pasoAdaptativo = pasoAdaptativo;
+    return estado;
+}
+
+void Nivel::restaurarEstado(const EstadoNivel& estado) {
+    pasoAdaptativo = estado.pasoAdaptativo;
+    eventos.clear();
+}
+
+const EventoFisica* Nivel::buscarEvento(TipoEvento tipo) const {
+    for (const EventoFisica& evento : eventos) {
+        if (evento.tipo == tipo) return &evento;
+    }
+    return nullptr;
+}
+
+void Nivel::resolverContactoSuelo(Cohete* cohete) const {
+    if (cohete->obtenerAltura() > 0.0) return;
+
+    // Sin cruce en este paso (apoyado desde antes) vale la velocidad final
+    const EventoFisica* contacto = buscarEvento(TipoEvento::Contacto);
+    cohete->resolverContactoSuelo(contacto ? contacto->estado.velocidad
+                                           : cohete->obtenerVelocidad());
+}
+
+bool Nivel::estaEnVueloLibre(const Cohete* cohete) {
+    const bool conEmpuje = cohete->tieneCombustible() && cohete->obtenerEmpuje() > 0.0;
+    return !conEmpuje && cohete->obtenerAltura() > 0.0;
+}
+
+void Nivel::aplicarTrayectoria(Cohete* cohete, const TrayectoriaBalistica& trayectoria,
+                               double duracion) {
+    // El salto termina antes de cualquier umbral: no hay eventos
+    eventos.clear();
+    const EstadoDinamico y = trayectoria.estadoEn(duracion);
+    cohete->aplicarEstadoIntegrado(y.altura, y.velocidad, y.combustible, duracion);
+}
+
+EstadoDinamico Nivel::leerEstado(const Cohete* cohete) {
+    return {cohete->obtenerAltura(), cohete->obtenerVelocidad(), cohete->obtenerCombustible()};
+}
@@ -1,8 +1,21 @@
 #ifndef NIVEL_H
 #define NIVEL_H
 
+#include <algorithm>
 #include <string>
-#include "Cohete.h"
+#include <vector>
+#include "cohete.h"
+#include "eventosfisica.h"
+#include "sistemafisica.h"
+#include "trayectoriabalistica.h"
+
+// Lo que cambia de un nivel durante la partida (el resto es configuración
+// fija). Es chico a propósito: se copia en cada punto de control.
+struct EstadoNivel {
+    double pasoAdaptativo = 0.0;
+    double tiempoTranscurrido = 0.0; // Solo nivel 3
+    bool enDescenso = false;         // Solo nivel 3
+};
 
 class Nivel {
 protected:
@@ -13,6 +26,54 @@ protected:
     double gravedadLocal;
     double resistenciaAire;
 
+    TipoIntegrador integrador;
+    double toleranciaIntegrador;
+    double pasoAdaptativo;          // Último paso aceptado por Dormand-Prince
+    int pasosUltimaIntegracion;
+
+    // Eventos del último paso, ordenados por instante
+    std::vector<EventoFisica> eventos;
+
+    // Avanza altura, velocidad y combustible con el integrador elegido y
+    // detecta los eventos del paso. 'derivada(y, empuje)' combina empuje,
+    // gravedad y resistencia del nivel.
+    template<class Derivada>
+    void integrarVertical(Cohete* cohete, const Derivada& derivada, double deltaTime);
+
+    // Avanza 'y' una duración partiendo el intervalo en el apagado del
+    // motor. Devuelve los pasos usados.
+    template<class Derivada>
+    int propagar(const Derivada& derivada, EstadoDinamico& y,
+                 double empuje, double duracion);
+
+    // Integra un tramo con empuje constante. Devuelve los pasos usados.
+    template<class Derivada>
+    int integrarTramo(const Derivada& derivada, EstadoDinamico& y,
+                      double empuje, double duracion);
+
+    // Busca dentro del paso y0 -> y1 (antes de apoyar el cohete en el suelo)
+    // los cruces de la altura objetivo, del suelo, de la velocidad máxima y
+    // el agotamiento del combustible. 'consumo' está en kg/s. Solo se ve un
+    // cruce por umbral y por paso.
+    template<class Interpolacion>
+    void detectarEventos(const EstadoDinamico& y0, const EstadoDinamico& y1,
+                         double deltaTime, double consumo,
+                         const Interpolacion& interpolacion);
+
+    const EventoFisica* buscarEvento(TipoEvento tipo) const;
+
+    // Apoya el cohete en el suelo usando la velocidad del instante exacto
+    // del contacto, no la del final del paso
+    void resolverContactoSuelo(Cohete* cohete) const;
+
+    static EstadoDinamico leerEstado(const Cohete* cohete);
+
+    // Sin empuje efectivo y en el aire: candidato a planeo balístico
+    static bool estaEnVueloLibre(const Cohete* cohete);
+    // Lleva el cohete al estado de 'trayectoria' tras 'duracion' segundos
+    void aplicarTrayectoria(Cohete* cohete, const TrayectoriaBalistica& trayectoria,
+                            double duracion);
+
 public:
     Nivel(const std::string& nom, double altObj, double velMax,
           double velMinAterrizaje, double grav, double resist);
@@ -26,10 +87,128 @@ public:
     double obtenerVelocidadMaxima() const;
     double obtenerVelocidadMinimaAterrizaje() const;
 
+    void establecerIntegrador(TipoIntegrador tipo, double tolerancia = 1e-6);
+    TipoIntegrador obtenerIntegrador() const;
+    // Para estudiar la sensibilidad al arrastre (valor de referencia en el constructor)
+    void establecerResistenciaAire(double resistencia);
+    int obtenerPasosUltimaIntegracion() const;
+    const std::vector<EventoFisica>& obtenerEventosPaso() const;
+
+    virtual EstadoNivel capturarEstado() const;
+    virtual void restaurarEstado(const EstadoNivel& estado);
+
     virtual bool verificarVictoria(Cohete* cohete) = 0;
     virtual void aplicarFisica(Cohete* cohete, double deltaTime) = 0;
     virtual std::string obtenerDescripcion() const = 0;
     virtual std::string obtenerObjetivo() const = 0;
 };
 
+template<class Derivada>
+void Nivel::integrarVertical(Cohete* cohete, const Derivada& derivada, double deltaTime) {
+    const EstadoDinamico inicio = leerEstado(cohete);
+    const double empuje = (inicio.combustible > 0.0) ? cohete->obtenerEmpuje() : 0.0;
+    const double consumo = (empuje > 0.0) ? -derivada(inicio, empuje).combustible : 0.0;
+
+    EstadoDinamico y = inicio;
+    pasosUltimaIntegracion = propagar(derivada, y, empuje, deltaTime);
+
+    // Buscar los cruces vuelve a integrar desde el inicio del paso; el paso
+    // sugerido de Dormand-Prince se restaura para no alterar los siguientes
+    const double pasoGuardado = pasoAdaptativo;
+    auto propagarDesdeInicio = [&](double duracion) {
+        EstadoDinamico parcial = inicio;
+        pasoAdaptativo = pasoGuardado;
+        propagar(derivada, parcial, empuje, duracion);
+        return parcial;
+    };
+    detectarEventos(inicio, y, deltaTime, consumo,
+                    InterpolacionIntegrada<decltype(propagarDesdeInicio)>(
+                        propagarDesdeInicio, inicio, y, deltaTime));
+    pasoAdaptativo = pasoGuardado;
+
+    cohete->aplicarEstadoIntegrado(y.altura, y.velocidad, y.combustible, deltaTime);
+}
+
+template<class Derivada>
+int Nivel::propagar(const Derivada& derivada, EstadoDinamico& y,
+                    double empuje, double duracion) {
+    // El apagado del motor es una discontinuidad: se parte el intervalo en
+    // el instante exacto en que se agota el combustible (el consumo es
+    // constante) para que ningún paso la atraviese y cada método conserve
+    // su orden.
+    double duracionConEmpuje = duracion;
+    if (empuje > 0.0) {
+        const double consumo = -derivada(y, empuje).combustible;
+        if (consumo > 0.0 && y.combustible < consumo * duracion) {
+            duracionConEmpuje = y.combustible / consumo;
+        }
+    }
+
+    int pasos = integrarTramo(derivada, y, empuje, duracionConEmpuje);
+
+    if (duracionConEmpuje < duracion) {
+        y.combustible = 0.0;
+        pasos += integrarTramo(derivada, y, 0.0, duracion - duracionConEmpuje);
+    }
+
+    return pasos;
+}
+
+template<class Derivada>
+int Nivel::integrarTramo(const Derivada& derivada, EstadoDinamico& y,
+                         double empuje, double duracion) {
+    if (duracion <= 0.0) return 0;
+
+    auto f = [&derivada, empuje](const EstadoDinamico& estado) {
+        return derivada(estado, empuje);
+    };
+
+    switch (integrador) {
+    case TipoIntegrador::RK4:
+        y = SistemaFisica::pasoRK4(f, y, duracion);
+        return 1;
+    case TipoIntegrador::VelocityVerlet:
+        y = SistemaFisica::pasoVelocityVerlet(f, y, duracion);
+        return 1;
+    case TipoIntegrador::DormandPrince:
+        return SistemaFisica::integrarDormandPrince(
+            f, y, duracion, toleranciaIntegrador, pasoAdaptativo);
+    case TipoIntegrador::Euler:
+    default:
+        y = SistemaFisica::pasoEuler(f, y, duracion);
+        return 1;
+    }
+}
+
+template<class Interpolacion>
+void Nivel::detectarEventos(const EstadoDinamico& y0, const EstadoDinamico& y1,
+                            double deltaTime, double consumo,
+                            const Interpolacion& interpolacion) {
+    eventos.clear();
+
+    auto agregar = [&](TipoEvento tipo, double fraccion) {
+        fraccion = std::clamp(fraccion, 0.0, 1.0);
+        const EventoFisica evento{tipo, fraccion * deltaTime, interpolacion.estado(fraccion)};
+        auto posicion = std::find_if(eventos.begin(), eventos.end(),
+                                     [&](const EventoFisica& e) { return e.instante > evento.instante; });
+        eventos.insert(posicion, evento);
+    };
+
+    if (y0.altura > 0.0 && y1.altura <= 0.0) {
+        agregar(TipoEvento::Contacto, interpolacion.cruce(&EstadoDinamico::altura, 0.0));
+    }
+    if (alturaObjetivo > 0.0 && y0.altura < alturaObjetivo && y1.altura >= alturaObjetivo) {
+        agregar(TipoEvento::AlturaObjetivo,
+                interpolacion.cruce(&EstadoDinamico::altura, alturaObjetivo));
+    }
+    if (y0.velocidad <= velocidadMaxima && y1.velocidad > velocidadMaxima) {
+        agregar(TipoEvento::LimiteVelocidad,
+                interpolacion.cruce(&EstadoDinamico::velocidad, velocidadMaxima));
+    }
+    // El consumo es constante mientras hay empuje: el instante es exacto
+    if (consumo > 0.0 && y0.combustible > 0.0 && y1.combustible <= 0.0) {
+        agregar(TipoEvento::SinCombustible, y0.combustible / consumo / deltaTime);
+    }
+}
+
 #endif // NIVEL_H
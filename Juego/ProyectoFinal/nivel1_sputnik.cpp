@@ -1,8 +1,10 @@
-#include "Nivel1_Sputnik.h"
+#include "nivel1_sputnik.h"
+#include <algorithm>
 #include <cmath>
+#include "modeloambiental.h"
 
 Nivel1_Sputnik::Nivel1_Sputnik()
-    : Nivel("Sputnik 1957", 100000.0, 8000.0, 0.0, 9.81, 0.5),
+    : Nivel("Sputnik 1957", 100000.0, 8000.0, 0.0, Cuerpo::GRAVEDAD_SUPERFICIE, 0.5),
     alturaOrbita(100000.0), velocidadCritica(8000.0) {
 }
 
@@ -16,35 +18,96 @@ bool Nivel1_Sputnik::verificarVictoria(Cohete* cohete) {
 }
 
 void Nivel1_Sputnik::aplicarFisica(Cohete* cohete, double deltaTime) {
+    if (integrador != TipoIntegrador::Euler) {
+        const double masaSeca = cohete->obtenerMasaSeca();
+        integrarVertical(cohete, [this, masaSeca](const EstadoDinamico& y, double empuje) {
+            return calcularDerivada(y, empuje, masaSeca);
+        }, deltaTime);
+
+        resolverContactoSuelo(cohete);
+        if (verificarQuemadura(cohete)) {
+            cohete->marcarDanado();
+        }
+        return;
+    }
+
+    const EstadoDinamico inicio = leerEstado(cohete);
+    double consumoPorSegundo = 0.0;
+
     if (cohete->obtenerCombustible() > 0 && cohete->obtenerEmpuje() > 0) {
         double aceleracion = cohete->obtenerEmpuje() / cohete->obtenerMasa();
         double nuevaVelocidad = cohete->obtenerVelocidad() + aceleracion * deltaTime;
         cohete->establecerVelocidad(nuevaVelocidad);
 
-        const double FACTOR_CONSUMO_SPUTNIK = 3000.0;
-        double consumo = (cohete->obtenerEmpuje() / FACTOR_CONSUMO_SPUTNIK) * deltaTime;
+        consumoPorSegundo = cohete->obtenerEmpuje() / FACTOR_CONSUMO_SPUTNIK;
+        double consumo = consumoPorSegundo * deltaTime;
         cohete->consumirCombustible(consumo);
     }
 
-    double radioTierra = 6371000.0;
-    double gravedadActual = gravedadLocal *
-                            std::pow(radioTierra / (radioTierra + cohete->obtenerAltura()), 2);
+    double gravedadActual = Cuerpo::gravedadRelativa(cohete->obtenerAltura());
 
     cohete->aplicarGravedad(gravedadActual, deltaTime);
 
-    if (cohete->obtenerAltura() < 100000.0) {
-        double factorDensidad = std::exp(-cohete->obtenerAltura() / 10000.0);
+    if (cohete->obtenerAltura() < ModeloAmbiental::ALTURA_ATMOSFERA) {
+        double factorDensidad = ModeloAmbiental::factorDensidad(cohete->obtenerAltura());
         double resistenciaActual = resistenciaAire * factorDensidad;
         cohete->aplicarResistenciaAire(resistenciaActual, deltaTime);
     }
 
     cohete->actualizarEstado(deltaTime);
 
+    const EstadoDinamico fin = leerEstado(cohete);
+    detectarEventos(inicio, fin, deltaTime, consumoPorSegundo, InterpolacionLineal(inicio, fin));
+    resolverContactoSuelo(cohete);
+
     if (verificarQuemadura(cohete)) {
         cohete->marcarDanado();
     }
 }
 
+EstadoDinamico Nivel1_Sputnik::calcularDerivada(const EstadoDinamico& y, double empuje,
+                                                double masaSeca) const {
+    // integrarVertical ya anula el empuje desde que se agota el combustible
+    const bool conEmpuje = empuje > 0.0;
+    const double masa = masaSeca + std::max(0.0, y.combustible);
+
+    double aceleracion = conEmpuje ? empuje / masa : 0.0;
+
+    aceleracion -= Cuerpo::gravedadRelativa(y.altura);
+
+    if (y.altura < ModeloAmbiental::ALTURA_ATMOSFERA) {
+        double resistenciaActual = resistenciaAire * ModeloAmbiental::factorDensidad(y.altura);
+        aceleracion -= resistenciaActual * y.velocidad * std::abs(y.velocidad) / masa;
+    }
+
+    return {y.velocidad, aceleracion,
+            conEmpuje ? -empuje / FACTOR_CONSUMO_SPUTNIK : 0.0};
+}
+
+TrayectoriaBalistica Nivel1_Sputnik::calcularTrayectoria(const Cohete* cohete) const {
+    return TrayectoriaBalistica::radial(Cuerpo::GRAVEDAD_SUPERFICIE, Cuerpo::RADIO,
+                                        leerEstado(cohete));
+}
+
+double Nivel1_Sputnik::calcularPlaneo(const Cohete* cohete) const {
+    // Solo fuera de la atmósfera: dentro hay resistencia
+    if (!estaEnVueloLibre(cohete) ||
+        cohete->obtenerAltura() < ModeloAmbiental::ALTURA_ATMOSFERA) {
+        return 0.0;
+    }
+
+    const TrayectoriaBalistica trayectoria = calcularTrayectoria(cohete);
+    if (!trayectoria.estaLigada()) return 0.0;
+
+    // Apogeo y reingreso a la atmósfera
+    return std::min(trayectoria.tiempoHastaVelocidad(0.0),
+                    trayectoria.tiempoHastaAltura(ModeloAmbiental::ALTURA_ATMOSFERA));
+}
+
+void Nivel1_Sputnik::aplicarPlaneo(Cohete* cohete, double duracion) {
+    aplicarTrayectoria(cohete, calcularTrayectoria(cohete), duracion);
+}
+
 std::string Nivel1_Sputnik::obtenerDescripcion() const {
     return "1957 - Lanzamiento del primer satelite artificial. "
            "Debes alcanzar una altura de 100 km sin que el satelite "
@@ -60,5 +123,9 @@ bool Nivel1_Sputnik::verificarQuemadura(Cohete* cohete) const {
         cohete->obtenerVelocidad() > velocidadCritica) {
         return true;
     }
-    return false;
+
+    // Superó la velocidad crítica durante el paso todavía dentro de la
+    // atmósfera, aunque al final del paso ya esté por encima
+    const EventoFisica* limite = buscarEvento(TipoEvento::LimiteVelocidad);
+    return limite && limite->estado.altura < 100000.0;
 }
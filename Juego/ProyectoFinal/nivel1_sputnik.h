@@ -1,14 +1,24 @@
 #ifndef NIVEL1_SPUTNIK_H
 #define NIVEL1_SPUTNIK_H
 
-#include "Nivel.h"
+#include "nivel.h"
 
-class Nivel1_Sputnik : public Nivel {
+class Nivel1_Sputnik final : public Nivel {
 private:
     double alturaOrbita;
     double velocidadCritica;
 
+    static constexpr double FACTOR_CONSUMO_SPUTNIK = 3000.0;
+
+    // dh/dt, dv/dt y dcombustible/dt con empuje, gravedad y resistencia
+    EstadoDinamico calcularDerivada(const EstadoDinamico& y, double empuje,
+                                    double masaSeca) const;
+
+    TrayectoriaBalistica calcularTrayectoria(const Cohete* cohete) const;
+
 public:
+    using Cuerpo = CuerpoCeleste<Tierra>;
+
     Nivel1_Sputnik();
 
     bool verificarVictoria(Cohete* cohete) override;
@@ -17,6 +27,17 @@ public:
     std::string obtenerObjetivo() const override;
 
     bool verificarQuemadura(Cohete* cohete) const;
+
+    // Planeo balístico: segundos que se pueden saltar en forma cerrada
+    // antes del próximo umbral del nivel (0 si el cohete no está planeando)
+    // y el salto en sí. Los usa Juego con el avance balístico activado.
+    double calcularPlaneo(const Cohete* cohete) const;
+    void aplicarPlaneo(Cohete* cohete, double duracion);
+
+    double obtenerVelocidadCritica() const { return velocidadCritica; }
+    double obtenerFactorConsumo() const { return FACTOR_CONSUMO_SPUTNIK; }
+    // La que usa aplicarFisica a esa altura
+    double obtenerGravedadEn(double altura) const { return Cuerpo::gravedadRelativa(altura); }
 };
 
 #endif // NIVEL1_SPUTNIK_H
@@ -1,12 +1,14 @@
 #include "nivel2_vostok.h"
+#include <algorithm>
 #include <cmath>
+#include "modeloambiental.h"
 
 Nivel2_Vostok::Nivel2_Vostok()
     : Nivel("Vostok 1 - 1961",
             200000.0,  // Reducido de 300km a 200km para hacerlo más jugable
             11000.0,   // Velocidad máxima reducida para más control
             0.0,
-            9.81,
+            Cuerpo::GRAVEDAD_SUPERFICIE,
             0.3),
     velocidadSeguraMin(2000.0),
     velocidadSeguraMax(8500.0)  // Reducido ligeramente para más desafío
@@ -14,40 +16,113 @@ Nivel2_Vostok::Nivel2_Vostok()
 }
 
 bool Nivel2_Vostok::verificarVictoria(Cohete* cohete) {
-    return (!cohete->estaDanado() &&
-            cohete->obtenerAltura() >= alturaObjetivo &&
+    if (cohete->estaDanado()) return false;
+
+    // La velocidad que cuenta es la del instante en que cruza la altura
+    // objetivo, no la del final del paso
+    const EventoFisica* objetivo = buscarEvento(TipoEvento::AlturaObjetivo);
+    if (objetivo &&
+        objetivo->estado.velocidad >= velocidadSeguraMin &&
+        objetivo->estado.velocidad <= velocidadSeguraMax) {
+        return true;
+    }
+
+    return (cohete->obtenerAltura() >= alturaObjetivo &&
             cohete->obtenerVelocidad() >= velocidadSeguraMin &&
             cohete->obtenerVelocidad() <= velocidadSeguraMax);
 }
 
 void Nivel2_Vostok::aplicarFisica(Cohete* cohete, double deltaTime) {
 
+    if (integrador != TipoIntegrador::Euler) {
+        const double masaSeca = cohete->obtenerMasaSeca();
+        integrarVertical(cohete, [this, masaSeca](const EstadoDinamico& y, double empuje) {
+            return calcularDerivada(y, empuje, masaSeca);
+        }, deltaTime);
+
+        resolverContactoSuelo(cohete);
+        if (cohete->obtenerVelocidad() > velocidadMaxima) {
+            cohete->marcarDanado();
+        }
+        return;
+    }
+
+    const EstadoDinamico inicio = leerEstado(cohete);
+    double consumoPorSegundo = 0.0;
+
     if (cohete->tieneCombustible() && cohete->obtenerEmpuje() > 0) {
         double a = cohete->obtenerEmpuje() / cohete->obtenerMasa();
         cohete->establecerVelocidad(cohete->obtenerVelocidad() + a * deltaTime);
 
-        const double FACTOR_CONSUMO_VOSTOK = 3000.0;
-        double consumo = (cohete->obtenerEmpuje() / FACTOR_CONSUMO_VOSTOK) * deltaTime;
+        consumoPorSegundo = cohete->obtenerEmpuje() / FACTOR_CONSUMO_VOSTOK;
+        double consumo = consumoPorSegundo * deltaTime;
         cohete->consumirCombustible(consumo);
     }
 
-    double R = 6371000.0;
-    double g = gravedadLocal * std::pow(R / (R + cohete->obtenerAltura()), 2);
+    double g = Cuerpo::gravedadRelativa(cohete->obtenerAltura());
     cohete->aplicarGravedad(g, deltaTime);
 
     if (cohete->estaEnAtmosfera()) {
-        double densidad = std::exp(-cohete->obtenerAltura() / 10000.0);
+        double densidad = ModeloAmbiental::factorDensidad(cohete->obtenerAltura());
         double k_actual = resistenciaAire * densidad;
         cohete->aplicarResistenciaAire(k_actual, deltaTime);
     }
 
     cohete->actualizarEstado(deltaTime);
 
+    const EstadoDinamico fin = leerEstado(cohete);
+    detectarEventos(inicio, fin, deltaTime, consumoPorSegundo, InterpolacionLineal(inicio, fin));
+    resolverContactoSuelo(cohete);
+
     if (cohete->obtenerVelocidad() > velocidadMaxima) {
         cohete->marcarDanado();
     }
 }
 
+EstadoDinamico Nivel2_Vostok::calcularDerivada(const EstadoDinamico& y, double empuje,
+                                               double masaSeca) const {
+    // integrarVertical ya anula el empuje desde que se agota el combustible
+    const bool conEmpuje = empuje > 0.0;
+    const double masa = masaSeca + std::max(0.0, y.combustible);
+
+    double a = conEmpuje ? empuje / masa : 0.0;
+
+    a -= Cuerpo::gravedadRelativa(y.altura);
+
+    if (y.altura < ModeloAmbiental::ALTURA_ATMOSFERA) {
+        double k_actual = resistenciaAire * ModeloAmbiental::factorDensidad(y.altura);
+        a -= k_actual * y.velocidad * std::abs(y.velocidad) / masa;
+    }
+
+    return {y.velocidad, a, conEmpuje ? -empuje / FACTOR_CONSUMO_VOSTOK : 0.0};
+}
+
+TrayectoriaBalistica Nivel2_Vostok::calcularTrayectoria(const Cohete* cohete) const {
+    return TrayectoriaBalistica::radial(Cuerpo::GRAVEDAD_SUPERFICIE, Cuerpo::RADIO,
+                                        leerEstado(cohete));
+}
+
+double Nivel2_Vostok::calcularPlaneo(const Cohete* cohete) const {
+    if (!estaEnVueloLibre(cohete) || cohete->estaEnAtmosfera()) {
+        return 0.0;
+    }
+
+    const TrayectoriaBalistica trayectoria = calcularTrayectoria(cohete);
+    if (!trayectoria.estaLigada()) return 0.0;
+
+    // Apogeo, reingreso, altura objetivo y bordes de la ventana de
+    // velocidad segura (la velocidad solo baja mientras planea)
+    return std::min({trayectoria.tiempoHastaVelocidad(0.0),
+                     trayectoria.tiempoHastaAltura(ModeloAmbiental::ALTURA_ATMOSFERA),
+                     trayectoria.tiempoHastaAltura(alturaObjetivo),
+                     trayectoria.tiempoHastaVelocidad(velocidadSeguraMax),
+                     trayectoria.tiempoHastaVelocidad(velocidadSeguraMin)});
+}
+
+void Nivel2_Vostok::aplicarPlaneo(Cohete* cohete, double duracion) {
+    aplicarTrayectoria(cohete, calcularTrayectoria(cohete), duracion);
+}
+
 std::string Nivel2_Vostok::obtenerDescripcion() const {
     return "1961 - Vostok 1: Manten una velocidad segura mientras asciendes "
            "hasta la orbita. Controla bien tu combustible.";
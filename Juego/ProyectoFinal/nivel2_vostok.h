@@ -1,14 +1,16 @@
 #ifndef NIVEL2_VOSTOK_H
 #define NIVEL2_VOSTOK_H
 
-#include "Nivel.h"
+#include "nivel.h"
 
-class Nivel2_Vostok : public Nivel {
+class Nivel2_Vostok final : public Nivel {
 private:
     double velocidadSeguraMin;
     double velocidadSeguraMax;
 
 public:
+    using Cuerpo = CuerpoCeleste<Tierra>;
+
     Nivel2_Vostok();
 
     bool verificarVictoria(Cohete* cohete) override;
@@ -16,8 +18,28 @@ public:
     std::string obtenerDescripcion() const override;
     std::string obtenerObjetivo() const override;
 
+    double obtenerFactorConsumo() const { return FACTOR_CONSUMO_VOSTOK; }
+    // La que usa aplicarFisica a esa altura
+    double obtenerGravedadEn(double altura) const { return Cuerpo::gravedadRelativa(altura); }
+    double obtenerVelocidadSeguraMin() const { return velocidadSeguraMin; }
+    double obtenerVelocidadSeguraMax() const { return velocidadSeguraMax; }
+
+    // Planeo balístico: segundos que se pueden saltar en forma cerrada
+    // antes del próximo umbral del nivel (0 si el cohete no está planeando)
+    // y el salto en sí. Los usa Juego con el avance balístico activado.
+    double calcularPlaneo(const Cohete* cohete) const;
+    void aplicarPlaneo(Cohete* cohete, double duracion);
+
 private:
+    static constexpr double FACTOR_CONSUMO_VOSTOK = 3000.0;
+
     bool fueraRangoVelocidadSegura(Cohete* cohete) const;
+
+    // dh/dt, dv/dt y dcombustible/dt con empuje, gravedad y resistencia
+    EstadoDinamico calcularDerivada(const EstadoDinamico& y, double empuje,
+                                    double masaSeca) const;
+
+    TrayectoriaBalistica calcularTrayectoria(const Cohete* cohete) const;
 };
 
 #endif
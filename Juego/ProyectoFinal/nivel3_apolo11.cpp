@@ -1,4 +1,5 @@
 #include "nivel3_apolo11.h"
+#include <algorithm>
 #include <cmath>
 
 Nivel3_Apolo11::Nivel3_Apolo11()
@@ -6,15 +7,17 @@ Nivel3_Apolo11::Nivel3_Apolo11()
             0.0,   // altura objetivo (tocando superficie)
             100.0, // velocidad máxima (no muy relevante aquí)
             0.0,   // velocidad mínima de aterrizaje (base)
-            1.62,
+            Cuerpo::GRAVEDAD_SUPERFICIE,
             0.0),
     velocidadAterrizajeMin(0.0),
     velocidadAterrizajeMax(5.0),
-    gravedadLunar(1.62),
     alturaSuperficie(0.0),
     enDescenso(false),
     alturaInicial(15000.0),
-    tiempoTranscurrido(0.0)
+    velocidadDescensoInicial(-50.0),
+    tiempoTranscurrido(0.0),
+    pasoFriccion(0.0),
+    factorFriccion(1.0)
 {
 }
 
@@ -54,30 +57,58 @@ void Nivel3_Apolo11::aplicarFisica(Cohete* cohete, double deltaTime) {
     if (!enDescenso) {
         cohete->establecerAltura(alturaInicial);
         // Dar velocidad inicial hacia abajo para que el descenso sea más rápido y jugable
-        cohete->establecerVelocidad(-50.0); // Velocidad inicial hacia abajo (m/s)
+        cohete->establecerVelocidadInicial(velocidadDescensoInicial); // Velocidad inicial hacia abajo (m/s)
         cohete->establecerPosicionX(0.0);  // Iniciar en el centro
         cohete->establecerVelocidadX(0.0);
         enDescenso = true;
     }
 
+    if (integrador != TipoIntegrador::Euler) {
+        aplicarFriccionHorizontal(cohete, deltaTime);
+
+        const double masaSeca = cohete->obtenerMasaSeca();
+        integrarVertical(cohete, [this, masaSeca](const EstadoDinamico& y, double empuje) {
+            return calcularDerivada(y, empuje, masaSeca);
+        }, deltaTime);
+
+        resolverContactoSuperficie(cohete);
+        return;
+    }
+
+    const EstadoDinamico inicio = leerEstado(cohete);
+    double consumoPorSegundo = 0.0;
+
     if (cohete->tieneCombustible() && cohete->obtenerEmpuje() > 0.0) {
         double aceleracion = cohete->obtenerEmpuje() / cohete->obtenerMasa();
         double nuevaVelocidad =
             cohete->obtenerVelocidad() + aceleracion * deltaTime;
         cohete->establecerVelocidad(nuevaVelocidad);
 
-        const double FACTOR_CONSUMO_APOLO = 4000.0;
-        double consumo = (cohete->obtenerEmpuje() / FACTOR_CONSUMO_APOLO) * deltaTime;
+        consumoPorSegundo = cohete->obtenerEmpuje() / FACTOR_CONSUMO_APOLO;
+        double consumo = consumoPorSegundo * deltaTime;
         cohete->consumirCombustible(consumo);
     }
 
-    cohete->aplicarGravedad(gravedadLunar, deltaTime);
+    cohete->aplicarGravedad(Cuerpo::GRAVEDAD_SUPERFICIE, deltaTime);
     
+    aplicarFriccionHorizontal(cohete, deltaTime);
+
+    cohete->actualizarEstado(deltaTime);
+
+    const EstadoDinamico fin = leerEstado(cohete);
+    detectarEventos(inicio, fin, deltaTime, consumoPorSegundo, InterpolacionLineal(inicio, fin));
+    resolverContactoSuperficie(cohete);
+}
+
+void Nivel3_Apolo11::aplicarFriccionHorizontal(Cohete* cohete, double deltaTime) {
     // Aplicar fricción a la velocidad horizontal (simular inercia en el espacio)
     double velocidadXActual = cohete->obtenerVelocidadX();
     if (std::abs(velocidadXActual) > 0.01) {
         // Reducir gradualmente la velocidad horizontal (95% cada segundo)
-        double factorFriccion = std::pow(0.95, deltaTime);
+        if (deltaTime != pasoFriccion) {
+            factorFriccion = std::pow(FRICCION_HORIZONTAL, deltaTime);
+            pasoFriccion = deltaTime;
+        }
         cohete->establecerVelocidadX(velocidadXActual * factorFriccion);
     } else {
         cohete->establecerVelocidadX(0.0);
@@ -92,11 +123,13 @@ void Nivel3_Apolo11::aplicarFisica(Cohete* cohete, double deltaTime) {
         cohete->establecerPosicionX(-1000.0);
         cohete->establecerVelocidadX(0.0);
     }
+}
 
-    cohete->actualizarEstado(deltaTime);
-
+void Nivel3_Apolo11::resolverContactoSuperficie(Cohete* cohete) {
     if (cohete->obtenerAltura() <= alturaSuperficie) {
-        double vImpacto = std::abs(cohete->obtenerVelocidad());
+        // Velocidad en el instante exacto del contacto
+        resolverContactoSuelo(cohete);
+        double vImpacto = std::abs(cohete->obtenerVelocidadImpacto());
 
         if (vImpacto < velocidadAterrizajeMin || vImpacto > velocidadAterrizajeMax) {
             cohete->marcarDanado();
@@ -107,6 +140,42 @@ void Nivel3_Apolo11::aplicarFisica(Cohete* cohete, double deltaTime) {
     }
 }
 
+EstadoDinamico Nivel3_Apolo11::calcularDerivada(const EstadoDinamico& y, double empuje,
+                                                double masaSeca) const {
+    // integrarVertical ya anula el empuje desde que se agota el combustible
+    const bool conEmpuje = empuje > 0.0;
+    const double masa = masaSeca + std::max(0.0, y.combustible);
+
+    double aceleracion = conEmpuje ? empuje / masa : 0.0;
+    aceleracion -= Cuerpo::GRAVEDAD_SUPERFICIE;
+
+    return {y.velocidad, aceleracion,
+            conEmpuje ? -empuje / FACTOR_CONSUMO_APOLO : 0.0};
+}
+
+TrayectoriaBalistica Nivel3_Apolo11::calcularTrayectoria(const Cohete* cohete) const {
+    return TrayectoriaBalistica::constante(Cuerpo::GRAVEDAD_SUPERFICIE, leerEstado(cohete));
+}
+
+double Nivel3_Apolo11::calcularPlaneo(const Cohete* cohete) const {
+    // Sin atmósfera basta con no tener empuje; el movimiento horizontal
+    // (con fricción) y la colocación inicial se siguen integrando
+    if (!enDescenso || !estaEnVueloLibre(cohete) || cohete->obtenerVelocidadX() != 0.0) {
+        return 0.0;
+    }
+
+    const TrayectoriaBalistica trayectoria = calcularTrayectoria(cohete);
+
+    // Apogeo y franja de alunizaje de verificarVictoria
+    return std::min(trayectoria.tiempoHastaVelocidad(0.0),
+                    trayectoria.tiempoHastaAltura(alturaSuperficie + 1.0));
+}
+
+void Nivel3_Apolo11::aplicarPlaneo(Cohete* cohete, double duracion) {
+    tiempoTranscurrido += duracion;
+    aplicarTrayectoria(cohete, calcularTrayectoria(cohete), duracion);
+}
+
 std::string Nivel3_Apolo11::obtenerDescripcion() const {
     return "1969 - Alunizaje del Apolo 11. Controla el descenso sin atmósfera "
            "y usa el empuje para aterrizar suavemente.";
@@ -130,6 +199,19 @@ void Nivel3_Apolo11::iniciarDescenso() {
     tiempoTranscurrido = 0.0;
 }
 
+EstadoNivel Nivel3_Apolo11::capturarEstado() const {
+    EstadoNivel estado = Nivel::capturarEstado();
+    estado.tiempoTranscurrido = tiempoTranscurrido;
+    estado.enDescenso = enDescenso;
+    return estado;
+}
+
+void Nivel3_Apolo11::restaurarEstado(const EstadoNivel& estado) {
+    Nivel::restaurarEstado(estado);
+    tiempoTranscurrido = estado.tiempoTranscurrido;
+    enDescenso = estado.enDescenso;
+}
+
 std::string Nivel3_Apolo11::obtenerFaseDescenso(Cohete* cohete) const {
     double h = cohete->obtenerAltura();
 
@@ -140,7 +222,7 @@ std::string Nivel3_Apolo11::obtenerFaseDescenso(Cohete* cohete) const {
 }
 
 double Nivel3_Apolo11::obtenerVelocidadIdeal(double altura) const {
-    return -std::sqrt(2.0 * gravedadLunar * altura);
+    return -std::sqrt(2.0 * Cuerpo::GRAVEDAD_SUPERFICIE * altura);
 }
 
 bool Nivel3_Apolo11::verificarAterrizajeEnZona(const Cohete* cohete) const {
@@ -148,8 +230,7 @@ bool Nivel3_Apolo11::verificarAterrizajeEnZona(const Cohete* cohete) const {
     // En coordenadas del cohete (metros), asumiendo que el ancho total es 2000m
     // El cohete tiene aproximadamente 10-15 metros de ancho, así que hacemos la zona de 50m (muy pequeña)
     double posicionX = cohete->obtenerPosicionX();
-    double rangoAterrizaje = 25.0;  // Solo 25 metros a cada lado del centro (50m total, muy pequeño)
-    
-    return (posicionX >= -rangoAterrizaje && posicionX <= rangoAterrizaje);
+    // Solo 25 metros a cada lado del centro (50m total, muy pequeño)
+    return (posicionX >= -RANGO_ATERRIZAJE && posicionX <= RANGO_ATERRIZAJE);
 }
 
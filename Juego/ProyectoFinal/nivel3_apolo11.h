@@ -1,19 +1,39 @@
 #ifndef NIVEL3_APOLO11_H
 #define NIVEL3_APOLO11_H
 
-#include "Nivel.h"
+#include "nivel.h"
 
-class Nivel3_Apolo11 : public Nivel {
+class Nivel3_Apolo11 final : public Nivel {
 private:
     double velocidadAterrizajeMin;
     double velocidadAterrizajeMax;
-    double gravedadLunar;
     double alturaSuperficie;
     bool   enDescenso;
     double alturaInicial;
+    double velocidadDescensoInicial; // Vertical al empezar el descenso (negativa)
     double tiempoTranscurrido;
 
+    // 0.95^dt se recalcula solo cuando cambia el paso de física
+    double pasoFriccion;
+    double factorFriccion;
+
+    static constexpr double FACTOR_CONSUMO_APOLO = 4000.0;
+
+    void aplicarFriccionHorizontal(Cohete* cohete, double deltaTime);
+    void resolverContactoSuperficie(Cohete* cohete);
+
+    // dh/dt, dv/dt y dcombustible/dt con empuje y gravedad lunar
+    EstadoDinamico calcularDerivada(const EstadoDinamico& y, double empuje,
+                                    double masaSeca) const;
+
+    TrayectoriaBalistica calcularTrayectoria(const Cohete* cohete) const;
+
 public:
+    using Cuerpo = CuerpoCeleste<Luna>;
+
+    static constexpr double FRICCION_HORIZONTAL = 0.95; // Fracción de velocidad X que queda tras 1 s
+    static constexpr double RANGO_ATERRIZAJE = 25.0;    // Semiancho de la zona de alunizaje (m)
+
     Nivel3_Apolo11();
 
     bool verificarVictoria(Cohete* cohete) override;
@@ -22,15 +42,30 @@ public:
     std::string obtenerObjetivo() const override;
 
     bool verificarAterrizaje(Cohete* cohete) const;
+
+    EstadoNivel capturarEstado() const override;
+    void restaurarEstado(const EstadoNivel& estado) override;
+
+    // Planeo balístico: segundos que se pueden saltar en forma cerrada
+    // antes del próximo umbral del nivel (0 si el cohete no está planeando)
+    // y el salto en sí. Los usa Juego con el avance balístico activado.
+    double calcularPlaneo(const Cohete* cohete) const;
+    void aplicarPlaneo(Cohete* cohete, double duracion);
     void iniciarDescenso();
 
     double obtenerAlturaInicial() const { return alturaInicial; }
+    double obtenerVelocidadDescensoInicial() const { return velocidadDescensoInicial; }
+    // Se toma en el primer paso de física, así que vale antes de empezar
+    void establecerVelocidadDescensoInicial(double velocidad) { velocidadDescensoInicial = velocidad; }
     double obtenerTiempoTranscurrido() const { return tiempoTranscurrido; }
     std::string obtenerFaseDescenso(Cohete* cohete) const;
     double obtenerVelocidadIdeal(double altura) const;
 
     double obtenerVelocidadAterrizajeMin() const { return velocidadAterrizajeMin; }
     double obtenerVelocidadAterrizajeMax() const { return velocidadAterrizajeMax; }
+    double obtenerFactorConsumo() const { return FACTOR_CONSUMO_APOLO; }
+    // La que usa aplicarFisica: constante en todo el descenso
+    double obtenerGravedadEn(double) const { return Cuerpo::GRAVEDAD_SUPERFICIE; }
     
     // Verificar si el cohete aterrizó en la zona correcta (centro)
     bool verificarAterrizajeEnZona(const Cohete* cohete) const;
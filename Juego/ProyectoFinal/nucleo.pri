@@ -0,0 +1,84 @@
+# Núcleo de simulación sin dependencias de Qt.
+# Lo comparten la interfaz (ProyectoFinal), la biblioteca estática
+# (NucleoSimulacion) y el simulador por lotes (SimuladorLotes).
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+# Los kernels de CoheteBatch usan SSE2 en x86-64. Con "CONFIG+=simd_avx2"
+# se compilan para AVX2 (4 cohetes por instrucción en lugar de 2).
+simd_avx2 {
+    msvc: QMAKE_CXXFLAGS += /arch:AVX2
+    else: QMAKE_CXXFLAGS += -mavx2
+}
+
+SOURCES += \
+    $$PWD/agentehal69.cpp \
+    $$PWD/anticipadorhal.cpp \
+    $$PWD/archivomapeado.cpp \
+    $$PWD/avisoshal.cpp \
+    $$PWD/bibliotecatrayectorias.cpp \
+    $$PWD/cohete.cpp \
+    $$PWD/cohetebatch.cpp \
+    $$PWD/ejecutorlotes.cpp \
+    $$PWD/evaluadorrobustez.cpp \
+    $$PWD/exploradoralternativas.cpp \
+    $$PWD/grupohilos.cpp \
+    $$PWD/juego.cpp \
+    $$PWD/monitortelemetria.cpp \
+    $$PWD/nivel.cpp \
+    $$PWD/nivel1_sputnik.cpp \
+    $$PWD/nivel2_vostok.cpp \
+    $$PWD/nivel3_apolo11.cpp \
+    $$PWD/optimizadorvostok.cpp \
+    $$PWD/pilotoalunizaje.cpp \
+    $$PWD/predictortrayectoria.cpp \
+    $$PWD/programaempuje.cpp \
+    $$PWD/rebobinador.cpp \
+    $$PWD/reglashal.cpp \
+    $$PWD/sensorescohete.cpp \
+    $$PWD/simulacionconcurrente.cpp \
+    $$PWD/sistemafisica.cpp \
+    $$PWD/tablaalunizaje.cpp \
+    $$PWD/trabajadorhal.cpp \
+    $$PWD/trayectoriabalistica.cpp
+
+HEADERS += \
+    $$PWD/agentehal69.h \
+    $$PWD/anticipadorhal.h \
+    $$PWD/archivomapeado.h \
+    $$PWD/avisoshal.h \
+    $$PWD/bibliotecatrayectorias.h \
+    $$PWD/buffercircular.h \
+    $$PWD/buffertriple.h \
+    $$PWD/cohete.h \
+    $$PWD/cohetebatch.h \
+    $$PWD/colaspsc.h \
+    $$PWD/cuerpoceleste.h \
+    $$PWD/ejecutorlotes.h \
+    $$PWD/estadojuego.h \
+    $$PWD/evaluadorrobustez.h \
+    $$PWD/eventosfisica.h \
+    $$PWD/exploradoralternativas.h \
+    $$PWD/filtrokalman.h \
+    $$PWD/generadorsplitmix.h \
+    $$PWD/grupohilos.h \
+    $$PWD/juego.h \
+    $$PWD/modeloambiental.h \
+    $$PWD/monitortelemetria.h \
+    $$PWD/nivel.h \
+    $$PWD/nivel1_sputnik.h \
+    $$PWD/nivel2_vostok.h \
+    $$PWD/nivel3_apolo11.h \
+    $$PWD/optimizadorvostok.h \
+    $$PWD/pilotoalunizaje.h \
+    $$PWD/predictortrayectoria.h \
+    $$PWD/programaempuje.h \
+    $$PWD/rebobinador.h \
+    $$PWD/reglashal.h \
+    $$PWD/sensorescohete.h \
+    $$PWD/simulacionconcurrente.h \
+    $$PWD/sistemafisica.h \
+    $$PWD/tablaalunizaje.h \
+    $$PWD/trabajadorhal.h \
+    $$PWD/trayectoriabalistica.h
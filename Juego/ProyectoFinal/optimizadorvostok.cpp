@@ -0,0 +1,196 @@
+#include "optimizadorvostok.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "cohete.h"
+#include "generadorsplitmix.h"
+#include "juego.h"
+#include "nivel2_vostok.h"
+
+namespace {
+
+// Costo base de un candidato que no gana: peor que gastar todo el tanque
+constexpr double COSTO_INFACTIBLE = 1e6;
+
+// Cuánto le faltó a una misión perdida, para que la búsqueda tenga hacia
+// dónde ir aunque ningún candidato gane todavía: energía específica que
+// faltaba para llegar a la altura objetivo con la velocidad mínima, o
+// exceso de velocidad sobre la máxima
+double calcularFaltante(const ResultadoMision& r) {
+    static const Nivel2_Vostok nivel;
+    const double g = Nivel2_Vostok::Cuerpo::GRAVEDAD_SUPERFICIE;
+    const double vMin = nivel.obtenerVelocidadSeguraMin();
+    const double vMax = nivel.obtenerVelocidadSeguraMax();
+
+    const double energia = 0.5 * r.velocidadFinal * std::abs(r.velocidadFinal) + g * r.alturaFinal;
+    const double necesaria = 0.5 * vMin * vMin + g * nivel.obtenerAlturaObjetivo();
+    return std::max(0.0, necesaria - energia) / 1000.0 + std::max(0.0, r.velocidadFinal - vMax);
+}
+
+} // namespace
+
+OptimizadorVostok::OptimizadorVostok(unsigned numeroHilos)
+    : grupo((numeroHilos == 0 ? GrupoHilos::hilosDisponibles() : numeroHilos) - 1) {
+}
+
+void OptimizadorVostok::decodificar(const std::vector<double>& genes,
+                                    const ConfiguracionOptimizador& config,
+                                    ProgramaEmpuje& programa) {
+    programa.limpiar(); // Conserva la capacidad: no reserva memoria
+    double inicio = 0.0;
+    for (int k = 0; k < config.tramos; ++k) {
+        const double duracion = genes[2 * k] * config.duracionMaximaTramo;
+        if (duracion <= 0.0) continue;
+        programa.agregarTramo(inicio, genes[2 * k + 1] * config.empujeMaximo);
+        inicio += duracion;
+    }
+    programa.agregarTramo(inicio, 0.0);
+}
+
+Mision OptimizadorVostok::crearMision(const ConfiguracionOptimizador& config,
+                                      const ProgramaEmpuje& programa) {
+    Mision mision;
+    mision.nivel = 2;
+    mision.velocidadInicial = config.velocidadInicial;
+    mision.combustibleInicial = config.combustibleInicial;
+    mision.pasoFisica = config.pasoFisica;
+    mision.programa = programa;
+    return mision;
+}
+
+ResultadoOptimizacion OptimizadorVostok::optimizar(const ConfiguracionOptimizador& config) {
+    const std::size_t dimension = 2 * static_cast<std::size_t>(config.tramos);
+    const std::size_t n = std::max<std::size_t>(config.poblacion, 4);
+    const double combustibleInicial = std::min(
+        config.combustibleInicial >= 0.0 ? config.combustibleInicial : Cohete().obtenerCombustibleMaximo(),
+        Cohete().obtenerCombustibleMaximo());
+
+    GeneradorSplitMix generador(config.semilla);
+
+    std::vector<std::vector<double>> poblacion(n, std::vector<double>(dimension));
+    std::vector<std::vector<double>> pruebas(n, std::vector<double>(dimension));
+    std::vector<double> costos(n);
+    std::vector<double> costosPrueba(n);
+
+    for (std::vector<double>& individuo : poblacion) {
+        for (double& gen : individuo) gen = generador.uniforme();
+    }
+
+    // Cada hilo reutiliza su Juego y su misión: después de la primera
+    // evaluación la simulación ya no reserva memoria (copiar 'base', con
+    // el programa vacío, conserva la capacidad del programa anterior)
+    const Mision base = crearMision(config, ProgramaEmpuje());
+    auto evaluar = [&](const std::vector<std::vector<double>>& candidatos,
+                       std::vector<double>& destino) {
+        grupo.paraCada(candidatos.size(), [&](std::size_t i) {
+            thread_local Juego juego;
+            thread_local Mision mision;
+            juego.establecerModoSilencioso(true);
+            mision = base;
+            decodificar(candidatos[i], config, mision.programa);
+
+            const ResultadoMision r = EjecutorLotes::ejecutarMision(juego, mision);
+            destino[i] = r.victoria ? combustibleInicial - r.combustibleRestante
+                                    : COSTO_INFACTIBLE + calcularFaltante(r);
+        });
+    };
+
+    ResultadoOptimizacion resultado;
+    evaluar(poblacion, costos);
+    resultado.evaluaciones = n;
+
+    std::size_t mejor = std::min_element(costos.begin(), costos.end()) - costos.begin();
+    int sinMejora = 0;
+
+    int generacion = 0;
+    while (generacion < config.generacionesMaximas && sinMejora < config.generacionesSinMejora) {
+        ++generacion;
+
+        // DE/rand/1/bin
+        for (std::size_t i = 0; i < n; ++i) {
+            std::size_t a, b, c;
+            do { a = generador.entero(n); } while (a == i);
+            do { b = generador.entero(n); } while (b == i || b == a);
+            do { c = generador.entero(n); } while (c == i || c == a || c == b);
+            const std::size_t forzado = generador.entero(dimension);
+
+            for (std::size_t d = 0; d < dimension; ++d) {
+                if (d == forzado || generador.uniforme() < config.probabilidadCruce) {
+                    const double valor = poblacion[a][d] +
+                                         config.factorDiferencial * (poblacion[b][d] - poblacion[c][d]);
+                    pruebas[i][d] = std::clamp(valor, 0.0, 1.0);
+                } else {
+                    pruebas[i][d] = poblacion[i][d];
+                }
+            }
+        }
+
+        evaluar(pruebas, costosPrueba);
+        resultado.evaluaciones += n;
+
+        const double costoAnterior = costos[mejor];
+        for (std::size_t i = 0; i < n; ++i) {
+            if (costosPrueba[i] <= costos[i]) {
+                std::swap(poblacion[i], pruebas[i]);
+                costos[i] = costosPrueba[i];
+            }
+        }
+        mejor = std::min_element(costos.begin(), costos.end()) - costos.begin();
+
+        // Mejoras por debajo de un gramo no cuentan
+        sinMejora = (costos[mejor] < costoAnterior - 1e-3) ? 0 : sinMejora + 1;
+    }
+
+    decodificar(poblacion[mejor], config, resultado.programa);
+    resultado.generaciones = generacion;
+    resultado.factible = costos[mejor] < COSTO_INFACTIBLE;
+    // Sin solución factible queda el candidato que estuvo más cerca
+
+    Juego juego;
+    juego.establecerModoSilencioso(true);
+    resultado.mision = EjecutorLotes::ejecutarMision(juego, crearMision(config, resultado.programa));
+    resultado.combustibleUsado = combustibleInicial - resultado.mision.combustibleRestante;
+    return resultado;
+}
+
+std::vector<PuntoTrayectoria> OptimizadorVostok::muestrear(const Mision& mision, double intervalo) {
+    Juego juego;
+    juego.establecerModoSilencioso(true);
+    EjecutorLotes::prepararMision(juego, mision);
+
+    std::vector<PuntoTrayectoria> puntos;
+    auto guardar = [&]() {
+        const Cohete* cohete = juego.obtenerCohete();
+        puntos.push_back({juego.obtenerTiempoSimulacion(), cohete->obtenerAltura(),
+                          cohete->obtenerVelocidad(), cohete->obtenerCombustible()});
+    };
+    guardar();
+
+    // Mismo recorrido que EjecutorLotes::completarMision, cortado además en
+    // cada muestra k * intervalo (con margen, porque el reloj es una suma
+    // de pasos y puede quedar apenas antes de la marca)
+    std::size_t cursor = 0;
+    long muestra = 1;
+    while (juego.estaEnEjecucion() && !juego.haGanado() && !juego.haPerdido()) {
+        const double t = juego.obtenerTiempoSimulacion();
+        const double marca = muestra * intervalo - 1e-9;
+        juego.ajustarEmpuje(mision.programa.empujeEn(t, cursor));
+        const double limite = std::min(mision.programa.siguienteCambio(t, cursor), marca);
+        if (juego.avanzarHasta(limite) == 0) break;
+
+        if (juego.obtenerTiempoSimulacion() >= marca) {
+            guardar();
+            while (muestra * intervalo - 1e-9 <= juego.obtenerTiempoSimulacion()) {
+                ++muestra;
+            }
+        }
+    }
+    if (puntos.back().tiempo < juego.obtenerTiempoSimulacion()) {
+        guardar();
+    }
+    return puntos;
+}
+
+unsigned OptimizadorVostok::obtenerNumeroHilos() const {
+    return grupo.obtenerNumeroHilos() + 1;
+}
@@ -0,0 +1,71 @@
+#ifndef OPTIMIZADORVOSTOK_H
+#define OPTIMIZADORVOSTOK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ejecutorlotes.h"
+#include "grupohilos.h"
+#include "programaempuje.h"
+
+struct ConfiguracionOptimizador {
+    double velocidadInicial = 0.0;    // Heredada del nivel 1
+    double combustibleInicial = -1.0; // Negativo: tanque lleno
+    int tramos = 4;                   // Tramos de empuje constante (el último apaga el motor)
+    std::size_t poblacion = 40;
+    int generacionesMaximas = 200;
+    int generacionesSinMejora = 30;   // Corta antes si el mejor no baja en este tiempo
+    double pasoFisica = 0.1;
+    double duracionMaximaTramo = 200.0;
+    double empujeMaximo = 500000.0;
+    double factorDiferencial = 0.6;   // F de evolución diferencial
+    double probabilidadCruce = 0.9;   // CR de evolución diferencial
+    std::uint64_t semilla = 1;
+};
+
+struct ResultadoOptimizacion {
+    ProgramaEmpuje programa;
+    bool factible = false;          // Algún candidato ganó el nivel
+    double combustibleUsado = 0.0;  // kg
+    ResultadoMision mision;         // Corrida del mejor programa
+    int generaciones = 0;
+    std::size_t evaluaciones = 0;
+};
+
+struct PuntoTrayectoria {
+    double tiempo;
+    double altura;
+    double velocidad;
+    double combustible;
+};
+
+// Busca el programa de empuje por tramos que gana el nivel 2 (200 km con
+// velocidad entre 2000 y 8500 m/s) gastando el mínimo de combustible. Usa
+// evolución diferencial: cada generación se evalúa en paralelo con la
+// física sin interfaz de Juego, que juzga victoria y derrota con las mismas
+// reglas que la partida. Los candidatos se generan en el hilo que llama con
+// una sola secuencia aleatoria, así el resultado no depende de los hilos.
+class OptimizadorVostok {
+private:
+    GrupoHilos grupo;
+
+    // Genes en [0, 1]: duración y empuje de cada tramo
+    static void decodificar(const std::vector<double>& genes,
+                            const ConfiguracionOptimizador& config, ProgramaEmpuje& programa);
+
+public:
+    // numeroHilos == 0 usa todos los núcleos disponibles
+    explicit OptimizadorVostok(unsigned numeroHilos = 0);
+
+    ResultadoOptimizacion optimizar(const ConfiguracionOptimizador& config);
+
+    static Mision crearMision(const ConfiguracionOptimizador& config, const ProgramaEmpuje& programa);
+
+    // Repite la misión guardando el estado cada 'intervalo' segundos
+    // simulados, para comparar trayectorias
+    static std::vector<PuntoTrayectoria> muestrear(const Mision& mision, double intervalo);
+
+    unsigned obtenerNumeroHilos() const;
+};
+
+#endif // OPTIMIZADORVOSTOK_H
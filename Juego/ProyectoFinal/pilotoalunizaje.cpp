@@ -0,0 +1,144 @@
+#include "pilotoalunizaje.h"
+#include <algorithm>
+#include <cmath>
+#include "cohete.h"
+#include "nivel3_apolo11.h"
+
+namespace {
+
+const int ITERACIONES_MAXIMAS = 12;
+const double TOLERANCIA_ALTURA = 1e-4; // m
+
+// Tasa de la fricción horizontal: vx(t) = vx0 * e^(-tasa t)
+const double TASA_FRICCION = -std::log(Nivel3_Apolo11::FRICCION_HORIZONTAL);
+
+}
+
+PilotoAlunizaje::PilotoAlunizaje(const Nivel3_Apolo11& nivel, double paso)
+    : gravedad(nivel.obtenerGravedad()),
+    velocidadEscape(nivel.obtenerFactorConsumo()),
+    velocidadContacto(-0.5 * (nivel.obtenerVelocidadAterrizajeMin() +
+                              nivel.obtenerVelocidadAterrizajeMax())),
+    empujeMaximo(Cohete::EMPUJE_MAXIMO),
+    zonaAterrizaje(Nivel3_Apolo11::RANGO_ATERRIZAJE),
+    pasoControl(std::max(0.0, paso))
+{
+}
+
+double PilotoAlunizaje::calcularEmpujeFrenado(double altura, double velocidad, double masa,
+                                              double& duracion) const {
+    duracion = 0.0;
+    if (altura <= 0.0 || velocidad >= velocidadContacto) return 0.0;
+
+    // Para una quema de duración tau con empuje F constante el cambio de
+    // velocidad es ve*ln(m0/m1) - g*tau. Fijando la velocidad final, cada
+    // tau da m1 y F en forma cerrada, y la altura recorrida también; solo
+    // hay que buscar el tau que recorre exactamente 'altura'.
+    auto recorrido = [&](double tau, double& empuje) {
+        const double deltaV = velocidadContacto - velocidad + gravedad * tau;
+        const double quemado = -masa * std::expm1(-deltaV / velocidadEscape);
+        const double masaFinal = masa - quemado;
+        empuje = velocidadEscape * quemado / tau;
+        return velocidad * tau - 0.5 * gravedad * tau * tau
+               + velocidadEscape * tau - masaFinal * tau * deltaV / quemado;
+    };
+
+    // Con masa constante el recorrido es la velocidad media por tau; la
+    // secante corrige la diferencia por la masa en pocas iteraciones
+    double empuje = 0.0;
+    double tau0 = 2.0 * altura / -(velocidad + velocidadContacto);
+    double error0 = recorrido(tau0, empuje) + altura;
+    double tau1 = tau0 * 1.01;
+    double error1 = recorrido(tau1, empuje) + altura;
+
+    for (int i = 0; i < ITERACIONES_MAXIMAS && std::abs(error1) > TOLERANCIA_ALTURA; ++i) {
+        if (error1 == error0) break;
+        const double tau = std::max(0.5 * tau1, tau1 - error1 * (tau1 - tau0) / (error1 - error0));
+        tau0 = tau1;
+        error0 = error1;
+        tau1 = tau;
+        error1 = recorrido(tau1, empuje) + altura;
+    }
+
+    duracion = tau1;
+    return empuje;
+}
+
+ConsignaAlunizaje PilotoAlunizaje::calcular(const Cohete& cohete,
+                                            const IncertidumbreAlunizaje& incertidumbre) const {
+    ConsignaAlunizaje consigna;
+
+    const double altura = cohete.obtenerAltura();
+    const double velocidad = cohete.obtenerVelocidad();
+    const double combustible = cohete.obtenerCombustible();
+    const double masa = cohete.obtenerMasaSeca() + combustible;
+
+    // La quema planeada termina a la altura de aproximación, más alta
+    // cuanto menos se sabe de la altura
+    const double alturaAproximacion = PASOS_APROXIMACION * -velocidadContacto * pasoControl +
+                                      SIGMAS_MARGEN * incertidumbre.altura;
+    const double alturaPlan = altura - alturaAproximacion;
+    const bool encendido = cohete.obtenerEmpuje() > 0.0;
+
+    double duracion = 0.0;
+    const double empuje =
+        alturaPlan > 0.0 ? calcularEmpujeFrenado(alturaPlan, velocidad, masa, duracion) : 0.0;
+
+    if (alturaPlan <= 0.0 || (encendido && empuje > 0.0 && duracion <= pasoControl)) {
+        // Aproximación: se lleva la velocidad a la de contacto y se mantiene
+        const double ajuste = std::max(pasoControl, TIEMPO_AJUSTE_MINIMO);
+        const double necesario = masa * (gravedad + (velocidadContacto - velocidad) / ajuste);
+        consigna.alcanza = necesario <= empujeMaximo || velocidad >= velocidadContacto;
+        if (necesario > 0.0 && cohete.tieneCombustible()) {
+            consigna.frenando = true;
+            consigna.empuje = std::min(necesario, empujeMaximo);
+        }
+        consigna.tiempoHastaContacto = altura / -std::min(velocidad, velocidadContacto);
+    } else if (empuje > 0.0) {
+        consigna.alcanza = empuje <= empujeMaximo &&
+                           empuje * duracion / velocidadEscape <= combustible;
+
+        // Se enciende si un paso más sin motor, a la velocidad más rápida
+        // que admite la incertidumbre, ya exigiría FRACCION_FRENADO del
+        // máximo
+        bool tarde = false;
+        if (!encendido) {
+            const double velocidadPeor = velocidad - SIGMAS_MARGEN * incertidumbre.velocidad;
+            const double alturaSiguiente =
+                alturaPlan + velocidadPeor * pasoControl - 0.5 * gravedad * pasoControl * pasoControl;
+            double duracionSiguiente = 0.0;
+            tarde = alturaSiguiente <= 0.0 ||
+                    calcularEmpujeFrenado(alturaSiguiente, velocidadPeor - gravedad * pasoControl, masa,
+                                          duracionSiguiente) >= FRACCION_FRENADO * empujeMaximo;
+        }
+        const bool seguir = encendido && (empuje >= FRACCION_MANTENER * empujeMaximo ||
+                                          duracion <= DURACION_QUEMA_FINAL);
+        if ((seguir || tarde) && cohete.tieneCombustible()) {
+            consigna.frenando = true;
+            consigna.empuje = std::min(empuje, empujeMaximo);
+        }
+        consigna.tiempoHastaContacto = duracion + alturaAproximacion / -velocidadContacto;
+    } else if (altura > 0.0) {
+        // Más lento que la velocidad de contacto: caída libre hasta el suelo
+        consigna.tiempoHastaContacto =
+            (velocidad + std::sqrt(velocidad * velocidad + 2.0 * gravedad * altura)) / gravedad;
+    }
+
+    // Horizontal: con la fricción, vx recorre vx*(1 - e^(-k t))/k hasta
+    // detenerse; se corrige solo si el punto de contacto previsto cae fuera
+    // de la mitad central de la zona
+    const double x = cohete.obtenerPosicionX();
+    const double vx = cohete.obtenerVelocidadX();
+    const double t = consigna.tiempoHastaContacto;
+    const double alcanceUnitario = t > 0.0 ? -std::expm1(-TASA_FRICCION * t) / TASA_FRICCION : 0.0;
+
+    if (alcanceUnitario > 0.0 && std::abs(x + vx * alcanceUnitario) > 0.5 * zonaAterrizaje) {
+        consigna.cambioVelocidadX = -x / alcanceUnitario - vx;
+    }
+
+    return consigna;
+}
+
+double PilotoAlunizaje::obtenerVelocidadContacto() const {
+    return velocidadContacto;
+}
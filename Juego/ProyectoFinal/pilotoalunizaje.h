@@ -0,0 +1,80 @@
+#ifndef PILOTOALUNIZAJE_H
+#define PILOTOALUNIZAJE_H
+
+class Cohete;
+class Nivel3_Apolo11;
+
+// Lo que el piloto automático haría en este instante
+struct ConsignaAlunizaje {
+    double empuje = 0.0;             // N
+    double cambioVelocidadX = 0.0;   // m/s a sumar ya a la velocidad horizontal
+    double tiempoHastaContacto = 0.0; // s estimados con el frenado planeado
+    bool frenando = false;           // Ya en la quema final
+    bool alcanza = true;             // false si ni a empuje máximo se llega a tiempo
+};
+
+// Desvíos estándar de la altura y la velocidad que recibe el piloto (0 si
+// son las reales)
+struct IncertidumbreAlunizaje {
+    double altura = 0.0;    // m
+    double velocidad = 0.0; // m/s
+};
+
+// Guiado de "quema suicida" para el nivel 3: cae sin motor y, cuando hace
+// falta, frena con un empuje constante que lleva la velocidad a la de
+// contacto al llegar a la altura de aproximación; desde ahí baja a esa
+// velocidad hasta tocar el suelo. El empuje se resuelve cada paso en forma
+// cerrada con la ecuación del cohete (la masa baja mientras se quema), así
+// que el error de integración se corrige solo. Cuesta menos de un
+// microsegundo por llamada y no guarda estado entre llamadas.
+//
+// Con 'pasoControl' (cuánto dura cada consigna) la aproximación ocupa
+// PASOS_APROXIMACION pasos, el encendido se adelanta si esperar un paso más
+// sin motor ya fuera tarde y la quema que terminaría dentro del próximo paso
+// pasa directamente a la aproximación: con pasos gruesos el motor no puede
+// apagarse justo al tocar el suelo.
+//
+// Con una estimación en vez del estado real, la altura de aproximación
+// crece en SIGMAS_MARGEN desvíos de la altura y el encendido se decide con
+// la velocidad SIGMAS_MARGEN desvíos más rápida.
+class PilotoAlunizaje {
+private:
+    double gravedad;
+    double velocidadEscape;  // Empuje por kg/s de combustible (m/s)
+    double velocidadContacto; // Negativa
+    double empujeMaximo;
+    double zonaAterrizaje;   // Semiancho (m) en el que no se corrige la posición
+    double pasoControl;      // s que se mantiene cada consigna (0: continuo)
+
+public:
+    // Fracción del empuje máximo con la que se planea el frenado: deja
+    // margen para absorber errores sin quedarse corto
+    static constexpr double FRACCION_FRENADO = 0.8;
+    // Una vez frenando se sigue mientras baste con esta fracción, para no
+    // alternar entre apagado y encendido en cada paso
+    static constexpr double FRACCION_MANTENER = 0.4;
+    // En los últimos segundos de la quema el motor no se apaga aunque el
+    // empuje necesario baje de FRACCION_MANTENER
+    static constexpr double DURACION_QUEMA_FINAL = 5.0;
+    // Pasos de control que dura la bajada final a la velocidad de contacto
+    static constexpr double PASOS_APROXIMACION = 2.0;
+    // Tiempo mínimo (s) en el que la aproximación corrige la velocidad
+    static constexpr double TIEMPO_AJUSTE_MINIMO = 0.1;
+    // Desvíos estándar de margen con una estimación
+    static constexpr double SIGMAS_MARGEN = 3.0;
+
+    explicit PilotoAlunizaje(const Nivel3_Apolo11& nivel, double pasoControl = 0.0);
+
+    ConsignaAlunizaje calcular(const Cohete& cohete,
+                               const IncertidumbreAlunizaje& incertidumbre = IncertidumbreAlunizaje()) const;
+
+    // Empuje constante que, empezando ya, deja el cohete en el suelo a la
+    // velocidad de contacto; 'duracion' recibe la quema resultante.
+    // Devuelve 0 si no hace falta frenar.
+    double calcularEmpujeFrenado(double altura, double velocidad, double masa,
+                                 double& duracion) const;
+
+    double obtenerVelocidadContacto() const;
+};
+
+#endif // PILOTOALUNIZAJE_H
@@ -0,0 +1,203 @@
+#include "predictortrayectoria.h"
+#include <algorithm>
+#include "juego.h"
+#include "nivel2_vostok.h"
+
+PredictorTrayectoria::PredictorTrayectoria()
+    : terminada(false),
+    valida(false),
+    version(0),
+    grupo(1) {
+}
+
+PredictorTrayectoria::~PredictorTrayectoria() {
+    // Una tarea en curso corta en la próxima muestra; el grupo la espera
+    descartar();
+}
+
+bool PredictorTrayectoria::actualizar(const Juego& juego, unsigned long long versionControles) {
+    const int nivel = juego.obtenerNivelActual();
+    if ((nivel != 2 && nivel != 3) || !juego.estaEnEjecucion() ||
+        juego.haGanado() || juego.haPerdido()) {
+        const bool habia = !puntos.empty() || !marcas.empty() || enCurso;
+        descartar();
+        return habia;
+    }
+
+    bool cambio = false;
+    if (enCurso && enCurso->lista.load(std::memory_order_acquire)) {
+        recoger();
+        cambio = true;
+    }
+
+    // Lo que se ve queda hasta que llega la previsión nueva. Una
+    // continuación ya no sirve; un cálculo completo se deja terminar y al
+    // llegar se relanza desde el estado de ese momento, así una tecla
+    // mantenida no encadena recálculos que se descartan sin verse.
+    if (versionControles != version) {
+        version = versionControles;
+        valida = false;
+        terminada = false;
+        if (enCurso && enCurso->continuacion) {
+            enCurso->descartada.store(true, std::memory_order_relaxed);
+            enCurso.reset();
+        }
+    }
+    if (!valida && !enCurso) {
+        lanzar(juego, juego.capturarEstado(), false);
+    }
+
+    // Lo ya recorrido se descarta
+    const double ahora = juego.obtenerTiempoSimulacion();
+    const auto pendiente = std::find_if(puntos.begin(), puntos.end(),
+                                        [ahora](const PuntoPrevisto& p) { return p.tiempo >= ahora; });
+    if (pendiente != puntos.begin()) {
+        puntos.erase(puntos.begin(), pendiente);
+        cambio = true;
+    }
+    const auto pasadas = std::remove_if(marcas.begin(), marcas.end(),
+                                        [ahora](const MarcaPrevision& m) { return m.tiempo < ahora; });
+    if (pasadas != marcas.end()) {
+        marcas.erase(pasadas, marcas.end());
+        cambio = true;
+    }
+
+    // Cuando queda menos de medio horizonte por delante se pide la cola
+    if (valida && !terminada && !enCurso &&
+        (puntos.empty() || puntos.back().tiempo < ahora + HORIZONTE / 2.0)) {
+        lanzar(juego, finPrevision, true);
+    }
+    return cambio;
+}
+
+void PredictorTrayectoria::descartar() {
+    if (enCurso) {
+        enCurso->descartada.store(true, std::memory_order_relaxed);
+        enCurso.reset();
+    }
+    puntos.clear();
+    marcas.clear();
+    terminada = false;
+    valida = false;
+}
+
+void PredictorTrayectoria::lanzar(const Juego& juego, const EstadoJuego& desde, bool continuacion) {
+    auto calculo = std::make_shared<Calculo>();
+    calculo->origen = desde;
+    calculo->pasoFisica = juego.obtenerPasoFisica();
+    calculo->integrador = juego.obtenerIntegrador();
+    calculo->tolerancia = juego.obtenerToleranciaIntegrador();
+    calculo->avanceBalistico = juego.tieneAvanceBalistico();
+    calculo->hasta = juego.obtenerTiempoSimulacion() + HORIZONTE;
+    calculo->version = version;
+    calculo->continuacion = continuacion;
+
+    enCurso = calculo;
+    grupo.encolar([calculo]() {
+        if (!calculo->descartada.load(std::memory_order_relaxed)) {
+            simular(*calculo);
+        }
+        calculo->lista.store(true, std::memory_order_release);
+    });
+}
+
+void PredictorTrayectoria::recoger() {
+    std::shared_ptr<Calculo> calculo = std::move(enCurso);
+    if (calculo->descartada.load(std::memory_order_relaxed)) return;
+
+    if (calculo->continuacion) {
+        if (!valida || calculo->version != version) return;
+        puntos.insert(puntos.end(), calculo->puntos.begin(), calculo->puntos.end());
+        marcas.insert(marcas.end(), calculo->marcas.begin(), calculo->marcas.end());
+    } else {
+        // Si los controles cambiaron mientras tanto se muestra igual (está
+        // más cerca que la anterior), pero no se continúa
+        puntos = std::move(calculo->puntos);
+        marcas = std::move(calculo->marcas);
+        valida = calculo->version == version;
+        if (!valida) return;
+    }
+    finPrevision = calculo->final;
+    terminada = calculo->terminada;
+}
+
+void PredictorTrayectoria::simular(Calculo& calculo) {
+    Juego juego;
+    juego.establecerModoSilencioso(true);
+    juego.establecerPasoFisica(calculo.pasoFisica);
+    juego.establecerIntegrador(calculo.integrador, calculo.tolerancia);
+    juego.establecerAvanceBalistico(calculo.avanceBalistico);
+    juego.restaurarEstado(calculo.origen);
+
+    const Cohete* cohete = juego.obtenerCohete();
+    const auto* vostok = dynamic_cast<const Nivel2_Vostok*>(juego.obtenerNivel());
+
+    auto leer = [&]() {
+        return PuntoPrevisto{juego.obtenerTiempoSimulacion(), cohete->obtenerAltura(),
+                             cohete->obtenerPosicionX(), cohete->obtenerVelocidad(),
+                             cohete->obtenerCombustible()};
+    };
+    PuntoPrevisto anterior = leer();
+    PuntoPrevisto actual = anterior;
+    if (!calculo.continuacion) {
+        calculo.puntos.push_back(anterior);
+    }
+
+    // Marca el cruce de 'umbral' entre dos muestras, interpolando el instante
+    auto marcarCruce = [&](TipoMarcaPrevision tipo, double a, double b, double umbral) {
+        const double f = (umbral - a) / (b - a);
+        calculo.marcas.push_back({tipo,
+                                  anterior.tiempo + (actual.tiempo - anterior.tiempo) * f,
+                                  anterior.altura + (actual.altura - anterior.altura) * f,
+                                  anterior.posicionX + (actual.posicionX - anterior.posicionX) * f});
+    };
+
+    double siguienteMuestra = anterior.tiempo + INTERVALO_MUESTRA;
+    while (juego.estaEnEjecucion() && !juego.haGanado() && !juego.haPerdido() &&
+           juego.obtenerTiempoSimulacion() < calculo.hasta) {
+        if (calculo.descartada.load(std::memory_order_relaxed)) return;
+        if (juego.avanzarHasta(std::min(siguienteMuestra, calculo.hasta)) == 0) break;
+
+        actual = leer();
+        if (anterior.combustible > 0.0 && actual.combustible <= 0.0) {
+            marcarCruce(TipoMarcaPrevision::SinCombustible,
+                        anterior.combustible, actual.combustible, 0.0);
+        }
+        if (vostok) {
+            const double maxima = vostok->obtenerVelocidadSeguraMax();
+            const double minima = vostok->obtenerVelocidadSeguraMin();
+            const double destruccion = vostok->obtenerVelocidadMaxima();
+            if (anterior.velocidad <= maxima && actual.velocidad > maxima) {
+                marcarCruce(TipoMarcaPrevision::SobreVelocidadSegura,
+                            anterior.velocidad, actual.velocidad, maxima);
+            }
+            if (anterior.velocidad >= minima && actual.velocidad < minima) {
+                marcarCruce(TipoMarcaPrevision::BajoVelocidadSegura,
+                            anterior.velocidad, actual.velocidad, minima);
+            }
+            if (anterior.velocidad <= destruccion && actual.velocidad > destruccion) {
+                marcarCruce(TipoMarcaPrevision::VelocidadMaxima,
+                            anterior.velocidad, actual.velocidad, destruccion);
+            }
+        }
+        calculo.puntos.push_back(actual);
+        anterior = actual;
+        siguienteMuestra += INTERVALO_MUESTRA;
+    }
+
+    if (juego.haGanado() || juego.haPerdido()) {
+        calculo.marcas.push_back({juego.haGanado() ? TipoMarcaPrevision::Victoria
+                                                   : TipoMarcaPrevision::Derrota,
+                                  actual.tiempo, actual.altura, actual.posicionX});
+        calculo.terminada = true;
+    }
+    calculo.final = juego.capturarEstado();
+}
+
+const std::vector<PuntoPrevisto>& PredictorTrayectoria::obtenerPuntos() const {
+    return puntos;
+}
+
+const std::vector<MarcaPrevision>& PredictorTrayectoria::obtenerMarcas() const {
+    return marcas;
+}
@@ -0,0 +1,104 @@
+#ifndef PREDICTORTRAYECTORIA_H
+#define PREDICTORTRAYECTORIA_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "estadojuego.h"
+#include "grupohilos.h"
+
+class Juego;
+
+struct PuntoPrevisto {
+    double tiempo;
+    double altura;
+    double posicionX;
+    double velocidad;
+    double combustible;
+};
+
+enum class TipoMarcaPrevision {
+    SinCombustible,
+    SobreVelocidadSegura, // Nivel 2: pasa de la velocidad segura máxima
+    BajoVelocidadSegura,  // Nivel 2: cae por debajo de la velocidad segura mínima
+    VelocidadMaxima,      // Supera la velocidad que destruye la nave
+    Victoria,
+    Derrota
+};
+
+struct MarcaPrevision {
+    TipoMarcaPrevision tipo;
+    double tiempo;
+    double altura;
+    double posicionX;
+};
+
+// Camino que seguiría el cohete si los controles quedaran como están. Lo usa
+// el hilo de simulación: actualizar() se llama en cada vuelta y nunca
+// simula en ese hilo. Mientras los controles no cambian, la partida recorre
+// exactamente la previsión (misma física, mismo paso), así que solo se
+// descarta lo ya recorrido y, cuando queda poco por delante, se pide en
+// segundo plano la continuación desde el último estado previsto. Si
+// cambian, se vuelve a simular todo desde el estado actual; mientras tanto
+// se sigue viendo la previsión anterior y, si vuelven a cambiar antes de
+// que termine, se relanza una sola vez al terminar.
+class PredictorTrayectoria {
+public:
+    static constexpr double HORIZONTE = 60.0;          // s por delante del cohete
+    static constexpr double INTERVALO_MUESTRA = 0.5;   // s entre puntos
+
+private:
+    // Lo que comparte una tarea con el hilo de simulación; por shared_ptr
+    // para que un cálculo descartado pueda terminar solo
+    struct Calculo {
+        EstadoJuego origen;
+        double pasoFisica = 0.1;
+        TipoIntegrador integrador = TipoIntegrador::Euler;
+        double tolerancia = 1e-6;
+        bool avanceBalistico = false;
+        double hasta = 0.0;
+        unsigned long long version = 0;
+        bool continuacion = false;
+        std::vector<PuntoPrevisto> puntos;
+        std::vector<MarcaPrevision> marcas;
+        EstadoJuego final;
+        bool terminada = false; // La previsión llega a la victoria o la derrota
+        std::atomic<bool> lista{false};
+        std::atomic<bool> descartada{false};
+    };
+
+    std::shared_ptr<Calculo> enCurso;
+    std::vector<PuntoPrevisto> puntos;
+    std::vector<MarcaPrevision> marcas;
+    EstadoJuego finPrevision;
+    bool terminada;
+    bool valida;
+    unsigned long long version;
+
+    // Último miembro: se destruye primero y espera a las tareas
+    GrupoHilos grupo;
+
+    void lanzar(const Juego& juego, const EstadoJuego& desde, bool continuacion);
+    void recoger();
+    static void simular(Calculo& calculo);
+
+public:
+    PredictorTrayectoria();
+    ~PredictorTrayectoria();
+
+    PredictorTrayectoria(const PredictorTrayectoria&) = delete;
+    PredictorTrayectoria& operator=(const PredictorTrayectoria&) = delete;
+
+    // 'versionControles' debe cambiar cada vez que algo distinto de la
+    // física cambia la partida (empuje, movimiento lateral, rebobinado,
+    // otro nivel...). Devuelve true si cambió lo que hay que mostrar.
+    bool actualizar(const Juego& juego, unsigned long long versionControles);
+    void descartar();
+
+    // Desde el instante actual en adelante; vacías solo hasta la primera
+    // previsión de cada nivel
+    const std::vector<PuntoPrevisto>& obtenerPuntos() const;
+    const std::vector<MarcaPrevision>& obtenerMarcas() const;
+};
+
+#endif // PREDICTORTRAYECTORIA_H
@@ -0,0 +1,106 @@
+#include "programaempuje.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+ProgramaEmpuje::ProgramaEmpuje() {
+}
+
+ProgramaEmpuje::ProgramaEmpuje(double empujeConstante) {
+    agregarTramo(0.0, empujeConstante);
+}
+
+void ProgramaEmpuje::agregarTramo(double tiempoInicio, double empuje) {
+    Tramo tramo{tiempoInicio, empuje};
+
+    // Mantener los tramos ordenados por tiempo de inicio
+    auto pos = std::upper_bound(tramos.begin(), tramos.end(), tiempoInicio,
+                                [](double t, const Tramo& tr) { return t < tr.tiempoInicio; });
+    tramos.insert(pos, tramo);
+}
+
+void ProgramaEmpuje::limpiar() {
+    tramos.clear();
+}
+
+double ProgramaEmpuje::empujeEn(double t, std::size_t& cursor) const {
+    if (tramos.empty() || t < tramos.front().tiempoInicio) {
+        cursor = 0;
+        return 0.0;
+    }
+
+    if (cursor >= tramos.size() || tramos[cursor].tiempoInicio > t) {
+        cursor = 0;
+    }
+
+    while (cursor + 1 < tramos.size() && tramos[cursor + 1].tiempoInicio <= t) {
+        ++cursor;
+    }
+
+    return tramos[cursor].empuje;
+}
+
+double ProgramaEmpuje::empujeEn(double t) const {
+    std::size_t cursor = 0;
+    return empujeEn(t, cursor);
+}
+
+double ProgramaEmpuje::siguienteCambio(double t, std::size_t cursor) const {
+    if (!tramos.empty() && t < tramos.front().tiempoInicio) {
+        return tramos.front().tiempoInicio;
+    }
+    if (cursor + 1 < tramos.size()) {
+        return tramos[cursor + 1].tiempoInicio;
+    }
+    return std::numeric_limits<double>::infinity();
+}
+
+const std::vector<ProgramaEmpuje::Tramo>& ProgramaEmpuje::obtenerTramos() const {
+    return tramos;
+}
+
+ProgramaEmpuje ProgramaEmpuje::escalado(double factor) const {
+    ProgramaEmpuje copia(*this);
+    for (Tramo& tramo : copia.tramos) {
+        tramo.empuje *= factor;
+    }
+    return copia;
+}
+
+bool ProgramaEmpuje::estaVacio() const {
+    return tramos.empty();
+}
+
+bool ProgramaEmpuje::guardar(const std::string& ruta) const {
+    std::ofstream archivo(ruta);
+    if (!archivo) return false;
+
+    archivo << "# tiempoInicio (s) empuje (N)\n";
+    archivo.precision(17);
+    for (const Tramo& tramo : tramos) {
+        archivo << tramo.tiempoInicio << ' ' << tramo.empuje << '\n';
+    }
+    return static_cast<bool>(archivo);
+}
+
+bool ProgramaEmpuje::cargar(const std::string& ruta) {
+    std::ifstream archivo(ruta);
+    if (!archivo) return false;
+
+    ProgramaEmpuje leido;
+    std::string linea;
+    while (std::getline(archivo, linea)) {
+        const std::size_t inicio = linea.find_first_not_of(" \t\r");
+        if (inicio == std::string::npos || linea[inicio] == '#') continue;
+
+        std::istringstream campos(linea);
+        double tiempo = 0.0;
+        double empuje = 0.0;
+        if (!(campos >> tiempo >> empuje)) return false;
+        leido.agregarTramo(tiempo, empuje);
+    }
+
+    tramos = std::move(leido.tramos);
+    return true;
+}
@@ -0,0 +1,49 @@
+#ifndef PROGRAMAEMPUJE_H
+#define PROGRAMAEMPUJE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Programa de empuje constante por tramos: cada tramo fija el empuje
+// desde su tiempo de inicio hasta el inicio del siguiente.
+class ProgramaEmpuje {
+public:
+    struct Tramo {
+        double tiempoInicio;
+        double empuje;
+    };
+
+private:
+    std::vector<Tramo> tramos;
+
+public:
+    ProgramaEmpuje();
+    explicit ProgramaEmpuje(double empujeConstante);
+
+    void agregarTramo(double tiempoInicio, double empuje);
+    void limpiar();
+
+    // Mismos tramos con cada empuje multiplicado por 'factor'
+    ProgramaEmpuje escalado(double factor) const;
+
+    // Empuje vigente en el instante t. 'cursor' guarda el último tramo usado
+    // para que recorrer el programa en orden sea O(1) amortizado.
+    double empujeEn(double t, std::size_t& cursor) const;
+    double empujeEn(double t) const;
+
+    // Instante del próximo cambio de empuje después de t (infinito si no
+    // hay más tramos). 'cursor' debe venir de la última llamada a empujeEn.
+    double siguienteCambio(double t, std::size_t cursor) const;
+
+    const std::vector<Tramo>& obtenerTramos() const;
+    bool estaVacio() const;
+
+    // Texto plano: una línea "tiempoInicio empuje" por tramo; las líneas
+    // que empiezan con '#' son comentarios. cargar deja el programa como
+    // estaba si el archivo no se puede leer o tiene una línea inválida.
+    bool guardar(const std::string& ruta) const;
+    bool cargar(const std::string& ruta);
+};
+
+#endif // PROGRAMAEMPUJE_H
@@ -0,0 +1,136 @@
+#include "rebobinador.h"
+#include <algorithm>
+
+Rebobinador::Rebobinador(std::size_t presupuestoBytes, long intervaloPasos)
+    : maxPuntos(std::max<std::size_t>(2, presupuestoBytes * 3 / 4 / sizeof(EstadoJuego))),
+    maxEntradas(std::max<std::size_t>(16, presupuestoBytes / 4 / sizeof(EntradaControl))),
+    intervalo(std::max(1L, intervaloPasos)),
+    intervaloInicial(intervalo),
+    pasoMaximo(-1),
+    activo(false) {
+    // Toda la memoria del historial se reserva aquí; durante la partida no
+    // se vuelve a pedir
+    puntos.reserve(maxPuntos);
+    entradas.reserve(maxEntradas);
+}
+
+void Rebobinador::reiniciar(const EstadoJuego& inicial) {
+    puntos.clear();
+    entradas.clear();
+    intervalo = intervaloInicial;
+    pasoMaximo = inicial.paso;
+    puntos.push_back(inicial);
+    activo = true;
+}
+
+void Rebobinador::vaciar() {
+    puntos.clear();
+    entradas.clear();
+    intervalo = intervaloInicial;
+    pasoMaximo = -1;
+    activo = false;
+}
+
+bool Rebobinador::registrarPaso(long paso) {
+    if (!activo) return false;
+
+    if (paso <= pasoMaximo) {
+        descartarFuturo(paso - 1);
+    }
+    pasoMaximo = paso;
+
+    // Por distancia y no por múltiplo: el avance balístico salta varios
+    // pasos de una vez
+    return puntos.empty() || paso - puntos.back().paso >= intervalo;
+}
+
+void Rebobinador::guardarPunto(const EstadoJuego& estado) {
+    if (!activo) return;
+
+    if (puntos.size() == maxPuntos) {
+        ralearPuntos();
+    }
+    puntos.push_back(estado);
+}
+
+void Rebobinador::registrarEntrada(const EntradaControl& entrada) {
+    if (!activo) return;
+
+    if (entrada.paso < pasoMaximo) {
+        descartarFuturo(entrada.paso);
+    }
+
+    if (entradas.size() == maxEntradas) {
+        descartarEntradasAntiguas();
+    }
+    entradas.push_back(entrada);
+}
+
+void Rebobinador::ralearPuntos() {
+    // Se queda con los de índice par (el primero siempre)
+    std::size_t destino = 0;
+    for (std::size_t i = 0; i < puntos.size(); i += 2) {
+        puntos[destino++] = puntos[i];
+    }
+    puntos.resize(destino);
+    intervalo *= 2;
+}
+
+void Rebobinador::descartarEntradasAntiguas() {
+    // Mitad más antigua, sin partir un grupo de entradas del mismo paso
+    std::size_t corte = entradas.size() / 2;
+    while (corte < entradas.size() && entradas[corte].paso == entradas[corte - 1].paso) {
+        ++corte;
+    }
+
+    // Los puntos anteriores a lo descartado ya no se pueden rehacer
+    const long limite = entradas[corte - 1].paso + 1;
+    entradas.erase(entradas.begin(), entradas.begin() + static_cast<std::ptrdiff_t>(corte));
+    puntos.erase(puntos.begin(),
+                 std::lower_bound(puntos.begin(), puntos.end(), limite,
+                                  [](const EstadoJuego& punto, long paso) { return punto.paso < paso; }));
+}
+
+void Rebobinador::descartarFuturo(long paso) {
+    entradas.erase(std::lower_bound(entradas.begin(), entradas.end(), paso,
+                                    [](const EntradaControl& e, long p) { return e.paso < p; }),
+                   entradas.end());
+    puntos.erase(std::upper_bound(puntos.begin(), puntos.end(), paso,
+                                  [](long p, const EstadoJuego& punto) { return p < punto.paso; }),
+                 puntos.end());
+    pasoMaximo = paso;
+}
+
+const EstadoJuego* Rebobinador::buscarPunto(long paso) const {
+    auto it = std::upper_bound(puntos.begin(), puntos.end(), paso,
+                               [](long p, const EstadoJuego& punto) { return p < punto.paso; });
+    if (it == puntos.begin()) return nullptr;
+    return &*(it - 1);
+}
+
+const EntradaControl* Rebobinador::primeraEntrada(long desde) const {
+    auto it = std::lower_bound(entradas.begin(), entradas.end(), desde,
+                               [](const EntradaControl& e, long p) { return e.paso < p; });
+    return entradas.data() + (it - entradas.begin());
+}
+
+const EntradaControl* Rebobinador::finEntradas() const {
+    return entradas.data() + entradas.size();
+}
+
+long Rebobinador::obtenerPasoMinimo() const {
+    return puntos.empty() ? -1 : puntos.front().paso;
+}
+
+long Rebobinador::obtenerPasoMaximo() const {
+    return pasoMaximo;
+}
+
+long Rebobinador::obtenerIntervalo() const {
+    return intervalo;
+}
+
+std::size_t Rebobinador::obtenerMemoriaReservada() const {
+    return puntos.capacity() * sizeof(EstadoJuego) +
+           entradas.capacity() * sizeof(EntradaControl);
+}
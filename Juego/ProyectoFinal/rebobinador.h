@@ -0,0 +1,77 @@
+#ifndef REBOBINADOR_H
+#define REBOBINADOR_H
+
+#include <cstddef>
+#include <vector>
+#include "estadojuego.h"
+
+// Órdenes del jugador que cambian la trayectoria
+enum class TipoEntrada : unsigned char {
+    Empuje,             // valor: empuje pedido (N)
+    VelocidadHorizontal // valor: cambio de velocidad horizontal (nivel 3)
+};
+
+// Entrada aplicada antes del paso 'paso + 1', es decir, con 'paso' pasos
+// ya simulados
+struct EntradaControl {
+    long paso;
+    TipoEntrada tipo;
+    double valor;
+};
+
+// Historial para volver a cualquier paso anterior de la partida: guarda un
+// punto de control (EstadoJuego) cada 'intervalo' pasos y todas las
+// entradas del jugador. Un paso intermedio se reconstruye restaurando el
+// punto anterior y volviendo a simular con las mismas entradas; como la
+// física es determinista el resultado es idéntico.
+//
+// La memoria se reserva una sola vez según el presupuesto. Cuando se llenan
+// los puntos se descarta uno de cada dos y se duplica el intervalo, así que
+// una partida de cualquier largo entra en el presupuesto a costa de rehacer
+// más pasos al buscar. Si se llenan las entradas se pierde la mitad más
+// antigua del historial.
+class Rebobinador {
+private:
+    std::vector<EstadoJuego> puntos;      // Ordenados por paso
+    std::vector<EntradaControl> entradas; // Ordenadas por paso
+    std::size_t maxPuntos;
+    std::size_t maxEntradas;
+    long intervalo;
+    long intervaloInicial;
+    long pasoMaximo; // Último paso registrado
+    bool activo;
+
+    void ralearPuntos();
+    void descartarEntradasAntiguas();
+    // Borra lo registrado después de 'paso' (entradas de 'paso' incluidas)
+    void descartarFuturo(long paso);
+
+public:
+    explicit Rebobinador(std::size_t presupuestoBytes = 1 << 20, long intervaloPasos = 100);
+
+    // Empieza un historial nuevo con 'inicial' como primer punto
+    void reiniciar(const EstadoJuego& inicial);
+    // Olvida el historial (nueva partida aún sin iniciar)
+    void vaciar();
+
+    // Se llama con cada paso nuevo. Si se viene de rebobinar, descarta el
+    // futuro anterior. Devuelve true si toca guardar un punto de control.
+    bool registrarPaso(long paso);
+    void guardarPunto(const EstadoJuego& estado);
+    void registrarEntrada(const EntradaControl& entrada);
+
+    // Último punto con paso <= 'paso' (nulo si no hay)
+    const EstadoJuego* buscarPunto(long paso) const;
+    // Primera entrada con paso >= 'desde'; las siguientes van en orden
+    // hasta finEntradas()
+    const EntradaControl* primeraEntrada(long desde) const;
+    const EntradaControl* finEntradas() const;
+
+    // Rango de pasos que se pueden reconstruir (mínimo -1 si no hay historial)
+    long obtenerPasoMinimo() const;
+    long obtenerPasoMaximo() const;
+    long obtenerIntervalo() const;
+    std::size_t obtenerMemoriaReservada() const;
+};
+
+#endif // REBOBINADOR_H
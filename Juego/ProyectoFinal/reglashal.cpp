@@ -0,0 +1,223 @@
+#include "reglashal.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr double INFINITO = std::numeric_limits<double>::infinity();
+
+// Índice del bit más bajo de x (distinto de cero) por De Bruijn, para no
+// depender de intrínsecos del compilador
+int bitMasBajo(std::uint64_t x) {
+    static constexpr int INDICE[64] = {
+        0, 47,  1, 56, 48, 27,  2, 60,
+        57, 49, 41, 37, 28, 16,  3, 61,
+        54, 58, 35, 52, 50, 42, 21, 44,
+        38, 32, 29, 23, 17, 11,  4, 62,
+        46, 55, 26, 59, 40, 36, 15, 53,
+        34, 51, 20, 43, 31, 22, 10, 45,
+        25, 39, 14, 33, 19, 30,  9, 24,
+        13, 18,  8, 12,  7,  6,  5, 63
+    };
+    return INDICE[((x ^ (x - 1)) * 0x03f79d71b4cb0a89ULL) >> 58];
+}
+
+} // namespace
+
+CondicionHAL menorQue(VariableHAL variable, double valor) {
+    return {variable, -INFINITO, valor};
+}
+
+CondicionHAL mayorQue(VariableHAL variable, double valor) {
+    return {variable, std::nextafter(valor, INFINITO), INFINITO};
+}
+
+CondicionHAL desde(VariableHAL variable, double valor) {
+    return {variable, valor, INFINITO};
+}
+
+CondicionHAL entre(VariableHAL variable, double minimo, double maximo) {
+    return {variable, minimo, std::nextafter(maximo, INFINITO)};
+}
+
+const std::vector<ReglaHAL>& reglasPredeterminadasHAL() {
+    using V = VariableHAL;
+    using G = GrupoRegla;
+    using C = CodigoAviso;
+
+    static const std::vector<ReglaHAL> reglas = {
+        // nivel, grupo, prioridad, aviso, parámetro, condiciones
+
+        // Consejos del nivel 1
+        {1, G::Consejo, 20, C::Nivel1VelocidadAlta, V::Ninguna,
+         {mayorQue(V::Velocidad, 7500.0), menorQue(V::Altura, 100000.0)}},
+        {1, G::Consejo, 15, C::ProyeccionVacio, V::SegundosHastaVacio,
+         {menorQue(V::SegundosHastaVacio, 20.0)}},
+        {1, G::Consejo, 10, C::Nivel1CombustibleBajo, V::Ninguna,
+         {menorQue(V::Combustible, 20.0)}},
+
+        // Consejos del nivel 2
+        {2, G::Consejo, 80, C::Nivel2ProgresoExcelente, V::Ninguna,
+         {entre(V::Velocidad, 2000.0, 8500.0), mayorQue(V::Combustible, 30.0),
+          {V::FraccionObjetivo, std::nextafter(0.5, INFINITO), 1.0}}},
+        {2, G::Consejo, 70, C::Nivel2BuenRitmo, V::Ninguna,
+         {entre(V::Velocidad, 2000.0, 8500.0), mayorQue(V::Combustible, 30.0),
+          {V::FraccionObjetivo, std::nextafter(0.25, INFINITO), 1.0}}},
+        {2, G::Consejo, 60, C::Nivel2VelocidadCritica, V::Ninguna,
+         {mayorQue(V::Velocidad, 10000.0)}},
+        {2, G::Consejo, 50, C::Nivel2VelocidadMuyAlta, V::Ninguna,
+         {mayorQue(V::Velocidad, 9500.0)}},
+        {2, G::Consejo, 40, C::Nivel2VelocidadBaja, V::Ninguna,
+         {menorQue(V::Velocidad, 2000.0), menorQue(V::FraccionObjetivo, 0.5)}},
+        {2, G::Consejo, 30, C::Nivel2CombustibleCritico, V::Ninguna,
+         {menorQue(V::Combustible, 10.0)}},
+        {2, G::Consejo, 25, C::ProyeccionVacio, V::SegundosHastaVacio,
+         {menorQue(V::SegundosHastaVacio, 20.0)}},
+        {2, G::Consejo, 20, C::Nivel2CombustibleBajo, V::Ninguna,
+         {menorQue(V::Combustible, 25.0)}},
+        {2, G::Consejo, 10, C::Nivel2CasiAhi, V::Ninguna,
+         {desde(V::FraccionObjetivo, 0.9), entre(V::Velocidad, 2000.0, 8500.0)}},
+
+        // Informe periódico
+        {1, G::InformeVelocidad, 10, C::InformeNivel1VelocidadAlta, V::Ninguna,
+         {mayorQue(V::RazonVelocidadMaxima, 0.95), menorQue(V::Altura, 100000.0)}},
+        {2, G::InformeVelocidad, 30, C::InformeVelocidadBaja, V::Velocidad,
+         {menorQue(V::Velocidad, 2000.0)}},
+        {2, G::InformeVelocidad, 20, C::InformeVelocidadPeligrosa, V::Velocidad,
+         {mayorQue(V::RazonAdvertencia, 1.0)}},
+        {2, G::InformeVelocidad, 10, C::InformeCercaLimite, V::Ninguna,
+         {mayorQue(V::Velocidad, 9000.0 * 0.9)}},
+        {0, G::InformeCombustible, 20, C::InformeCombustibleCritico, V::Combustible,
+         {menorQue(V::Combustible, 20.0)}},
+        {0, G::InformeCombustible, 10, C::InformeCombustibleBajo, V::Combustible,
+         {menorQue(V::Combustible, 40.0)}},
+        {0, G::InformeCombustible, 5, C::InformeProyeccionVacio, V::SegundosHastaVacio,
+         {menorQue(V::SegundosHastaVacio, 60.0)}},
+    };
+    return reglas;
+}
+
+void MotorReglasHAL::Mascara::marcar(std::size_t bit) {
+    palabras[bit / 64] |= std::uint64_t(1) << (bit % 64);
+}
+
+MotorReglasHAL::Mascara& MotorReglasHAL::Mascara::operator&=(const Mascara& otra) {
+    for (std::size_t i = 0; i < PALABRAS; ++i) {
+        palabras[i] &= otra.palabras[i];
+    }
+    return *this;
+}
+
+std::size_t MotorReglasHAL::Mascara::primero() const {
+    for (std::size_t i = 0; i < PALABRAS; ++i) {
+        if (palabras[i] != 0) {
+            return i * 64 + static_cast<std::size_t>(bitMasBajo(palabras[i]));
+        }
+    }
+    return MAX_REGLAS;
+}
+
+MotorReglasHAL::MotorReglasHAL(const std::vector<ReglaHAL>& reglas)
+    : descartadas(0) {
+    for (int nivel = 1; nivel <= MAX_NIVEL; ++nivel) {
+        compilar(nivel, reglas);
+    }
+}
+
+void MotorReglasHAL::compilar(int nivel, const std::vector<ReglaHAL>& reglas) {
+    std::vector<const ReglaHAL*> propias;
+    for (const ReglaHAL& regla : reglas) {
+        if (regla.nivel == 0 || regla.nivel == nivel) {
+            propias.push_back(&regla);
+        }
+    }
+    // Numeradas por prioridad: el primer bit de un grupo es su ganadora
+    std::stable_sort(propias.begin(), propias.end(), [](const ReglaHAL* a, const ReglaHAL* b) {
+        return a->prioridad > b->prioridad;
+    });
+    if (propias.size() > MAX_REGLAS) {
+        descartadas += propias.size() - MAX_REGLAS;
+        propias.resize(MAX_REGLAS);
+    }
+
+    NivelCompilado& compilado = niveles[nivel];
+    for (std::size_t i = 0; i < propias.size(); ++i) {
+        compilado.salidas.push_back({propias[i]->codigo, propias[i]->grupo, propias[i]->parametro});
+        compilado.todas.marcar(i);
+        compilado.grupos[static_cast<std::size_t>(propias[i]->grupo)].marcar(i);
+    }
+
+    for (std::size_t v = 1; v < NUMERO_VARIABLES; ++v) {
+        const VariableHAL variable = static_cast<VariableHAL>(v);
+
+        Eje eje{variable, {}, {}};
+        for (const ReglaHAL* regla : propias) {
+            for (const CondicionHAL& condicion : regla->condiciones) {
+                if (condicion.variable != variable) continue;
+                if (std::isfinite(condicion.minimo)) eje.bordes.push_back(condicion.minimo);
+                if (std::isfinite(condicion.maximo)) eje.bordes.push_back(condicion.maximo);
+            }
+        }
+        if (eje.bordes.empty()) continue; // Ninguna regla la mira
+
+        std::sort(eje.bordes.begin(), eje.bordes.end());
+        eje.bordes.erase(std::unique(eje.bordes.begin(), eje.bordes.end()), eje.bordes.end());
+
+        // El tramo k va de bordes[k - 1] a bordes[k]; una condición lo acepta
+        // entero o nada, porque sus extremos también son bordes
+        eje.tramos.resize(eje.bordes.size() + 1);
+        for (std::size_t k = 0; k < eje.tramos.size(); ++k) {
+            const double inicio = k == 0 ? -INFINITO : eje.bordes[k - 1];
+            const double fin = k == eje.bordes.size() ? INFINITO : eje.bordes[k];
+            for (std::size_t i = 0; i < propias.size(); ++i) {
+                bool acepta = true;
+                for (const CondicionHAL& condicion : propias[i]->condiciones) {
+                    if (condicion.variable == variable &&
+                        (condicion.minimo > inicio || condicion.maximo < fin)) {
+                        acepta = false;
+                    }
+                }
+                if (acepta) eje.tramos[k].marcar(i);
+            }
+        }
+        compilado.ejes.push_back(std::move(eje));
+    }
+}
+
+DecisionHAL MotorReglasHAL::evaluar(int nivel, const ValoresHAL& valores) const {
+    DecisionHAL decision;
+    if (nivel < 1 || nivel > MAX_NIVEL) return decision;
+
+    const NivelCompilado& compilado = niveles[nivel];
+    Mascara cumplen = compilado.todas;
+    for (const Eje& eje : compilado.ejes) {
+        const double valor = valores[static_cast<std::size_t>(eje.variable)];
+        const std::size_t tramo = static_cast<std::size_t>(
+            std::upper_bound(eje.bordes.begin(), eje.bordes.end(), valor) - eje.bordes.begin());
+        cumplen &= eje.tramos[tramo];
+    }
+
+    for (std::size_t g = 0; g < NUMERO_GRUPOS; ++g) {
+        Mascara delGrupo = cumplen;
+        delGrupo &= compilado.grupos[g];
+        const std::size_t regla = delGrupo.primero();
+        if (regla == MAX_REGLAS) continue;
+
+        const Salida& salida = compilado.salidas[regla];
+        decision.codigo[g] = salida.codigo;
+        if (salida.parametro != VariableHAL::Ninguna) {
+            decision.parametro[g] = valores[static_cast<std::size_t>(salida.parametro)];
+        }
+    }
+    return decision;
+}
+
+std::size_t MotorReglasHAL::obtenerDescartadas() const {
+    return descartadas;
+}
+
+const MotorReglasHAL& MotorReglasHAL::compartido() {
+    static const MotorReglasHAL motor(reglasPredeterminadasHAL());
+    return motor;
+}
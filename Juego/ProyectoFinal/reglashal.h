@@ -0,0 +1,127 @@
+#ifndef REGLASHAL_H
+#define REGLASHAL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "avisoshal.h"
+
+// Magnitudes que pueden mirar las reglas de HAL
+enum class VariableHAL : std::uint8_t {
+    Ninguna,
+    Velocidad,             // m/s
+    Combustible,           // % del tanque
+    Altura,                // m
+    FraccionObjetivo,      // altura / altura objetivo
+    RazonVelocidadMaxima,  // velocidad / velocidad máxima del nivel
+    RazonAdvertencia,      // velocidad / umbral de advertencia aprendido (nivel 2)
+    SegundosHastaVacio,    // combustible / consumo medio (infinito sin consumo)
+    Cantidad
+};
+
+// De cada grupo sale como mucho un aviso: el de la regla de mayor prioridad
+enum class GrupoRegla : std::uint8_t {
+    Consejo,             // Para la interfaz
+    InformeVelocidad,    // Informe periódico por consola
+    InformeCombustible,
+    Cantidad
+};
+
+// La regla se cumple si minimo <= valor < maximo
+struct CondicionHAL {
+    VariableHAL variable = VariableHAL::Ninguna;
+    double minimo = 0.0;
+    double maximo = 0.0;
+};
+
+CondicionHAL menorQue(VariableHAL variable, double valor);
+CondicionHAL mayorQue(VariableHAL variable, double valor);
+CondicionHAL desde(VariableHAL variable, double valor);
+CondicionHAL entre(VariableHAL variable, double minimo, double maximo); // Ambos incluidos
+
+struct ReglaHAL {
+    static constexpr std::size_t MAX_CONDICIONES = 3;
+
+    int nivel;                 // 0: cualquiera
+    GrupoRegla grupo;
+    int prioridad;             // Dentro del grupo gana la mayor
+    CodigoAviso codigo;
+    VariableHAL parametro;     // Lo que va en parametros[0] del aviso
+    std::array<CondicionHAL, MAX_CONDICIONES> condiciones; // Todas a la vez
+};
+
+// La tabla con los consejos e informes de HAL para los niveles 1 y 2 (y el
+// combustible de todos)
+const std::vector<ReglaHAL>& reglasPredeterminadasHAL();
+
+using ValoresHAL = std::array<double, static_cast<std::size_t>(VariableHAL::Cantidad)>;
+
+struct DecisionHAL {
+    std::array<CodigoAviso, static_cast<std::size_t>(GrupoRegla::Cantidad)> codigo{};
+    std::array<double, static_cast<std::size_t>(GrupoRegla::Cantidad)> parametro{};
+};
+
+// Las reglas compiladas por nivel en un índice por rangos: para cada
+// variable se ordenan los bordes de todas las condiciones y cada tramo entre
+// dos bordes guarda la máscara de reglas que lo aceptan. Evaluar es una
+// búsqueda binaria por variable, un AND de máscaras de ancho fijo y buscar
+// el primer bit de cada grupo (las reglas se numeran por prioridad), así
+// que el costo no depende de cuántas reglas haya hasta MAX_REGLAS.
+class MotorReglasHAL {
+public:
+    static constexpr std::size_t MAX_REGLAS = 256;
+    static constexpr int MAX_NIVEL = 3;
+
+private:
+    static constexpr std::size_t PALABRAS = MAX_REGLAS / 64;
+    static constexpr std::size_t NUMERO_VARIABLES = static_cast<std::size_t>(VariableHAL::Cantidad);
+    static constexpr std::size_t NUMERO_GRUPOS = static_cast<std::size_t>(GrupoRegla::Cantidad);
+
+    struct Mascara {
+        std::array<std::uint64_t, PALABRAS> palabras{};
+
+        void marcar(std::size_t bit);
+        Mascara& operator&=(const Mascara& otra);
+        // MAX_REGLAS si no hay ninguno
+        std::size_t primero() const;
+    };
+
+    struct Eje {
+        VariableHAL variable;
+        std::vector<double> bordes;    // Ordenados, sin repetir
+        std::vector<Mascara> tramos;   // bordes.size() + 1
+    };
+
+    struct Salida {
+        CodigoAviso codigo;
+        GrupoRegla grupo;
+        VariableHAL parametro;
+    };
+
+    struct NivelCompilado {
+        std::vector<Eje> ejes;         // Solo las variables que se miran
+        std::vector<Salida> salidas;   // Por número de regla
+        Mascara todas;
+        std::array<Mascara, NUMERO_GRUPOS> grupos;
+    };
+
+    std::array<NivelCompilado, MAX_NIVEL + 1> niveles;
+    std::size_t descartadas;
+
+    void compilar(int nivel, const std::vector<ReglaHAL>& reglas);
+
+public:
+    // Si a un nivel le tocan más de MAX_REGLAS se quedan las de mayor
+    // prioridad
+    explicit MotorReglasHAL(const std::vector<ReglaHAL>& reglas);
+
+    DecisionHAL evaluar(int nivel, const ValoresHAL& valores) const;
+    // Reglas que no entraron (sumando todos los niveles)
+    std::size_t obtenerDescartadas() const;
+
+    // Compilado una vez a partir de reglasPredeterminadasHAL()
+    static const MotorReglasHAL& compartido();
+};
+
+#endif // REGLASHAL_H
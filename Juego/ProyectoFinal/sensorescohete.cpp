@@ -0,0 +1,216 @@
+#include "sensorescohete.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Cuánto puede cambiar lo que el filtro no modela (el arrastre) y el consumo
+// real respecto del pedido, por raíz de segundo
+constexpr double DERIVA_ACELERACION = 2.0; // m/s²
+constexpr double DERIVA_COMBUSTIBLE = 1.0; // kg
+// Cuánto se aparta la altura del integrador de la partida (Euler
+// semiimplícito, masa que baja) del modelo de aceleración constante por
+// período, por raíz de segundo
+constexpr double DERIVA_ALTURA = 3.0; // m/s
+
+enum Componente : std::size_t { ALTURA, VELOCIDAD, ACELERACION, COMBUSTIBLE };
+
+} // namespace
+
+SensoresCohete::SensoresCohete(const ConfiguracionSensores& config)
+    : configuracion(config),
+    H(),
+    R(),
+    masaSeca(0.0),
+    combustibleMaximo(0.0),
+    siguienteFusion(0),
+    ultimaLectura(0),
+    tiempoFiltro(0.0),
+    duracionPeriodo(0.0),
+    impulso(0.0),
+    consumido(0.0),
+    gravedad(0.0),
+    calibrado(false) {
+    configuracion.latencia = std::clamp(configuracion.latencia, 0, MAX_LATENCIA);
+    configuracion.periodo = std::max(configuracion.periodo, 1e-3);
+
+    // Se miden altura, velocidad y combustible, no la aceleración no modelada
+    H[0][ALTURA] = 1.0;
+    H[1][VELOCIDAD] = 1.0;
+    H[2][COMBUSTIBLE] = 1.0;
+    R[0][0] = configuracion.ruidoAltura * configuracion.ruidoAltura;
+    R[1][1] = configuracion.ruidoVelocidad * configuracion.ruidoVelocidad;
+    R[2][2] = configuracion.ruidoCombustible * configuracion.ruidoCombustible;
+}
+
+void SensoresCohete::reiniciar() {
+    calibrado = false;
+}
+
+std::uint64_t SensoresCohete::numeroLectura(double tiempo) const {
+    // El margen absorbe el error de sumar muchos pasos de física
+    return static_cast<std::uint64_t>(std::floor(std::max(0.0, tiempo) / configuracion.periodo + 1e-6));
+}
+
+SensoresCohete::Filtro::Medida SensoresCohete::medir(const Cohete& real, std::uint64_t numero) const {
+    GeneradorSplitMix ruido(configuracion.semilla, numero);
+    return {real.obtenerAltura() + configuracion.ruidoAltura * ruido.normal(),
+            real.obtenerVelocidad() + configuracion.ruidoVelocidad * ruido.normal(),
+            real.obtenerCombustible() + configuracion.ruidoCombustible * ruido.normal()};
+}
+
+void SensoresCohete::calibrar(const Cohete& real, double tiempo) {
+    masaSeca = real.obtenerMasaSeca();
+    combustibleMaximo = real.obtenerCombustibleMaximo();
+
+    // Se parte de una lectura, no del estado real, y con su incertidumbre
+    ultimaLectura = numeroLectura(tiempo);
+    const Filtro::Medida medida = medir(real, ultimaLectura);
+    Filtro::Matriz P{};
+    P[ALTURA][ALTURA] = R[0][0];
+    P[VELOCIDAD][VELOCIDAD] = R[1][1];
+    P[ACELERACION][ACELERACION] = 4.0;
+    P[COMBUSTIBLE][COMBUSTIBLE] = R[2][2];
+    filtro.iniciar({medida[0], medida[1], 0.0, std::clamp(medida[2], 0.0, combustibleMaximo)}, P);
+
+    enCamino.limpiar();
+    siguienteFusion = 0;
+    tiempoFiltro = tiempo;
+    duracionPeriodo = 0.0;
+    impulso = 0.0;
+    consumido = 0.0;
+    calibrado = true;
+    estimar();
+}
+
+bool SensoresCohete::observar(const Cohete& real, double tiempo, double paso,
+                              double empuje, double consumo, double gravedadLocal) {
+    // El primer paso deja el cohete donde empieza el nivel (el nivel 3 lo
+    // coloca recién ahí)
+    if (!calibrado) {
+        calibrar(real, tiempo);
+        return true;
+    }
+
+    duracionPeriodo += paso;
+    impulso += empuje * paso;
+    consumido += consumo * paso;
+    gravedad = gravedadLocal;
+
+    const std::uint64_t numero = numeroLectura(tiempo);
+    if (numero <= ultimaLectura) return false;
+
+    ultimaLectura = numero;
+    leer(real, numero);
+    estimar();
+    return true;
+}
+
+void SensoresCohete::leer(const Cohete& real, std::uint64_t numero) {
+    Lectura lectura;
+    lectura.medida = medir(real, numero);
+    lectura.duracion = duracionPeriodo;
+    lectura.empuje = impulso / duracionPeriodo;
+    lectura.consumo = consumido / duracionPeriodo;
+    lectura.gravedad = gravedad;
+    enCamino.agregar(lectura);
+
+    duracionPeriodo = 0.0;
+    impulso = 0.0;
+    consumido = 0.0;
+}
+
+void SensoresCohete::modelo(const Lectura& lectura, const Filtro::Vector& x, double masaSeca,
+                            Filtro::Matriz& F, Filtro::Vector& u) {
+    const double T = lectura.duracion;
+    // La masa sale del combustible estimado: el filtro no conoce el real
+    const double masa = masaSeca + std::max(0.0, x[COMBUSTIBLE]);
+    const double a = (masa > 0.0 ? lectura.empuje / masa : 0.0) - lectura.gravedad;
+
+    F = Filtro::Matriz{};
+    F[ALTURA] = {1.0, T, 0.5 * T * T, 0.0};
+    F[VELOCIDAD] = {0.0, 1.0, T, 0.0};
+    F[ACELERACION][ACELERACION] = 1.0;
+    F[COMBUSTIBLE][COMBUSTIBLE] = 1.0;
+    u = {0.5 * a * T * T, a * T, 0.0, -lectura.consumo * T};
+}
+
+void SensoresCohete::ruidoProceso(double T, Filtro::Matriz& Q) {
+    // Aceleración no modelada como paseo aleatorio integrado dos veces,
+    // más un paseo aleatorio propio de la altura
+    const double qa = DERIVA_ACELERACION * DERIVA_ACELERACION;
+    Q = Filtro::Matriz{};
+    Q[ALTURA][ALTURA] = qa * T * T * T * T * T / 20.0 + DERIVA_ALTURA * DERIVA_ALTURA * T;
+    Q[ALTURA][VELOCIDAD] = Q[VELOCIDAD][ALTURA] = qa * T * T * T * T / 8.0;
+    Q[ALTURA][ACELERACION] = Q[ACELERACION][ALTURA] = qa * T * T * T / 6.0;
+    Q[VELOCIDAD][VELOCIDAD] = qa * T * T * T / 3.0;
+    Q[VELOCIDAD][ACELERACION] = Q[ACELERACION][VELOCIDAD] = qa * T * T / 2.0;
+    Q[ACELERACION][ACELERACION] = qa * T;
+    Q[COMBUSTIBLE][COMBUSTIBLE] = DERIVA_COMBUSTIBLE * DERIVA_COMBUSTIBLE * T;
+}
+
+void SensoresCohete::estimar() {
+    Filtro::Matriz F;
+    Filtro::Vector u;
+    Filtro::Matriz Q;
+
+    // Se fusionan, en el instante en que se tomaron, las lecturas que ya
+    // tienen 'latencia' lecturas detrás
+    const std::uint64_t latencia = static_cast<std::uint64_t>(configuracion.latencia);
+    while (enCamino.obtenerTotal() - siguienteFusion > latencia) {
+        const Lectura& lectura = enCamino.obtener(siguienteFusion++);
+
+        ruidoProceso(lectura.duracion, Q);
+        modelo(lectura, filtro.obtenerEstado(), masaSeca, F, u);
+        filtro.predecir(F, u, Q);
+        filtro.corregir(lectura.medida, H, R);
+        filtro.establecerComponente(COMBUSTIBLE,
+            std::clamp(filtro.obtenerEstado()[COMBUSTIBLE], 0.0, combustibleMaximo));
+        tiempoFiltro += lectura.duracion;
+    }
+
+    // Las que siguen en camino solo adelantan el estado con su empuje; la
+    // covarianza crece con ellas, así que los desvíos valen para 'tiempo'
+    Filtro adelantado = filtro;
+    double tiempo = tiempoFiltro;
+    for (std::uint64_t i = siguienteFusion; i < enCamino.obtenerTotal(); ++i) {
+        const Lectura& lectura = enCamino.obtener(i);
+        modelo(lectura, adelantado.obtenerEstado(), masaSeca, F, u);
+        ruidoProceso(lectura.duracion, Q);
+        adelantado.predecir(F, u, Q);
+        tiempo += lectura.duracion;
+    }
+
+    const Filtro::Vector& x = adelantado.obtenerEstado();
+    const Filtro::Matriz& P = adelantado.obtenerCovarianza();
+    estimacion.tiempo = tiempo;
+    estimacion.altura = std::max(0.0, x[ALTURA]);
+    estimacion.velocidad = x[VELOCIDAD];
+    estimacion.combustible = std::clamp(x[COMBUSTIBLE], 0.0, combustibleMaximo);
+    estimacion.aceleracionNoModelada = x[ACELERACION];
+    estimacion.desvioAltura = std::sqrt(std::max(0.0, P[ALTURA][ALTURA]));
+    estimacion.desvioVelocidad = std::sqrt(std::max(0.0, P[VELOCIDAD][VELOCIDAD]));
+    estimacion.desvioCombustible = std::sqrt(std::max(0.0, P[COMBUSTIBLE][COMBUSTIBLE]));
+}
+
+bool SensoresCohete::estaCalibrado() const {
+    return calibrado;
+}
+
+const EstimacionCohete& SensoresCohete::obtenerEstimacion() const {
+    return estimacion;
+}
+
+Cohete SensoresCohete::percibir(const Cohete& real) const {
+    Cohete percibido = real;
+    if (calibrado) {
+        percibido.establecerAltura(estimacion.altura);
+        percibido.establecerVelocidad(estimacion.velocidad);
+        percibido.establecerCombustible(estimacion.combustible);
+    }
+    return percibido;
+}
+
+const ConfiguracionSensores& SensoresCohete::obtenerConfiguracion() const {
+    return configuracion;
+}
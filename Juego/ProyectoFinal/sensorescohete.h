@@ -0,0 +1,111 @@
+#ifndef SENSORESCOHETE_H
+#define SENSORESCOHETE_H
+
+#include <cstdint>
+#include "buffercircular.h"
+#include "cohete.h"
+#include "filtrokalman.h"
+#include "generadorsplitmix.h"
+
+struct ConfiguracionSensores {
+    double periodo = 0.05;           // s entre lecturas
+    double ruidoAltura = 5.0;        // m (desvío estándar)
+    double ruidoVelocidad = 0.5;     // m/s
+    double ruidoCombustible = 25.0;  // kg
+    int latencia = 4;                // Lecturas de retraso (hasta SensoresCohete::MAX_LATENCIA)
+    std::uint64_t semilla = 1;
+};
+
+// Lo que el filtro cree del cohete en 'tiempo'
+struct EstimacionCohete {
+    double tiempo = 0.0;
+    double altura = 0.0;
+    double velocidad = 0.0;
+    double combustible = 0.0;
+    double aceleracionNoModelada = 0.0; // m/s² que no explican empuje ni gravedad (arrastre)
+
+    // Desvíos estándar en 'tiempo', con lo que se adelantó sin lecturas
+    double desvioAltura = 0.0;
+    double desvioVelocidad = 0.0;
+    double desvioCombustible = 0.0;
+};
+
+// Sensores simulados de altura, velocidad y combustible: en cada múltiplo
+// de 'periodo' leen el estado real con ruido gaussiano y la lectura llega
+// 'latencia' períodos después. El ruido de cada lectura sale solo de la
+// semilla y de su número, así un tramo rebobinado vuelve a ver las mismas
+// lecturas. Un filtro de Kalman de 4 estados (altura, velocidad,
+// aceleración no modelada y combustible) fusiona cada lectura en el
+// instante en que se tomó, usando el empuje pedido en ese período, y
+// después se adelanta sin corregir con los empujes de los períodos que la
+// lectura tardó en llegar. El costo por lectura es fijo y no hay memoria
+// dinámica.
+class SensoresCohete {
+public:
+    static constexpr int MAX_LATENCIA = 15;
+
+private:
+    using Filtro = FiltroKalman<4, 3>;
+
+    // Una lectura en camino con lo que se sabía del período que cubre
+    struct Lectura {
+        Filtro::Medida medida;  // Altura, velocidad y combustible con ruido
+        double duracion;        // s del período
+        double empuje;          // N medio pedido en el período
+        double consumo;         // kg/s medio que implica ese empuje
+        double gravedad;        // m/s²
+    };
+
+    ConfiguracionSensores configuracion;
+    Filtro filtro;
+    Filtro::Observacion H;
+    Filtro::RuidoMedida R;
+    double masaSeca;
+    double combustibleMaximo;
+
+    BufferCircular<Lectura, MAX_LATENCIA + 1> enCamino;
+    std::uint64_t siguienteFusion; // Primera lectura en camino sin fusionar
+    std::uint64_t ultimaLectura;   // Número (tiempo / periodo) de la última tomada
+    double tiempoFiltro;           // Instante del estado del filtro
+
+    // Período en curso
+    double duracionPeriodo;
+    double impulso;     // N·s
+    double consumido;   // kg
+    double gravedad;
+
+    EstimacionCohete estimacion;
+    bool calibrado;
+
+    // Transición y entrada conocida de un período de 'lectura' desde 'x'
+    static void modelo(const Lectura& lectura, const Filtro::Vector& x, double masaSeca,
+                       Filtro::Matriz& F, Filtro::Vector& u);
+    // Ruido de proceso de un período de T segundos
+    static void ruidoProceso(double T, Filtro::Matriz& Q);
+    std::uint64_t numeroLectura(double tiempo) const;
+    Filtro::Medida medir(const Cohete& real, std::uint64_t numero) const;
+    void calibrar(const Cohete& real, double tiempo);
+    void leer(const Cohete& real, std::uint64_t numero);
+    void estimar();
+
+public:
+    explicit SensoresCohete(const ConfiguracionSensores& configuracion = ConfiguracionSensores());
+
+    // Descarta lo estimado: la próxima observación calibra el filtro con
+    // una lectura de ese momento, con el ruido de la configuración
+    void reiniciar();
+
+    // Un paso de física que terminó en 'tiempo'. 'empuje' y 'consumo' son
+    // los pedidos durante el paso; 'gravedad' la del nivel a la altura
+    // estimada. Devuelve true si cambió la estimación.
+    bool observar(const Cohete& real, double tiempo, double paso,
+                  double empuje, double consumo, double gravedad);
+
+    bool estaCalibrado() const;
+    const EstimacionCohete& obtenerEstimacion() const;
+    // Copia de 'real' con la altura, la velocidad y el combustible estimados
+    Cohete percibir(const Cohete& real) const;
+    const ConfiguracionSensores& obtenerConfiguracion() const;
+};
+
+#endif // SENSORESCOHETE_H
@@ -0,0 +1,272 @@
+#include "simulacionconcurrente.h"
+
+SimulacionConcurrente::SimulacionConcurrente(double pasoFisica, double periodoPublicacion)
+    : periodo(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::duration<double>(periodoPublicacion))),
+    activa(true),
+    tiempoAlternativas(0.0),
+    versionControles(0),
+    comandosEnviados(0),
+    comandosAtendidos(0) {
+    juego.establecerPasoFisica(pasoFisica);
+    // Con aceleración de tiempo el hilo usa como mucho 3/4 de cada periodo
+    // para que las órdenes se sigan atendiendo a tiempo
+    juego.establecerPresupuestoTiempoReal(0.75 * periodoPublicacion);
+    juego.establecerRebobinado(true);
+    // HAL analiza en su propio hilo (ver TrabajadorHAL)
+    juego.establecerHALAsincrono(true);
+
+    // Estado inicial visible antes de que arranque el hilo
+    publicar();
+    instantaneas.actualizarLectura();
+
+    hilo = std::thread(&SimulacionConcurrente::bucle, this);
+}
+
+SimulacionConcurrente::~SimulacionConcurrente() {
+    activa.store(false, std::memory_order_release);
+    if (hilo.joinable()) {
+        hilo.join();
+    }
+}
+
+unsigned long long SimulacionConcurrente::enviar(TipoComando tipo, double valor) {
+    // Con la cola llena se cede el turno hasta que la simulación la vacíe;
+    // perder una pausa o un reinicio sería peor que esperar unos microsegundos
+    while (!comandos.encolar({tipo, valor})) {
+        std::this_thread::yield();
+    }
+    return ++comandosEnviados;
+}
+
+bool SimulacionConcurrente::actualizarInstantanea() {
+    return instantaneas.actualizarLectura();
+}
+
+const InstantaneaJuego& SimulacionConcurrente::obtenerInstantanea() const {
+    return instantaneas.obtenerLectura();
+}
+
+const InstantaneaJuego& SimulacionConcurrente::esperarComando(unsigned long long numero) {
+    while (instantaneas.actualizarLectura(), obtenerInstantanea().comandosAtendidos < numero) {
+        std::this_thread::yield();
+    }
+    return obtenerInstantanea();
+}
+
+void SimulacionConcurrente::bucle() {
+    using Reloj = std::chrono::steady_clock;
+
+    Reloj::time_point ultimo = Reloj::now();
+    Reloj::time_point siguiente = ultimo;
+    bool corriaAntes = false;
+
+    while (activa.load(std::memory_order_acquire)) {
+        bool cambios = false;
+        ComandoJuego comando;
+        while (comandos.desencolar(comando)) {
+            aplicarComando(comando);
+            ++comandosAtendidos;
+            cambios = true;
+        }
+
+        if (explorador.estaLista()) {
+            recogerAlternativas();
+            cambios = true;
+        }
+
+        // Al iniciar o reanudar no se cuenta el tiempo que estuvo detenida
+        const Reloj::time_point ahora = Reloj::now();
+        const double segundosReales = corriaAntes
+            ? std::chrono::duration<double>(ahora - ultimo).count() : 0.0;
+        ultimo = ahora;
+
+        const bool corriendo = juego.estaEnEjecucion() && !juego.estaPausado();
+        if (corriendo) {
+            juego.avanzarTiempoReal(segundosReales);
+        }
+        corriaAntes = corriendo;
+
+        if (trabajadorHAL.estaLista() && recogerAvisosHAL()) {
+            cambios = true;
+        }
+
+        if (predictor.actualizar(juego, versionControles)) {
+            cambios = true;
+        }
+
+        if (corriendo || cambios) {
+            publicar();
+        }
+
+        siguiente += periodo;
+        if (siguiente < ahora) {
+            siguiente = ahora + periodo; // No acumular atrasos
+        }
+        std::this_thread::sleep_until(siguiente);
+    }
+}
+
+void SimulacionConcurrente::aplicarComando(const ComandoJuego& comando) {
+    const double empujeAntes = juego.obtenerCohete() ? juego.obtenerCohete()->obtenerEmpuje() : 0.0;
+
+    // Al cambiar de nivel, reiniciar o rebobinar se borra la previsión que
+    // se ve: es de otro vuelo y no debe quedar hasta que llegue la nueva
+    switch (comando.tipo) {
+    case TipoComando::IniciarNivel:
+        descartarAlternativas();
+        predictor.descartar();
+        juego.iniciarNivel(static_cast<int>(comando.valor));
+        break;
+    case TipoComando::IniciarNivelDesdeVictoria:
+        descartarAlternativas();
+        predictor.descartar();
+        juego.iniciarNivelDesdeVictoria(static_cast<int>(comando.valor));
+        break;
+    case TipoComando::EstablecerVelocidadInicial:
+        juego.establecerVelocidadInicial(comando.valor);
+        break;
+    case TipoComando::IniciarSimulacion:
+        juego.iniciarSimulacion();
+        break;
+    case TipoComando::Pausar:
+        juego.pausar();
+        break;
+    case TipoComando::Reanudar:
+        juego.reanudar();
+        break;
+    case TipoComando::ReiniciarNivel:
+        descartarAlternativas();
+        predictor.descartar();
+        juego.reiniciarNivel();
+        break;
+    case TipoComando::AjustarEmpuje:
+        juego.ajustarEmpuje(comando.valor);
+        break;
+    case TipoComando::MoverHorizontal:
+        juego.moverCoheteHorizontal(comando.valor);
+        break;
+    case TipoComando::EstablecerFactorTiempo:
+        juego.establecerFactorTiempo(comando.valor);
+        break;
+    case TipoComando::Rebobinar:
+        descartarAlternativas();
+        predictor.descartar();
+        juego.rebobinarA(static_cast<long>(comando.valor));
+        break;
+    case TipoComando::ExplorarEmpujes:
+        explorarEmpujes(comando.valor);
+        break;
+    case TipoComando::EstablecerSensores:
+        juego.establecerSensores(comando.valor != 0.0);
+        break;
+    }
+
+    // Todo lo que no sea pausar o cambiar el ritmo invalida la previsión.
+    // Un empuje que queda igual (tecla mantenida en el tope, el deslizador
+    // que repite el valor) no cambia nada.
+    const bool mismoEmpuje = comando.tipo == TipoComando::AjustarEmpuje &&
+                             juego.obtenerCohete() && juego.obtenerCohete()->obtenerEmpuje() == empujeAntes;
+    if (comando.tipo != TipoComando::Pausar && comando.tipo != TipoComando::Reanudar &&
+        comando.tipo != TipoComando::EstablecerFactorTiempo &&
+        comando.tipo != TipoComando::ExplorarEmpujes && !mismoEmpuje) {
+        ++versionControles;
+    }
+}
+
+void SimulacionConcurrente::publicar() {
+    InstantaneaJuego& instantanea = instantaneas.obtenerEscritura();
+    const Nivel* nivel = juego.obtenerNivel();
+    const int numeroNivel = juego.obtenerNivelActual();
+
+    // La descripción solo depende del nivel: se copia cuando cambia
+    if (instantanea.nivel != numeroNivel || instantanea.descripcionNivel.empty()) {
+        instantanea.descripcionNivel = nivel ? nivel->obtenerDescripcion() : std::string();
+    }
+
+    instantanea.comandosAtendidos = comandosAtendidos;
+    instantanea.nivel = numeroNivel;
+    instantanea.enEjecucion = juego.estaEnEjecucion();
+    instantanea.pausado = juego.estaPausado();
+    instantanea.victoria = juego.haGanado();
+    instantanea.derrota = juego.haPerdido();
+    instantanea.tiempoSimulacion = juego.obtenerTiempoSimulacion();
+    instantanea.factorInterpolacion = juego.obtenerFactorInterpolacion();
+    instantanea.alturaObjetivo = nivel ? nivel->obtenerAlturaObjetivo() : 0.0;
+    instantanea.factorTiempo = juego.obtenerFactorTiempo();
+    instantanea.factorTiempoEfectivo = juego.obtenerFactorTiempoEfectivo();
+    instantanea.aceleracionInterrumpida = juego.seInterrumpioAceleracion();
+    instantanea.pasoActual = juego.obtenerPasoActual();
+    instantanea.pasoMinimoRebobinado = juego.obtenerPasoMinimoRebobinado();
+    instantanea.pasoMaximoRebobinado = juego.obtenerPasoMaximoRebobinado();
+    instantanea.cohete = *juego.obtenerCohete();
+    instantanea.coheteAnterior = *juego.obtenerCoheteAnterior();
+    instantanea.cohetePercibido = juego.obtenerCohetePercibido();
+    instantanea.conSensores = juego.tieneSensores();
+    instantanea.autopiloto = juego.calcularConsignaAutopiloto();
+    instantanea.prevision = predictor.obtenerPuntos();
+    instantanea.marcasPrevision = predictor.obtenerMarcas();
+
+    instantanea.explorandoAlternativas = explorador.hayExploracion();
+    instantanea.tiempoAlternativas = tiempoAlternativas;
+    instantanea.alternativas = alternativas;
+
+    if (instantanea.derrota) {
+        instantanea.razonDerrota = juego.obtenerRazonDerrota();
+    } else {
+        instantanea.razonDerrota.clear();
+    }
+
+    // HAL evalúa este mismo estado en su hilo; lo que diga llega en una
+    // publicación posterior. Si sigue con la anterior, esta se saltea.
+    const double reloj = std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    trabajadorHAL.lanzar(juego, versionControles, reloj);
+    instantanea.avisosHAL = avisosHAL;
+
+    instantaneas.publicar();
+}
+
+bool SimulacionConcurrente::recogerAvisosHAL() {
+    trabajadorHAL.recoger(juego, versionControles, avisosRecogidos);
+
+    for (std::uint64_t i = avisosRecogidos.obtenerPrimero(); i < avisosRecogidos.obtenerTotal(); ++i) {
+        const AvisoHAL& aviso = avisosRecogidos.obtener(i);
+        if (canalDe(aviso.codigo) == CanalAviso::Consola) {
+            juego.imprimirAvisoHAL(aviso);
+        }
+        avisosHAL.agregar(aviso);
+    }
+    return avisosRecogidos.obtenerTotal() > 0;
+}
+
+void SimulacionConcurrente::explorarEmpujes(double empujeReferencia) {
+    if (!juego.estaEnEjecucion() || juego.haGanado() || juego.haPerdido()) return;
+
+    // Cada copia sigue con el empuje fijo desde ahora; la partida en vivo
+    // no se detiene mientras tanto
+    std::vector<ProgramaEmpuje> programas;
+    empujesExplorados.clear();
+    for (double factor : FACTORES_EXPLORACION) {
+        empujesExplorados.push_back(factor * empujeReferencia);
+        programas.emplace_back(empujesExplorados.back());
+    }
+    explorador.lanzar(juego, programas);
+}
+
+void SimulacionConcurrente::recogerAlternativas() {
+    const std::vector<ResultadoMision>& resultados = explorador.obtenerResultados();
+
+    alternativas.resize(resultados.size());
+    for (std::size_t i = 0; i < resultados.size(); ++i) {
+        alternativas[i].empuje = empujesExplorados[i];
+        alternativas[i].resultado = resultados[i];
+    }
+    tiempoAlternativas = explorador.obtenerTiempoOrigen();
+    explorador.descartar();
+}
+
+void SimulacionConcurrente::descartarAlternativas() {
+    explorador.descartar();
+    alternativas.clear();
+}
@@ -0,0 +1,139 @@
+#ifndef SIMULACIONCONCURRENTE_H
+#define SIMULACIONCONCURRENTE_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "avisoshal.h"
+#include "buffertriple.h"
+#include "cohete.h"
+#include "colaspsc.h"
+#include "ejecutorlotes.h"
+#include "exploradoralternativas.h"
+#include "juego.h"
+#include "predictortrayectoria.h"
+#include "trabajadorhal.h"
+
+// Órdenes de la interfaz al hilo de simulación
+enum class TipoComando {
+    IniciarNivel,               // valor: número de nivel
+    IniciarNivelDesdeVictoria,  // valor: número de nivel
+    EstablecerVelocidadInicial, // valor: m/s
+    IniciarSimulacion,
+    Pausar,
+    Reanudar,
+    ReiniciarNivel,
+    AjustarEmpuje,              // valor: empuje en N
+    MoverHorizontal,            // valor: cambio de velocidad horizontal
+    EstablecerFactorTiempo,     // valor: segundos simulados por segundo real
+    Rebobinar,                  // valor: paso de física al que volver
+    ExplorarEmpujes,            // valor: empuje de referencia en N
+    EstablecerSensores          // valor: 1 sensores con ruido, 0 estado exacto
+};
+
+struct ComandoJuego {
+    TipoComando tipo;
+    double valor;
+};
+
+// Cómo terminaría la partida si desde el instante explorado se dejara el
+// empuje fijo en 'empuje'
+struct AlternativaEmpuje {
+    double empuje;
+    ResultadoMision resultado;
+};
+
+// Copia inmutable del estado que necesita la interfaz para un frame. Las
+// cadenas se reasignan sobre la misma copia, así que tras los primeros frames
+// publicar no reserva memoria.
+struct InstantaneaJuego {
+    unsigned long long comandosAtendidos = 0; // Comandos aplicados antes de publicarla
+    int nivel = 0;
+    bool enEjecucion = false;
+    bool pausado = false;
+    bool victoria = false;
+    bool derrota = false;
+    double tiempoSimulacion = 0.0;
+    double factorInterpolacion = 1.0;
+    double alturaObjetivo = 0.0;
+    double factorTiempo = 1.0;
+    double factorTiempoEfectivo = 1.0;
+    bool aceleracionInterrumpida = false;
+    long pasoActual = 0;
+    long pasoMinimoRebobinado = -1; // -1: no hay historial
+    long pasoMaximoRebobinado = -1;
+    bool explorandoAlternativas = false;
+    double tiempoAlternativas = 0.0;             // Instante desde el que se exploraron
+    std::vector<AlternativaEmpuje> alternativas; // Última exploración terminada
+    ConsignaAlunizaje autopiloto;                // Recomendación para el nivel 3
+    std::vector<PuntoPrevisto> prevision;        // Niveles 2 y 3: con los controles como están
+    std::vector<MarcaPrevision> marcasPrevision;
+    Cohete cohete;
+    Cohete coheteAnterior;
+    Cohete cohetePercibido; // Con sensores, la estimación que usan HAL y el piloto
+    bool conSensores = false;
+    std::string descripcionNivel;
+    std::string razonDerrota;
+    HistorialAvisos avisosHAL; // Consejos e informes de HAL, por número de secuencia
+};
+
+// Ejecuta Juego en su propio hilo. La interfaz le manda órdenes por una cola
+// sin bloqueos y lee el último estado publicado de un buffer triple, así que
+// un repintado lento o un diálogo modal no frenan la física y la física nunca
+// deja un frame a medio actualizar. Desde fuera, solo un hilo (el de la
+// interfaz) debe enviar órdenes y leer instantáneas.
+class SimulacionConcurrente {
+private:
+    Juego juego; // Solo lo toca el hilo de simulación
+    ColaSPSC<ComandoJuego, 256> comandos;
+    BufferTriple<InstantaneaJuego> instantaneas;
+    std::chrono::nanoseconds periodo;
+    std::atomic<bool> activa;
+    ExploradorAlternativas explorador;
+    std::vector<double> empujesExplorados;        // De la exploración en curso
+    std::vector<AlternativaEmpuje> alternativas;  // Lado de la simulación
+    double tiempoAlternativas;
+    PredictorTrayectoria predictor;
+    TrabajadorHAL trabajadorHAL;
+    TrabajadorHAL::AvisosNuevos avisosRecogidos;
+    HistorialAvisos avisosHAL;            // Lo que HAL ya dijo, para la instantánea
+    unsigned long long versionControles;  // Cambia con cada orden que altera la partida
+    unsigned long long comandosEnviados;  // Lado de la interfaz
+    unsigned long long comandosAtendidos; // Lado de la simulación
+    std::thread hilo;
+
+    void bucle();
+    void aplicarComando(const ComandoJuego& comando);
+    void publicar();
+    void explorarEmpujes(double empujeReferencia);
+    void recogerAlternativas();
+    void descartarAlternativas();
+    bool recogerAvisosHAL();
+
+public:
+    // Múltiplos del empuje de referencia que prueba ExplorarEmpujes
+    static constexpr double FACTORES_EXPLORACION[] = {0.0, 0.5, 0.75, 1.0, 1.25, 1.5, 2.0};
+
+    // 'periodoPublicacion': cada cuánto despierta el hilo para avanzar la
+    // física y publicar (en segundos reales)
+    explicit SimulacionConcurrente(double pasoFisica, double periodoPublicacion = 0.002);
+    ~SimulacionConcurrente();
+
+    SimulacionConcurrente(const SimulacionConcurrente&) = delete;
+    SimulacionConcurrente& operator=(const SimulacionConcurrente&) = delete;
+
+    // Devuelve el número de la orden, para esperarComando
+    unsigned long long enviar(TipoComando tipo, double valor = 0.0);
+
+    // true si había una instantánea nueva
+    bool actualizarInstantanea();
+    const InstantaneaJuego& obtenerInstantanea() const;
+
+    // Espera a que se publique un estado que ya incluya la orden 'numero'.
+    // Solo la interfaz espera; el hilo de simulación nunca se detiene.
+    const InstantaneaJuego& esperarComando(unsigned long long numero);
+};
+
+#endif // SIMULACIONCONCURRENTE_H
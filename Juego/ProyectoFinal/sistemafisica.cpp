@@ -1,22 +1,6 @@
-#include "SistemaFisica.h"
+#include "sistemafisica.h"
 #include <cmath>
-
-double SistemaFisica::calcularGravedad(double altura, double masa, bool esTierra) {
-    double masaCuerpo = esTierra ? MASA_TIERRA : MASA_LUNA;
-    double radioCuerpo = esTierra ? RADIO_TIERRA : RADIO_LUNA;
-
-    double distancia = radioCuerpo + altura;
-    return (G * masaCuerpo * masa) / (distancia * distancia);
-}
-
-double SistemaFisica::calcularAceleracionGravedad(double altura, bool esTierra) {
-    double masaCuerpo = esTierra ? MASA_TIERRA : MASA_LUNA;
-    double radioCuerpo = esTierra ? RADIO_TIERRA : RADIO_LUNA;
-
-    // g = G * M / r²
-    double distancia = radioCuerpo + altura;
-    return (G * masaCuerpo) / (distancia * distancia);
-}
+#include "modeloambiental.h"
 
 double SistemaFisica::calcularResistenciaAire(double velocidad, double densidad,
                                               double area, double coeficienteArrastre) {
@@ -25,12 +9,12 @@ double SistemaFisica::calcularResistenciaAire(double velocidad, double densidad,
 
 double SistemaFisica::calcularDensidadAtmosferica(double altura) {
     const double densidadNivelMar = 1.225;
-    const double alturaEscala = 8500.0;
 
+    // Misma atmósfera que usan los niveles (altura de escala de 10 km)
     if (altura < 0) altura = 0;
-    if (altura > 100000) return 0.0;
+    if (altura > ModeloAmbiental::ALTURA_ATMOSFERA) return 0.0;
 
-    return densidadNivelMar * std::exp(-altura / alturaEscala);
+    return densidadNivelMar * ModeloAmbiental::factorDensidad(altura);
 }
 
 double SistemaFisica::calcularEmpujeNeto(double empuje, double gravedad,
@@ -47,19 +31,3 @@ double SistemaFisica::calcularNuevaAltura(double alturaActual, double velocidad,
                                           double aceleracion, double tiempo) {
     return alturaActual + velocidad * tiempo + 0.5 * aceleracion * tiempo * tiempo;
 }
-
-double SistemaFisica::calcularVelocidadOrbital(double altura, bool esTierra) {
-    double masaCuerpo = esTierra ? MASA_TIERRA : MASA_LUNA;
-    double radioCuerpo = esTierra ? RADIO_TIERRA : RADIO_LUNA;
-
-    double distancia = radioCuerpo + altura;
-    return std::sqrt((G * masaCuerpo) / distancia);
-}
-
-double SistemaFisica::calcularVelocidadEscape(double altura, bool esTierra) {
-    double masaCuerpo = esTierra ? MASA_TIERRA : MASA_LUNA;
-    double radioCuerpo = esTierra ? RADIO_TIERRA : RADIO_LUNA;
-
-    double distancia = radioCuerpo + altura;
-    return std::sqrt((2.0 * G * masaCuerpo) / distancia);
-}
@@ -1,17 +1,38 @@
 #ifndef SISTEMAFISICA_H
 #define SISTEMAFISICA_H
 
+#include <algorithm>
+#include <cmath>
+#include "cuerpoceleste.h"
+
+// Estado vertical del cohete que avanzan los integradores
+struct EstadoDinamico {
+    double altura;
+    double velocidad;
+    double combustible;
+};
+
+enum class TipoIntegrador {
+    Euler,          // Actualización explícita original de cada nivel
+    RK4,            // Runge-Kutta clásico de orden 4
+    VelocityVerlet, // Verlet de velocidad con predicción de la velocidad
+    DormandPrince   // Runge-Kutta adaptativo de orden 5(4)
+};
+
 class SistemaFisica {
 public:
-    static constexpr double G = 6.67430e-11;
-    static constexpr double MASA_TIERRA = 5.972e24;
-    static constexpr double RADIO_TIERRA = 6371000.0;
-    static constexpr double MASA_LUNA = 7.342e22;
-    static constexpr double RADIO_LUNA = 1737000.0;
+    static constexpr double G = CuerpoCeleste<Tierra>::G;
 
-    static double calcularGravedad(double altura, double masa, bool esTierra = true);
+    // El cuerpo (Tierra, Luna...) se elige en compilación
+    template<class Cuerpo>
+    static double calcularGravedad(double altura, double masa) {
+        return CuerpoCeleste<Cuerpo>::fuerzaGravedad(altura, masa);
+    }
 
-    static double calcularAceleracionGravedad(double altura, bool esTierra = true);
+    template<class Cuerpo>
+    static double calcularAceleracionGravedad(double altura) {
+        return CuerpoCeleste<Cuerpo>::aceleracionGravedad(altura);
+    }
 
     static double calcularResistenciaAire(double velocidad, double densidad,
                                           double area = 10.0,
@@ -29,9 +50,230 @@ public:
     static double calcularNuevaAltura(double alturaActual, double velocidad,
                                       double aceleracion, double tiempo);
 
-    static double calcularVelocidadOrbital(double altura, bool esTierra = true);
+    template<class Cuerpo>
+    static double calcularVelocidadOrbital(double altura) {
+        return CuerpoCeleste<Cuerpo>::velocidadOrbital(altura);
+    }
+
+    template<class Cuerpo>
+    static double calcularVelocidadEscape(double altura) {
+        return CuerpoCeleste<Cuerpo>::velocidadEscape(altura);
+    }
+
+    // Integradores. 'f' devuelve la derivada del estado (dh/dt, dv/dt,
+    // dcombustible/dt) combinando empuje, gravedad y resistencia; cada
+    // método la evalúa una sola vez por etapa.
+    template<class Derivada>
+    static EstadoDinamico pasoEuler(const Derivada& f, const EstadoDinamico& y, double h);
+
+    template<class Derivada>
+    static EstadoDinamico pasoRK4(const Derivada& f, const EstadoDinamico& y, double h);
+
+    template<class Derivada>
+    static EstadoDinamico pasoVelocityVerlet(const Derivada& f, const EstadoDinamico& y, double h);
+
+    // Avanza 'y' un intervalo completo con pasos adaptativos de
+    // Dormand-Prince. 'pasoSugerido' conserva el último paso aceptado entre
+    // llamadas. Si se agotan los intentos, el resto del intervalo se integra
+    // con RK4 fijo. Devuelve la cantidad de pasos aceptados.
+    template<class Derivada>
+    static int integrarDormandPrince(const Derivada& f, EstadoDinamico& y,
+                                     double intervalo, double tolerancia,
+                                     double& pasoSugerido);
 
-    static double calcularVelocidadEscape(double altura, bool esTierra = true);
+    // Raíz de g en [a, b] por regula falsi modificada (Illinois), con
+    // g(a) y g(b) de signos opuestos ya evaluados. Converge de forma
+    // superlineal y nunca sale del intervalo.
+    template<class Funcion>
+    static double buscarRaiz(const Funcion& g, double a, double ga,
+                             double b, double gb, double tolerancia);
+
+private:
+    static EstadoDinamico combinar(const EstadoDinamico& y, double h,
+                                   const EstadoDinamico& k) {
+        return {y.altura + h * k.altura,
+                y.velocidad + h * k.velocidad,
+                y.combustible + h * k.combustible};
+    }
 };
 
+template<class Derivada>
+EstadoDinamico SistemaFisica::pasoEuler(const Derivada& f, const EstadoDinamico& y, double h) {
+    return combinar(y, h, f(y));
+}
+
+template<class Derivada>
+EstadoDinamico SistemaFisica::pasoRK4(const Derivada& f, const EstadoDinamico& y, double h) {
+    const EstadoDinamico k1 = f(y);
+    const EstadoDinamico k2 = f(combinar(y, 0.5 * h, k1));
+    const EstadoDinamico k3 = f(combinar(y, 0.5 * h, k2));
+    const EstadoDinamico k4 = f(combinar(y, h, k3));
+
+    const double h6 = h / 6.0;
+    return {y.altura + h6 * (k1.altura + 2.0 * k2.altura + 2.0 * k3.altura + k4.altura),
+            y.velocidad + h6 * (k1.velocidad + 2.0 * k2.velocidad + 2.0 * k3.velocidad + k4.velocidad),
+            y.combustible + h6 * (k1.combustible + 2.0 * k2.combustible + 2.0 * k3.combustible + k4.combustible)};
+}
+
+template<class Derivada>
+EstadoDinamico SistemaFisica::pasoVelocityVerlet(const Derivada& f, const EstadoDinamico& y, double h) {
+    // La aceleración depende de la velocidad (resistencia), así que la
+    // segunda evaluación usa una velocidad predicha con Euler.
+    const EstadoDinamico k1 = f(y);
+
+    EstadoDinamico predicho;
+    predicho.altura = y.altura + h * y.velocidad + 0.5 * h * h * k1.velocidad;
+    predicho.velocidad = y.velocidad + h * k1.velocidad;
+    predicho.combustible = y.combustible + h * k1.combustible;
+
+    const EstadoDinamico k2 = f(predicho);
+
+    return {predicho.altura,
+            y.velocidad + 0.5 * h * (k1.velocidad + k2.velocidad),
+            y.combustible + 0.5 * h * (k1.combustible + k2.combustible)};
+}
+
+template<class Derivada>
+int SistemaFisica::integrarDormandPrince(const Derivada& f, EstadoDinamico& y,
+                                         double intervalo, double tolerancia,
+                                         double& pasoSugerido) {
+    // Tabla de Butcher de Dormand-Prince 5(4)
+    constexpr double a21 = 1.0 / 5.0;
+    constexpr double a31 = 3.0 / 40.0, a32 = 9.0 / 40.0;
+    constexpr double a41 = 44.0 / 45.0, a42 = -56.0 / 15.0, a43 = 32.0 / 9.0;
+    constexpr double a51 = 19372.0 / 6561.0, a52 = -25360.0 / 2187.0,
+                     a53 = 64448.0 / 6561.0, a54 = -212.0 / 729.0;
+    constexpr double a61 = 9017.0 / 3168.0, a62 = -355.0 / 33.0, a63 = 46732.0 / 5247.0,
+                     a64 = 49.0 / 176.0, a65 = -5103.0 / 18656.0;
+    constexpr double b1 = 35.0 / 384.0, b3 = 500.0 / 1113.0, b4 = 125.0 / 192.0,
+                     b5 = -2187.0 / 6784.0, b6 = 11.0 / 84.0;
+    // Diferencia entre la solución de orden 5 y la de orden 4
+    constexpr double e1 = 71.0 / 57600.0, e3 = -71.0 / 16695.0, e4 = 71.0 / 1920.0,
+                     e5 = -17253.0 / 339200.0, e6 = 22.0 / 525.0, e7 = -1.0 / 40.0;
+
+    constexpr int MAX_PASOS = 100000;
+    constexpr double PASOS_RESCATE = 64.0; // Pasos RK4 como máximo si se agotan los intentos
+
+    if (intervalo <= 0.0) return 0;
+    if (pasoSugerido <= 0.0 || pasoSugerido > intervalo) {
+        pasoSugerido = intervalo;
+    }
+
+    auto etapa = [&y](double h, double c1, const EstadoDinamico& k1,
+                      double c2, const EstadoDinamico& k2,
+                      double c3 = 0.0, const EstadoDinamico& k3 = {},
+                      double c4 = 0.0, const EstadoDinamico& k4 = {},
+                      double c5 = 0.0, const EstadoDinamico& k5 = {},
+                      double c6 = 0.0, const EstadoDinamico& k6 = {}) {
+        return EstadoDinamico{
+            y.altura + h * (c1 * k1.altura + c2 * k2.altura + c3 * k3.altura +
+                            c4 * k4.altura + c5 * k5.altura + c6 * k6.altura),
+            y.velocidad + h * (c1 * k1.velocidad + c2 * k2.velocidad + c3 * k3.velocidad +
+                               c4 * k4.velocidad + c5 * k5.velocidad + c6 * k6.velocidad),
+            y.combustible + h * (c1 * k1.combustible + c2 * k2.combustible + c3 * k3.combustible +
+                                 c4 * k4.combustible + c5 * k5.combustible + c6 * k6.combustible)};
+    };
+
+    double t = 0.0;
+    int aceptados = 0;
+    EstadoDinamico k1 = f(y);
+
+    for (int intento = 0; intento < MAX_PASOS && t < intervalo; ++intento) {
+        double h = std::min(pasoSugerido, intervalo - t);
+        const bool ultimo = (t + h >= intervalo);
+
+        const EstadoDinamico k2 = f(etapa(h, a21, k1, 0.0, k1));
+        const EstadoDinamico k3 = f(etapa(h, a31, k1, a32, k2));
+        const EstadoDinamico k4 = f(etapa(h, a41, k1, a42, k2, a43, k3));
+        const EstadoDinamico k5 = f(etapa(h, a51, k1, a52, k2, a53, k3, a54, k4));
+        const EstadoDinamico k6 = f(etapa(h, a61, k1, a62, k2, a63, k3, a64, k4, a65, k5));
+        const EstadoDinamico yNuevo = etapa(h, b1, k1, 0.0, k2, b3, k3, b4, k4, b5, k5, b6, k6);
+        const EstadoDinamico k7 = f(yNuevo);
+
+        // Error relativo con piso absoluto de 1 unidad por componente
+        auto errorComponente = [tolerancia](double e, double a, double b) {
+            double escala = tolerancia * (1.0 + std::max(std::abs(a), std::abs(b)));
+            return std::abs(e) / escala;
+        };
+        auto diferencia = [&](double EstadoDinamico::*campo) {
+            return h * (e1 * (k1.*campo) + e3 * (k3.*campo) + e4 * (k4.*campo) +
+                        e5 * (k5.*campo) + e6 * (k6.*campo) + e7 * (k7.*campo));
+        };
+
+        double error = std::max({
+            errorComponente(diferencia(&EstadoDinamico::altura), y.altura, yNuevo.altura),
+            errorComponente(diferencia(&EstadoDinamico::velocidad), y.velocidad, yNuevo.velocidad),
+            errorComponente(diferencia(&EstadoDinamico::combustible), y.combustible, yNuevo.combustible)});
+
+        // Un paso demasiado largo puede sacar las etapas del dominio físico
+        // (exp de alturas negativas) y dar un error no finito: se rechaza.
+        if (!std::isfinite(error)) {
+            pasoSugerido = 0.2 * h;
+            continue;
+        }
+
+        double factor = (error > 0.0) ? 0.9 * std::pow(error, -0.2) : 5.0;
+        factor = std::clamp(factor, 0.2, 5.0);
+
+        if (error <= 1.0) {
+            t = ultimo ? intervalo : t + h;
+            y = yNuevo;
+            k1 = k7; // FSAL: la última etapa es la primera del paso siguiente
+            ++aceptados;
+
+            // No dejar que el recorte del último paso achique la sugerencia
+            if (!ultimo || h >= pasoSugerido) {
+                pasoSugerido = h * factor;
+            }
+        } else {
+            pasoSugerido = h * factor;
+        }
+    }
+
+    // Sin pasos disponibles se completa el intervalo con RK4 fijo, para que
+    // el estado llegue siempre al final del intervalo que avanza el reloj
+    if (t < intervalo) {
+        const double restante = intervalo - t;
+        const int pasosFijos = static_cast<int>(
+            std::ceil(restante / std::max(pasoSugerido, intervalo / PASOS_RESCATE)));
+        const double h = restante / pasosFijos;
+        for (int i = 0; i < pasosFijos; ++i) {
+            y = pasoRK4(f, y, h);
+        }
+        aceptados += pasosFijos;
+    }
+
+    return aceptados;
+}
+
+template<class Funcion>
+double SistemaFisica::buscarRaiz(const Funcion& g, double a, double ga,
+                                 double b, double gb, double tolerancia) {
+    if (ga == 0.0) return a;
+    if (gb == 0.0) return b;
+
+    int ladoRepetido = 0;
+    for (int i = 0; i < 100 && b - a > tolerancia; ++i) {
+        const double c = (a * gb - b * ga) / (gb - ga);
+        const double gc = g(c);
+        if (gc == 0.0) return c;
+
+        if ((gc < 0.0) == (ga < 0.0)) {
+            a = c;
+            ga = gc;
+            // Si el mismo extremo queda fijo dos veces se divide su valor
+            // a la mitad para que la secante no se estanque
+            if (ladoRepetido == -1) gb *= 0.5;
+            ladoRepetido = -1;
+        } else {
+            b = c;
+            gb = gc;
+            if (ladoRepetido == 1) ga *= 0.5;
+            ladoRepetido = 1;
+        }
+    }
+
+    return (std::abs(ga) < std::abs(gb)) ? a : b;
+}
+
 #endif // SISTEMAFISICA_H
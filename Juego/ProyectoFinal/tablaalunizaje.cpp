@@ -0,0 +1,415 @@
+#include "tablaalunizaje.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include "cohete.h"
+#include "grupohilos.h"
+#include "nivel3_apolo11.h"
+
+namespace {
+
+using Tabla = TablaAlunizaje;
+
+const char FIRMA[8] = {'T', 'A', 'B', 'L', 'A', 'L', 'U', '1'};
+const double ESCALA_IMPACTO = 100.0;   // Centésimas de m/s en el archivo
+const double ESCALA_COMBUSTIBLE = 8.0; // Octavos de kg en el archivo
+const double ALTURA_CONTACTO = 1.0;    // verificarVictoria acepta el contacto desde 1 m
+const double PASO_MINIMO = 0.05;       // s
+const double PASO_MAXIMO = 10.0;       // s
+const int BARRIDOS_MAXIMOS = 200;
+const double EMPATE_IMPACTO = 0.01;    // m/s: impactos que cuentan como iguales
+const double CAMBIO_IMPACTO = 0.01;    // Convergencia: m/s y kg
+const double CAMBIO_COMBUSTIBLE = 0.5;
+
+// El archivo es la cabecera seguida, para todas las celdas en el orden de
+// indiceCelda, de los impactos (uint16), los combustibles (uint16) y los
+// empujes (uint8), en el orden de bytes de la máquina.
+struct Cabecera {
+    char firma[8];
+    std::uint32_t filasAltura;
+    std::uint32_t filasVelocidad;
+    std::uint32_t filasCombustible;
+    std::uint32_t nivelesEmpuje;
+    double alturaMaxima;
+    double velocidadBajadaMaxima;
+    double velocidadSubidaMaxima;
+    double margenVelocidad;
+    Tabla::Parametros parametros;
+};
+static_assert(std::is_trivially_copyable<Cabecera>::value, "la cabecera se copia byte a byte");
+static_assert(sizeof(Cabecera) % 8 == 0, "los arreglos tras la cabecera deben quedar alineados");
+
+const std::size_t CELDAS = Tabla::FILAS_ALTURA * Tabla::FILAS_VELOCIDAD * Tabla::FILAS_COMBUSTIBLE;
+const std::size_t BYTES_DATOS = CELDAS * (2 * sizeof(std::uint16_t) + sizeof(std::uint8_t));
+
+// Coordenada s de la velocidad: v = -VB s^2 al bajar, VB s^2 al subir
+const double S_MAXIMO = std::sqrt(Tabla::VELOCIDAD_SUBIDA_MAXIMA / Tabla::VELOCIDAD_BAJADA_MAXIMA);
+
+std::size_t indiceCelda(std::size_t i, std::size_t j, std::size_t k) {
+    return (i * Tabla::FILAS_VELOCIDAD + j) * Tabla::FILAS_COMBUSTIBLE + k;
+}
+
+double alturaDeFila(std::size_t i) {
+    const double x = static_cast<double>(i) / (Tabla::FILAS_ALTURA - 1);
+    return Tabla::ALTURA_MAXIMA * x * x;
+}
+
+double velocidadDeFila(std::size_t j) {
+    const double s = -1.0 + j * (1.0 + S_MAXIMO) / (Tabla::FILAS_VELOCIDAD - 1);
+    return (s < 0.0 ? -1.0 : 1.0) * Tabla::VELOCIDAD_BAJADA_MAXIMA * s * s;
+}
+
+double combustibleDeFila(std::size_t k, double combustibleMaximo) {
+    return combustibleMaximo * k / (Tabla::FILAS_COMBUSTIBLE - 1);
+}
+
+// Las ocho celdas que rodean un estado y sus pesos trilineales
+struct Vecindad {
+    std::size_t celdas[8];
+    double pesos[8];
+};
+
+void ubicar(double coordenada, std::size_t filas, std::size_t& fila, double& fraccion) {
+    coordenada = std::clamp(coordenada, 0.0, static_cast<double>(filas - 1));
+    fila = std::min(static_cast<std::size_t>(coordenada), filas - 2);
+    fraccion = coordenada - fila;
+}
+
+Vecindad vecindad(double altura, double velocidad, double combustible, double combustibleMaximo) {
+    const double a = (Tabla::FILAS_ALTURA - 1) *
+                     std::sqrt(std::clamp(altura, 0.0, Tabla::ALTURA_MAXIMA) / Tabla::ALTURA_MAXIMA);
+    const double s = velocidad < 0.0 ? -std::sqrt(-velocidad / Tabla::VELOCIDAD_BAJADA_MAXIMA)
+                                     : std::sqrt(velocidad / Tabla::VELOCIDAD_BAJADA_MAXIMA);
+    const double b = (s + 1.0) / (1.0 + S_MAXIMO) * (Tabla::FILAS_VELOCIDAD - 1);
+    const double c = combustible / combustibleMaximo * (Tabla::FILAS_COMBUSTIBLE - 1);
+
+    std::size_t i, j, k;
+    double fa, fb, fc;
+    ubicar(a, Tabla::FILAS_ALTURA, i, fa);
+    ubicar(b, Tabla::FILAS_VELOCIDAD, j, fb);
+    ubicar(c, Tabla::FILAS_COMBUSTIBLE, k, fc);
+
+    Vecindad v;
+    for (int n = 0; n < 8; ++n) {
+        const int di = (n >> 2) & 1;
+        const int dj = (n >> 1) & 1;
+        const int dk = n & 1;
+        v.celdas[n] = indiceCelda(i + di, j + dj, k + dk);
+        v.pesos[n] = (di ? fa : 1.0 - fa) * (dj ? fb : 1.0 - fb) * (dk ? fc : 1.0 - fc);
+    }
+    return v;
+}
+
+template<class T>
+double interpolar(const Vecindad& v, const T* datos) {
+    double suma = 0.0;
+    for (int n = 0; n < 8; ++n) {
+        suma += v.pesos[n] * datos[v.celdas[n]];
+    }
+    return suma;
+}
+
+struct EstadoVertical {
+    double altura;
+    double velocidad;
+    double combustible;
+};
+
+// Avance exacto del nivel 3 con empuje constante durante 'dt' (ecuación
+// del cohete mientras hay combustible, caída libre después)
+EstadoVertical avanzar(EstadoVertical e, double empuje, double dt, const Tabla::Parametros& p) {
+    if (empuje > 0.0 && e.combustible > 0.0) {
+        const double caudal = empuje / p.velocidadEscape;
+        const double tiempoQuema = std::min(dt, e.combustible / caudal);
+        const double masaInicial = p.masaSeca + e.combustible;
+        const double masaFinal = masaInicial - caudal * tiempoQuema;
+        const double logaritmo = std::log(masaInicial / masaFinal);
+
+        e.altura += e.velocidad * tiempoQuema - 0.5 * p.gravedad * tiempoQuema * tiempoQuema
+                    + p.velocidadEscape * (tiempoQuema - masaFinal / caudal * logaritmo);
+        e.velocidad += p.velocidadEscape * logaritmo - p.gravedad * tiempoQuema;
+        e.combustible = std::max(0.0, e.combustible - caudal * tiempoQuema);
+        dt -= tiempoQuema;
+    }
+    e.altura += e.velocidad * dt - 0.5 * p.gravedad * dt * dt;
+    e.velocidad -= p.gravedad * dt;
+    return e;
+}
+
+} // namespace
+
+TablaAlunizaje::Parametros TablaAlunizaje::Parametros::delNivel() {
+    const Nivel3_Apolo11 nivel;
+    Cohete cohete;
+    cohete.configurarParaNivel(3);
+
+    Parametros p;
+    p.gravedad = nivel.obtenerGravedad();
+    p.velocidadEscape = nivel.obtenerFactorConsumo();
+    p.masaSeca = cohete.obtenerMasaSeca();
+    p.combustibleMaximo = cohete.obtenerCombustibleMaximo();
+    p.empujeMaximo = Cohete::EMPUJE_MAXIMO;
+    p.velocidadAterrizajeMax = nivel.obtenerVelocidadAterrizajeMax();
+    return p;
+}
+
+bool TablaAlunizaje::Parametros::operator==(const Parametros& otros) const {
+    return gravedad == otros.gravedad && velocidadEscape == otros.velocidadEscape &&
+           masaSeca == otros.masaSeca && combustibleMaximo == otros.combustibleMaximo &&
+           empujeMaximo == otros.empujeMaximo &&
+           velocidadAterrizajeMax == otros.velocidadAterrizajeMax;
+}
+
+TablaAlunizaje::TablaAlunizaje()
+    : impactos(nullptr),
+    valores(nullptr),
+    empujes(nullptr),
+    parametros(Parametros::delNivel())
+{
+}
+
+TablaAlunizaje::TablaAlunizaje(TablaAlunizaje&& otra) noexcept
+    : TablaAlunizaje() {
+    *this = std::move(otra);
+}
+
+TablaAlunizaje& TablaAlunizaje::operator=(TablaAlunizaje&& otra) noexcept {
+    if (this != &otra) {
+        // Mover el vector o el archivo no cambia la dirección de sus datos
+        archivo = std::move(otra.archivo);
+        datosPropios = std::move(otra.datosPropios);
+        impactos = otra.impactos;
+        valores = otra.valores;
+        empujes = otra.empujes;
+        parametros = otra.parametros;
+        otra.impactos = nullptr;
+        otra.valores = nullptr;
+        otra.empujes = nullptr;
+    }
+    return *this;
+}
+
+void TablaAlunizaje::usarDatos(const unsigned char* datos) {
+    impactos = reinterpret_cast<const std::uint16_t*>(datos);
+    valores = impactos + CELDAS;
+    empujes = reinterpret_cast<const std::uint8_t*>(valores + CELDAS);
+}
+
+TablaAlunizaje TablaAlunizaje::generar(unsigned numeroHilos, int* barridos) {
+    const Parametros p = Parametros::delNivel();
+    const double empujePorNivel = p.empujeMaximo / (NIVELES_EMPUJE - 1);
+    const double velocidadObjetivo = p.velocidadAterrizajeMax - MARGEN_VELOCIDAD;
+
+    // Por celda: cuánto se pasa como mínimo de velocidadObjetivo al tocar
+    // el suelo, combustible final alunizando así y nivel de empuje óptimo
+    std::vector<float> exceso(CELDAS, static_cast<float>(VELOCIDAD_BAJADA_MAXIMA));
+    std::vector<float> combustibleFinal(CELDAS, 0.0f);
+    std::vector<std::uint8_t> nivelOptimo(CELDAS, 0);
+
+    // Una fila de altura se calcula entera a partir de la tabla anterior y
+    // recién después se escribe, así que el resultado no depende de cómo
+    // se repartan las velocidades entre hilos
+    const std::size_t celdasFila = FILAS_VELOCIDAD * FILAS_COMBUSTIBLE;
+    std::vector<float> filaExceso(celdasFila);
+    std::vector<float> filaCombustible(celdasFila);
+    std::vector<std::uint8_t> filaNivel(celdasFila);
+    std::vector<double> cambioExceso(FILAS_VELOCIDAD);
+    std::vector<double> cambioCombustible(FILAS_VELOCIDAD);
+
+    GrupoHilos grupo((numeroHilos == 0 ? GrupoHilos::hilosDisponibles() : numeroHilos) - 1);
+
+    int barrido = 0;
+    while (barrido < BARRIDOS_MAXIMOS) {
+        ++barrido;
+        double cambioMaximoExceso = 0.0;
+        double cambioMaximoCombustible = 0.0;
+
+        // De abajo hacia arriba: casi siempre se baja, así que cada fila usa
+        // las de abajo ya actualizadas en este mismo barrido
+        for (std::size_t i = 0; i < FILAS_ALTURA; ++i) {
+            const double altura = alturaDeFila(i);
+            // Paso de tiempo que recorre más o menos una celda de altura
+            const std::size_t filaPaso = std::max<std::size_t>(i, 1);
+            const double altoCelda = alturaDeFila(filaPaso) - alturaDeFila(filaPaso - 1);
+
+            grupo.paraCada(FILAS_VELOCIDAD, [&](std::size_t j) {
+                const double velocidad = velocidadDeFila(j);
+                const double dt = std::clamp(altoCelda / std::max(std::abs(velocidad), 1.0),
+                                             PASO_MINIMO, PASO_MAXIMO);
+                double cambioE = 0.0;
+                double cambioC = 0.0;
+
+                for (std::size_t k = 0; k < FILAS_COMBUSTIBLE; ++k) {
+                    const double combustible = combustibleDeFila(k, p.combustibleMaximo);
+                    double mejorExceso;
+                    double mejorCombustible = combustible;
+                    int mejorNivel = 0;
+
+                    if (altura <= ALTURA_CONTACTO) {
+                        mejorExceso = std::max(0.0, std::abs(velocidad) - velocidadObjetivo);
+                    } else {
+                        double excesos[NIVELES_EMPUJE];
+                        double combustibles[NIVELES_EMPUJE];
+                        const int niveles = combustible > 0.0 ? NIVELES_EMPUJE : 1;
+                        mejorExceso = VELOCIDAD_BAJADA_MAXIMA;
+
+                        for (int n = 0; n < niveles; ++n) {
+                            const EstadoVertical siguiente =
+                                avanzar({altura, velocidad, combustible}, n * empujePorNivel, dt, p);
+                            if (siguiente.altura <= ALTURA_CONTACTO) {
+                                excesos[n] = std::max(0.0, std::abs(siguiente.velocidad) - velocidadObjetivo);
+                                combustibles[n] = siguiente.combustible;
+                            } else {
+                                const Vecindad v = vecindad(siguiente.altura, siguiente.velocidad,
+                                                            siguiente.combustible, p.combustibleMaximo);
+                                excesos[n] = interpolar(v, exceso.data());
+                                combustibles[n] = interpolar(v, combustibleFinal.data());
+                            }
+                            mejorExceso = std::min(mejorExceso, excesos[n]);
+                        }
+
+                        // Entre los que tocan el suelo igual de despacio, el
+                        // que más combustible ahorra (ante empates, el menor)
+                        mejorCombustible = -1.0;
+                        for (int n = 0; n < niveles; ++n) {
+                            if (excesos[n] <= mejorExceso + EMPATE_IMPACTO &&
+                                combustibles[n] > mejorCombustible + 1e-6) {
+                                mejorCombustible = combustibles[n];
+                                mejorNivel = n;
+                            }
+                        }
+                    }
+
+                    const std::size_t celda = indiceCelda(i, j, k);
+                    cambioE = std::max(cambioE, std::abs(mejorExceso - exceso[celda]));
+                    cambioC = std::max(cambioC, std::abs(mejorCombustible - combustibleFinal[celda]));
+
+                    const std::size_t enFila = j * FILAS_COMBUSTIBLE + k;
+                    filaExceso[enFila] = static_cast<float>(mejorExceso);
+                    filaCombustible[enFila] = static_cast<float>(mejorCombustible);
+                    filaNivel[enFila] = static_cast<std::uint8_t>(mejorNivel);
+                }
+                cambioExceso[j] = cambioE;
+                cambioCombustible[j] = cambioC;
+            });
+
+            const std::size_t inicio = indiceCelda(i, 0, 0);
+            std::copy(filaExceso.begin(), filaExceso.end(), exceso.begin() + inicio);
+            std::copy(filaCombustible.begin(), filaCombustible.end(), combustibleFinal.begin() + inicio);
+            std::copy(filaNivel.begin(), filaNivel.end(), nivelOptimo.begin() + inicio);
+            cambioMaximoExceso = std::max(cambioMaximoExceso,
+                                          *std::max_element(cambioExceso.begin(), cambioExceso.end()));
+            cambioMaximoCombustible = std::max(cambioMaximoCombustible,
+                                               *std::max_element(cambioCombustible.begin(),
+                                                                 cambioCombustible.end()));
+        }
+
+        if (cambioMaximoExceso < CAMBIO_IMPACTO && cambioMaximoCombustible < CAMBIO_COMBUSTIBLE) {
+            break;
+        }
+    }
+    if (barridos) *barridos = barrido;
+
+    TablaAlunizaje tabla;
+    tabla.parametros = p;
+    tabla.datosPropios.resize(BYTES_DATOS);
+    tabla.usarDatos(tabla.datosPropios.data());
+
+    std::uint16_t* impactos = reinterpret_cast<std::uint16_t*>(tabla.datosPropios.data());
+    std::uint16_t* valores = impactos + CELDAS;
+    std::uint8_t* empujes = reinterpret_cast<std::uint8_t*>(valores + CELDAS);
+    for (std::size_t c = 0; c < CELDAS; ++c) {
+        const double impacto = velocidadObjetivo + exceso[c];
+        impactos[c] = static_cast<std::uint16_t>(std::lround(std::min(impacto * ESCALA_IMPACTO, 65535.0)));
+        valores[c] = static_cast<std::uint16_t>(std::lround(combustibleFinal[c] * ESCALA_COMBUSTIBLE));
+        empujes[c] = nivelOptimo[c];
+    }
+    return tabla;
+}
+
+bool TablaAlunizaje::guardar(const std::string& ruta) const {
+    if (!estaCargada()) return false;
+
+    std::ofstream salida(ruta, std::ios::binary);
+    if (!salida) return false;
+
+    Cabecera cabecera;
+    std::memset(&cabecera, 0, sizeof(cabecera));
+    std::memcpy(cabecera.firma, FIRMA, sizeof(FIRMA));
+    cabecera.filasAltura = FILAS_ALTURA;
+    cabecera.filasVelocidad = FILAS_VELOCIDAD;
+    cabecera.filasCombustible = FILAS_COMBUSTIBLE;
+    cabecera.nivelesEmpuje = NIVELES_EMPUJE;
+    cabecera.alturaMaxima = ALTURA_MAXIMA;
+    cabecera.velocidadBajadaMaxima = VELOCIDAD_BAJADA_MAXIMA;
+    cabecera.velocidadSubidaMaxima = VELOCIDAD_SUBIDA_MAXIMA;
+    cabecera.margenVelocidad = MARGEN_VELOCIDAD;
+    cabecera.parametros = parametros;
+
+    salida.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+    salida.write(reinterpret_cast<const char*>(impactos), BYTES_DATOS);
+    return static_cast<bool>(salida);
+}
+
+bool TablaAlunizaje::cargar(const std::string& ruta) {
+    ArchivoMapeado nuevo;
+    if (!nuevo.abrir(ruta)) return false;
+    if (nuevo.obtenerTamano() != sizeof(Cabecera) + BYTES_DATOS) return false;
+
+    Cabecera cabecera;
+    std::memcpy(&cabecera, nuevo.obtenerDatos(), sizeof(cabecera));
+    if (std::memcmp(cabecera.firma, FIRMA, sizeof(FIRMA)) != 0 ||
+        cabecera.filasAltura != FILAS_ALTURA || cabecera.filasVelocidad != FILAS_VELOCIDAD ||
+        cabecera.filasCombustible != FILAS_COMBUSTIBLE || cabecera.nivelesEmpuje != NIVELES_EMPUJE ||
+        cabecera.alturaMaxima != ALTURA_MAXIMA ||
+        cabecera.velocidadBajadaMaxima != VELOCIDAD_BAJADA_MAXIMA ||
+        cabecera.velocidadSubidaMaxima != VELOCIDAD_SUBIDA_MAXIMA ||
+        cabecera.margenVelocidad != MARGEN_VELOCIDAD ||
+        !(cabecera.parametros == Parametros::delNivel())) {
+        return false;
+    }
+
+    archivo = std::move(nuevo);
+    datosPropios.clear();
+    parametros = cabecera.parametros;
+    usarDatos(archivo.obtenerDatos() + sizeof(Cabecera));
+    return true;
+}
+
+bool TablaAlunizaje::estaCargada() const {
+    return impactos != nullptr;
+}
+
+ConsultaAlunizaje TablaAlunizaje::consultar(double altura, double velocidad, double combustible) const {
+    ConsultaAlunizaje consulta;
+    if (!estaCargada()) return consulta;
+
+    if (altura <= ALTURA_CONTACTO) {
+        consulta.velocidadImpactoMinima = std::abs(velocidad);
+        consulta.posible = consulta.velocidadImpactoMinima <= parametros.velocidadAterrizajeMax;
+        consulta.combustibleFinal = combustible;
+        return consulta;
+    }
+
+    const Vecindad v = vecindad(altura, velocidad, combustible, parametros.combustibleMaximo);
+    consulta.velocidadImpactoMinima = interpolar(v, impactos) / ESCALA_IMPACTO;
+    consulta.posible = consulta.velocidadImpactoMinima <= parametros.velocidadAterrizajeMax;
+    consulta.combustibleFinal = interpolar(v, valores) / ESCALA_COMBUSTIBLE;
+    consulta.empuje = interpolar(v, empujes) * parametros.empujeMaximo / (NIVELES_EMPUJE - 1);
+    return consulta;
+}
+
+std::size_t TablaAlunizaje::obtenerCeldas() {
+    return CELDAS;
+}
+
+const TablaAlunizaje& TablaAlunizaje::compartida(const std::string& ruta) {
+    static const TablaAlunizaje tabla = [&ruta] {
+        TablaAlunizaje cargada;
+        cargada.cargar(ruta);
+        return cargada;
+    }();
+    return tabla;
+}
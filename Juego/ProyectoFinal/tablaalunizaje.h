@@ -0,0 +1,102 @@
+#ifndef TABLAALUNIZAJE_H
+#define TABLAALUNIZAJE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "archivomapeado.h"
+
+// Respuesta de la tabla para un estado del nivel 3
+struct ConsultaAlunizaje {
+    bool posible = false;                // Todavía se puede tocar el suelo a velocidad segura
+    double velocidadImpactoMinima = 0.0; // La menor a la que se puede llegar al suelo (m/s)
+    double empuje = 0.0;                 // Mejor empuje para este instante (N)
+    double combustibleFinal = 0.0;       // kg que sobran alunizando de la mejor forma
+};
+
+// Tabla de valor del descenso del nivel 3 sobre una grilla de (altura,
+// velocidad vertical, combustible). Cada celda guarda la menor velocidad a
+// la que todavía se puede tocar el suelo, el combustible que sobra
+// alunizando con margen (MARGEN_VELOCIDAD por debajo del límite) y el
+// empuje que lo logra. Se calcula una vez fuera de línea por programación
+// dinámica y se guarda en un archivo que luego se proyecta en memoria:
+// cargarla no lee nada y consultarla es una interpolación trilineal.
+//
+// La velocidad de impacto mínima varía en forma continua, así que se
+// interpola bien y decide si el alunizaje es posible; interpolar un "sí o
+// no" correría la frontera media celda en cada paso de la recursión.
+//
+// La grilla es más fina donde importa: la altura y la velocidad se
+// espacian en forma cuadrática, con celdas de ~1 m y ~0.02 m/s junto al
+// suelo y a velocidad cero.
+class TablaAlunizaje {
+public:
+    static constexpr std::size_t FILAS_ALTURA = 160;
+    static constexpr std::size_t FILAS_VELOCIDAD = 160;
+    static constexpr std::size_t FILAS_COMBUSTIBLE = 33;
+    static constexpr double ALTURA_MAXIMA = 20000.0;          // m
+    static constexpr double VELOCIDAD_BAJADA_MAXIMA = 400.0;  // m/s
+    static constexpr double VELOCIDAD_SUBIDA_MAXIMA = 50.0;   // m/s
+    static constexpr int NIVELES_EMPUJE = 11;                 // 0, 10 %, ..., 100 %
+    // El empuje óptimo apunta a tocar el suelo esta cantidad por debajo
+    // de la velocidad máxima de alunizaje
+    static constexpr double MARGEN_VELOCIDAD = 2.0;           // m/s
+
+    static constexpr const char* RUTA_PREDETERMINADA = "tabla_alunizaje.bin";
+
+    // Física del nivel 3 con la que se calculó. Se guarda en el archivo y
+    // una tabla con otros valores no se carga.
+    struct Parametros {
+        double gravedad;
+        double velocidadEscape;      // Empuje por kg/s de combustible
+        double masaSeca;
+        double combustibleMaximo;
+        double empujeMaximo;
+        double velocidadAterrizajeMax;
+
+        static Parametros delNivel();
+        bool operator==(const Parametros& otros) const;
+    };
+
+private:
+    ArchivoMapeado archivo;
+    std::vector<unsigned char> datosPropios; // Tabla generada en memoria
+    const std::uint16_t* impactos;  // Velocidad de impacto mínima, centésimas de m/s
+    const std::uint16_t* valores;   // Combustible final, octavos de kg
+    const std::uint8_t* empujes;    // Nivel de empuje óptimo
+    Parametros parametros;
+
+    // Apunta los tres arreglos a 'datos' (sin la cabecera)
+    void usarDatos(const unsigned char* datos);
+
+public:
+    TablaAlunizaje();
+
+    TablaAlunizaje(TablaAlunizaje&& otra) noexcept;
+    TablaAlunizaje& operator=(TablaAlunizaje&& otra) noexcept;
+    TablaAlunizaje(const TablaAlunizaje&) = delete;
+    TablaAlunizaje& operator=(const TablaAlunizaje&) = delete;
+
+    // Programación dinámica hasta que ninguna celda cambia. 'barridos'
+    // recibe cuántas pasadas sobre la grilla hicieron falta.
+    static TablaAlunizaje generar(unsigned numeroHilos = 0, int* barridos = nullptr);
+
+    bool guardar(const std::string& ruta) const;
+    // Proyecta el archivo; false si no existe o no corresponde a esta física
+    bool cargar(const std::string& ruta);
+    bool estaCargada() const;
+
+    ConsultaAlunizaje consultar(double altura, double velocidad, double combustible) const;
+
+    static std::size_t obtenerCeldas();
+
+    // Tabla compartida por todo el programa, cargada de 'ruta' la primera
+    // vez que se pide (puede quedar sin cargar). Las llamadas siguientes
+    // ignoran la ruta, así que quien sabe dónde está el archivo (la
+    // interfaz, junto a su ejecutable) debe pedirla primero. Una ruta
+    // relativa se resuelve contra el directorio de trabajo.
+    static const TablaAlunizaje& compartida(const std::string& ruta = RUTA_PREDETERMINADA);
+};
+
+#endif // TABLAALUNIZAJE_H
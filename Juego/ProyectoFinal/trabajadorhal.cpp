@@ -0,0 +1,112 @@
+#include "trabajadorhal.h"
+#include <algorithm>
+#include "juego.h"
+
+TrabajadorHAL::TrabajadorHAL()
+    : evaluacion(std::make_shared<Evaluacion>()),
+    enVuelo(false),
+    reiniciarFiltro(false),
+    siguienteMuestra(0),
+    grupo(1) {
+    evaluacion->espejo.establecerModoSilencioso(true);
+}
+
+bool TrabajadorHAL::lanzar(const Juego& juego, unsigned long long versionControles, double reloj) {
+    if (enVuelo) return false;
+
+    Evaluacion& e = *evaluacion;
+    e.estado = juego.capturarEstado();
+    e.percibido = juego.obtenerCohetePercibido();
+    const EstimacionCohete* estimacion = juego.obtenerEstimacion();
+    e.incertidumbre = estimacion
+        ? IncertidumbreAlunizaje{estimacion->desvioAltura, estimacion->desvioVelocidad}
+        : IncertidumbreAlunizaje();
+    e.muestras = juego.obtenerMuestrasHAL();
+    e.desdeMuestra = siguienteMuestra;
+    e.reloj = reloj;
+    e.version = versionControles;
+    e.reiniciarFiltro = reiniciarFiltro;
+    e.avisos.limpiar();
+    e.lista.store(false, std::memory_order_relaxed);
+
+    siguienteMuestra = e.muestras.obtenerTotal();
+    reiniciarFiltro = false;
+    enVuelo = true;
+
+    std::shared_ptr<Evaluacion> compartida = evaluacion;
+    grupo.encolar([compartida]() {
+        evaluar(*compartida);
+        compartida->lista.store(true, std::memory_order_release);
+    });
+    return true;
+}
+
+void TrabajadorHAL::evaluar(Evaluacion& e) {
+    if (e.estado.nivel <= 0) return;
+
+    Juego& espejo = e.espejo;
+    espejo.restaurarEstado(e.estado);
+    AgenteHAL69* hal = espejo.obtenerAgenteHAL();
+    const Nivel* nivel = espejo.obtenerNivel();
+    if (!nivel) return;
+
+    if (e.reiniciarFiltro) {
+        hal->olvidarConsejos();
+    }
+
+    // Informes periódicos pendientes; los de otro nivel ya no tienen con
+    // qué compararse
+    const std::uint64_t primera = std::max(e.desdeMuestra, e.muestras.obtenerPrimero());
+    for (std::uint64_t i = primera; i < e.muestras.obtenerTotal(); ++i) {
+        const MuestraHAL& muestra = e.muestras.obtener(i);
+        if (muestra.nivel == e.estado.nivel) {
+            hal->analizarEstado(muestra.nivel, *nivel, muestra.cohete, muestra.telemetria,
+                                muestra.tiempo);
+        }
+    }
+
+    if (e.estado.enEjecucion) {
+        hal->evaluar(e.estado.nivel, *nivel, e.percibido, e.estado.telemetria.obtenerResumen(),
+                     e.estado.tiempoSimulacion, e.reloj, e.incertidumbre);
+    } else {
+        hal->normalizarAvisos();
+    }
+
+    const HistorialAvisos& historial = hal->obtenerAvisos();
+    std::uint64_t i = std::max(e.siguienteAviso, historial.obtenerPrimero());
+    for (; i < historial.obtenerTotal(); ++i) {
+        e.avisos.agregar(historial.obtener(i));
+    }
+    e.siguienteAviso = i;
+}
+
+bool TrabajadorHAL::estaLista() const {
+    return enVuelo && evaluacion->lista.load(std::memory_order_acquire);
+}
+
+std::size_t TrabajadorHAL::recoger(const Juego& juego, unsigned long long versionControles,
+                                   AvisosNuevos& avisos) {
+    const Evaluacion& e = *evaluacion;
+    enVuelo = false;
+
+    const bool vigente = e.version == versionControles &&
+                         juego.obtenerNivelActual() == e.estado.nivel &&
+                         juego.obtenerPasoActual() >= e.estado.paso &&
+                         juego.estaEnEjecucion();
+
+    std::size_t descartados = 0;
+    avisos.limpiar();
+    for (std::uint64_t i = e.avisos.obtenerPrimero(); i < e.avisos.obtenerTotal(); ++i) {
+        const AvisoHAL& aviso = e.avisos.obtener(i);
+        if (vigente || canalDe(aviso.codigo) == CanalAviso::Consola) {
+            avisos.agregar(aviso);
+        } else {
+            ++descartados;
+        }
+    }
+
+    if (descartados > 0) {
+        reiniciarFiltro = true;
+    }
+    return descartados;
+}
@@ -0,0 +1,75 @@
+#ifndef TRABAJADORHAL_H
+#define TRABAJADORHAL_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include "avisoshal.h"
+#include "buffercircular.h"
+#include "estadojuego.h"
+#include "grupohilos.h"
+#include "juego.h"
+
+// Corre el análisis de HAL (consejos, previsión, tabla de alunizaje e
+// informes periódicos) en un hilo propio, así nunca se suma al paso de
+// física ni a la publicación. Cada evaluación parte de una copia del
+// estado de la partida, que se restaura sobre un Juego espejo con su propio
+// AgenteHAL69. Como ExploradorAlternativas, lanzar() no espera y quien lo
+// llama consulta estaLista() en cada vuelta.
+class TrabajadorHAL {
+public:
+    using AvisosNuevos = BufferCircular<AvisoHAL, 32>;
+
+private:
+    // Solo hay una evaluación en vuelo, así que se reusa siempre la misma.
+    // Mientras está en vuelo solo la toca el hilo del grupo.
+    struct Evaluacion {
+        Juego espejo;                       // Lleva el AgenteHAL69 que analiza
+        std::uint64_t siguienteAviso = 0;   // En el historial del espejo
+
+        EstadoJuego estado;
+        Cohete percibido;                   // Lo que ve HAL si la partida tiene sensores
+        IncertidumbreAlunizaje incertidumbre; // Desvíos de 'percibido' (0 sin sensores)
+        MuestrasHAL muestras;
+        std::uint64_t desdeMuestra = 0;
+        double reloj = 0.0;
+        unsigned long long version = 0;
+        bool reiniciarFiltro = false;
+
+        AvisosNuevos avisos;
+        std::atomic<bool> lista{false};
+    };
+
+    std::shared_ptr<Evaluacion> evaluacion;
+    bool enVuelo;
+    bool reiniciarFiltro; // Se descartaron consejos: que puedan repetirse
+    std::uint64_t siguienteMuestra;
+
+    // Último miembro: se destruye primero y espera a la tarea
+    GrupoHilos grupo;
+
+    static void evaluar(Evaluacion& evaluacion);
+
+public:
+    TrabajadorHAL();
+
+    TrabajadorHAL(const TrabajadorHAL&) = delete;
+    TrabajadorHAL& operator=(const TrabajadorHAL&) = delete;
+
+    // Manda a evaluar el estado actual y las muestras nuevas de 'juego'. No
+    // hace nada (y devuelve false) si la evaluación anterior no terminó.
+    // 'reloj' en segundos de tiempo real, para el filtro de consejos.
+    bool lanzar(const Juego& juego, unsigned long long versionControles, double reloj);
+
+    bool estaLista() const;
+
+    // Solo con estaLista(). Deja en 'avisos' lo que produjo la evaluación:
+    // los informes periódicos siempre y los consejos solo si siguen
+    // valiendo, es decir, si los controles no cambiaron y la partida no
+    // volvió a un paso anterior al evaluado. Devuelve cuántos consejos se
+    // descartaron por viejos.
+    std::size_t recoger(const Juego& juego, unsigned long long versionControles,
+                        AvisosNuevos& avisos);
+};
+
+#endif // TRABAJADORHAL_H
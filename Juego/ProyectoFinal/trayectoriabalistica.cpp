@@ -0,0 +1,136 @@
+#include "trayectoriabalistica.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+const double INFINITO = std::numeric_limits<double>::infinity();
+
+// eta - sin(eta) sin cancelación para eta chico
+double etaMenosSeno(double eta) {
+    if (std::abs(eta) < 0.5) {
+        const double e2 = eta * eta;
+        return eta * e2 * (1.0 / 6.0 - e2 * (1.0 / 120.0 - e2 * (1.0 / 5040.0 -
+               e2 * (1.0 / 362880.0 - e2 / 39916800.0))));
+    }
+    return eta - std::sin(eta);
+}
+
+} // namespace
+
+TrayectoriaBalistica::TrayectoriaBalistica(const EstadoDinamico& y, double g,
+                                           bool esRadial, double r)
+    : inicio(y), gravedad(g), gravedadRadial(esRadial), radio(r),
+    mu(0.0), semiejeMayor(0.0), raizMuSobreA(0.0), movimientoMedio(0.0), etaInicial(0.0) {
+    if (!gravedadRadial) return;
+
+    mu = gravedad * radio * radio;
+    const double energia = 0.5 * y.velocidad * y.velocidad - mu / (radio + y.altura);
+    if (energia >= 0.0) return;
+
+    semiejeMayor = -mu / (2.0 * energia);
+    raizMuSobreA = std::sqrt(mu / semiejeMayor);
+    movimientoMedio = raizMuSobreA / semiejeMayor;
+    etaInicial = 2.0 * std::atan2(raizMuSobreA, y.velocidad);
+}
+
+TrayectoriaBalistica TrayectoriaBalistica::constante(double gravedad,
+                                                     const EstadoDinamico& inicio) {
+    return TrayectoriaBalistica(inicio, gravedad, false, 0.0);
+}
+
+TrayectoriaBalistica TrayectoriaBalistica::radial(double gravedadSuperficie, double radio,
+                                                  const EstadoDinamico& inicio) {
+    return TrayectoriaBalistica(inicio, gravedadSuperficie, true, radio);
+}
+
+bool TrayectoriaBalistica::estaLigada() const {
+    return gravedadRadial ? semiejeMayor > 0.0 : gravedad > 0.0;
+}
+
+double TrayectoriaBalistica::tiempoHastaEta(double eta) const {
+    return (etaMenosSeno(eta) - etaMenosSeno(etaInicial)) / movimientoMedio;
+}
+
+EstadoDinamico TrayectoriaBalistica::estadoEn(double t) const {
+    if (t <= 0.0 || !estaLigada()) return inicio;
+
+    if (!gravedadRadial) {
+        return {inicio.altura + t * (inicio.velocidad - 0.5 * gravedad * t),
+                inicio.velocidad - gravedad * t,
+                inicio.combustible};
+    }
+
+    // Ecuación de Kepler radial: eta - sin(eta) = M. Newton con respaldo de
+    // bisección dentro de [etaInicial, 2*pi]
+    const double m = etaMenosSeno(etaInicial) + movimientoMedio * t;
+    double bajo = etaInicial;
+    double alto = 2.0 * PI;
+    double eta = std::min(etaInicial + movimientoMedio * t, alto);
+
+    for (int i = 0; i < 60; ++i) {
+        const double f = etaMenosSeno(eta) - m;
+        if (f < 0.0) bajo = eta; else alto = eta;
+
+        const double s = std::sin(0.5 * eta);
+        double siguiente = eta - f / (2.0 * s * s);
+        if (!(siguiente > bajo && siguiente < alto)) {
+            siguiente = 0.5 * (bajo + alto);
+        }
+
+        const double cambio = std::abs(siguiente - eta);
+        eta = siguiente;
+        if (cambio <= 1e-15 * eta) break;
+    }
+
+    const double s = std::sin(0.5 * eta);
+    const double c = std::cos(0.5 * eta);
+    return {2.0 * semiejeMayor * s * s - radio,
+            raizMuSobreA * c / s,
+            inicio.combustible};
+}
+
+double TrayectoriaBalistica::tiempoHastaAltura(double altura) const {
+    if (!estaLigada()) return INFINITO;
+
+    if (!gravedadRadial) {
+        // g/2 t^2 - v0 t + (altura - h0) = 0 con la fórmula estable
+        const double v0 = inicio.velocidad;
+        const double discriminante = v0 * v0 - 2.0 * gravedad * (altura - inicio.altura);
+        if (discriminante < 0.0) return INFINITO;
+
+        const double q = v0 + std::copysign(std::sqrt(discriminante), v0);
+        if (q == 0.0) return INFINITO;
+
+        const double t1 = q / gravedad;
+        const double t2 = 2.0 * (altura - inicio.altura) / q;
+        double t = INFINITO;
+        if (t1 > 0.0) t = t1;
+        if (t2 > 0.0 && t2 < t) t = t2;
+        return t;
+    }
+
+    const double senoCuadrado = (radio + altura) / (2.0 * semiejeMayor);
+    if (senoCuadrado > 1.0 || senoCuadrado < 0.0) return INFINITO;
+
+    // Subiendo (eta < pi) o bajando (eta > pi): el primero que esté adelante
+    const double etaSubida = 2.0 * std::asin(std::sqrt(senoCuadrado));
+    const double etaBajada = 2.0 * PI - etaSubida;
+    if (etaSubida > etaInicial) return tiempoHastaEta(etaSubida);
+    if (etaBajada > etaInicial) return tiempoHastaEta(etaBajada);
+    return INFINITO;
+}
+
+double TrayectoriaBalistica::tiempoHastaVelocidad(double velocidad) const {
+    if (!estaLigada()) return INFINITO;
+
+    if (!gravedadRadial) {
+        const double t = (inicio.velocidad - velocidad) / gravedad;
+        return t > 0.0 ? t : INFINITO;
+    }
+
+    const double eta = 2.0 * std::atan2(raizMuSobreA, velocidad);
+    return eta > etaInicial ? tiempoHastaEta(eta) : INFINITO;
+}
@@ -0,0 +1,56 @@
+#ifndef TRAYECTORIABALISTICA_H
+#define TRAYECTORIABALISTICA_H
+
+#include "sistemafisica.h"
+
+// Vuelo vertical sin empuje ni resistencia resuelto en forma cerrada, para
+// saltar los tramos de planeo sin integrar paso a paso.
+//
+// Con gravedad constante (Luna) es una parábola. Con la gravedad de juego
+// de la Tierra, g0 * (R / (R + h))^2, es el problema de Kepler radial con
+// mu = g0 * R^2: para energía negativa
+//     r = 2a * sin^2(eta / 2),   v = sqrt(mu / a) * cot(eta / 2),
+//     t = (eta - sin(eta)) / sqrt(mu / a^3)
+// con eta creciente de 0 a 2*pi (apogeo en eta = pi). La velocidad es
+// monótona en eta, así que los tiempos hasta una altura o una velocidad
+// dadas salen directos y solo el estado en un instante dado necesita
+// resolver la ecuación de Kepler (Newton).
+class TrayectoriaBalistica {
+private:
+    EstadoDinamico inicio;
+    double gravedad;       // Constante o de superficie (radial)
+    bool gravedadRadial;
+
+    // Solo radial
+    double radio;
+    double mu;
+    double semiejeMayor;   // a; <= 0 si la trayectoria no está ligada
+    double raizMuSobreA;   // sqrt(mu / a)
+    double movimientoMedio; // sqrt(mu / a^3)
+    double etaInicial;
+
+    TrayectoriaBalistica(const EstadoDinamico& y, double g, bool esRadial, double r);
+
+    double tiempoHastaEta(double eta) const;
+
+public:
+    // Gravedad constante g
+    static TrayectoriaBalistica constante(double gravedad, const EstadoDinamico& inicio);
+    // g = gravedadSuperficie * (radio / (radio + h))^2
+    static TrayectoriaBalistica radial(double gravedadSuperficie, double radio,
+                                       const EstadoDinamico& inicio);
+
+    // Falsa para las trayectorias de escape (energía >= 0): esas no se
+    // saltan y se integran con el paso normal
+    bool estaLigada() const;
+
+    // Estado 't' segundos después del inicio (el combustible no cambia)
+    EstadoDinamico estadoEn(double t) const;
+
+    // Primer instante t > 0 en que se alcanza la altura o la velocidad
+    // (con signo) pedida; infinito si no ocurre
+    double tiempoHastaAltura(double altura) const;
+    double tiempoHastaVelocidad(double velocidad) const;
+};
+
+#endif // TRAYECTORIABALISTICA_H
@@ -8,12 +8,17 @@
 #include <QCoreApplication>
 #include <QUrl>
 #include <cmath>
+#include <algorithm>
 
 VisualizacionWidget::VisualizacionWidget(QWidget *parent)
     : QWidget(parent),
     coheteActual(nullptr),
-    nivelActual(nullptr),
+    coheteAnterior(nullptr),
+    factorInterpolacion(1.0),
+    alturaObjetivo(0.0),
     numeroNivel(0),
+    hayPrevision(false),
+    tiempoPrediccion(0.0),
     frameAnimacion(0),
     animacionActiva(false),
     escalaAltura(1.0),
@@ -60,9 +65,23 @@ VisualizacionWidget::~VisualizacionWidget()
     }
 }
 
-void VisualizacionWidget::actualizarCohete(const Cohete* cohete)
+void VisualizacionWidget::actualizarCohete(const Cohete* cohete,
+                                           const Cohete* anterior,
+                                           double alfa)
 {
-    coheteActual = cohete;
+    if(cohete) {
+        copiaCohete = *cohete;
+        coheteActual = &copiaCohete;
+    } else {
+        coheteActual = nullptr;
+    }
+    if(anterior) {
+        copiaAnterior = *anterior;
+        coheteAnterior = &copiaAnterior;
+    } else {
+        coheteAnterior = nullptr;
+    }
+    factorInterpolacion = std::clamp(alfa, 0.0, 1.0);
     if(cohete) {
         calcularPosicionCohete();
         
@@ -92,10 +111,16 @@ void VisualizacionWidget::actualizarCohete(const Cohete* cohete)
     }
 }
 
-void VisualizacionWidget::actualizarNivel(const Nivel* nivel, int numNivel)
+void VisualizacionWidget::actualizarNivel(double altObjetivo, int numNivel)
 {
-    nivelActual = nivel;
+    alturaObjetivo = altObjetivo;
     numeroNivel = numNivel;
+    // Un perfil de referencia vale solo para el intento en que se calculó
+    perfilReferencia.clear();
+    perfilJugador.clear();
+    hayPrevision = false;
+    prediccion.clear();
+    marcasPrediccion.clear();
     calcularEscalaAltura();
     update();
 }
@@ -176,6 +201,8 @@ void VisualizacionWidget::paintEvent(QPaintEvent *event)
         dibujarAreaAterrizaje(painter);
     }
 
+    dibujarPrediccion(painter);
+
     if(coheteActual) {
         if(mostrarExplosion && !framesExplosion.isEmpty()) {
             dibujarExplosion(painter);
@@ -189,6 +216,8 @@ void VisualizacionWidget::paintEvent(QPaintEvent *event)
     }
 
     dibujarLineaObjetivo(painter);
+    dibujarPerfiles(painter);
+    dibujarPrevision(painter);
 }
 
 void VisualizacionWidget::dibujarFondo(QPainter& painter)
@@ -466,11 +495,279 @@ void VisualizacionWidget::dibujarIndicadores(QPainter& painter)
     painter.drawRect(10, 10, 20, 20);
 }
 
+void VisualizacionWidget::establecerPerfilReferencia(const QVector<QPointF>& puntos)
+{
+    perfilReferencia = puntos;
+    perfilJugador.clear();
+    update();
+}
+
+void VisualizacionWidget::agregarPuntoJugador(double tiempo, double altura)
+{
+    if(perfilReferencia.isEmpty()) return;
+
+    // Al rebobinar se borra lo que quedó por delante
+    while(!perfilJugador.isEmpty() && perfilJugador.last().x() > tiempo) {
+        perfilJugador.removeLast();
+    }
+    if(perfilJugador.isEmpty() || tiempo > perfilJugador.last().x()) {
+        perfilJugador.append(QPointF(tiempo, altura));
+    }
+}
+
+void VisualizacionWidget::limpiarPerfiles()
+{
+    perfilReferencia.clear();
+    perfilJugador.clear();
+    update();
+}
+
+void VisualizacionWidget::dibujarPerfiles(QPainter& painter)
+{
+    if(perfilReferencia.isEmpty()) return;
+
+    const QRectF marco(40, 40, 220, 130);
+    painter.setPen(QPen(QColor(150, 150, 150, 150), 1));
+    painter.setBrush(QColor(10, 10, 30, 180));
+    painter.drawRect(marco);
+
+    // Escalas comunes a las dos curvas
+    double tiempoMaximo = perfilReferencia.last().x();
+    double alturaMaxima = alturaObjetivo;
+    for(const QPointF& p : perfilReferencia) alturaMaxima = std::max(alturaMaxima, p.y());
+    for(const QPointF& p : perfilJugador) {
+        tiempoMaximo = std::max(tiempoMaximo, p.x());
+        alturaMaxima = std::max(alturaMaxima, p.y());
+    }
+    if(tiempoMaximo <= 0.0 || alturaMaxima <= 0.0) return;
+
+    auto aPixel = [&](const QPointF& p) {
+        return QPointF(marco.left() + marco.width() * p.x() / tiempoMaximo,
+                       marco.bottom() - marco.height() * p.y() / (alturaMaxima * 1.1));
+    };
+
+    // Altura objetivo
+    const double yObjetivo = aPixel(QPointF(0.0, alturaObjetivo)).y();
+    painter.setPen(QPen(QColor(0, 255, 0, 120), 1, Qt::DashLine));
+    painter.drawLine(QPointF(marco.left(), yObjetivo), QPointF(marco.right(), yObjetivo));
+
+    auto dibujarCurva = [&](const QVector<QPointF>& puntos, const QPen& lapiz) {
+        QPolygonF curva;
+        curva.reserve(puntos.size());
+        for(const QPointF& p : puntos) curva.append(aPixel(p));
+        painter.setPen(lapiz);
+        painter.setBrush(Qt::NoBrush);
+        painter.drawPolyline(curva);
+    };
+    dibujarCurva(perfilReferencia, QPen(QColor(0, 200, 255), 2, Qt::DashLine));
+    dibujarCurva(perfilJugador, QPen(QColor(233, 69, 96), 2));
+
+    painter.setFont(QFont("Arial", 8));
+    painter.setPen(QColor(0, 200, 255));
+    painter.drawText(QPointF(marco.left() + 5, marco.top() + 12), "Óptimo");
+    painter.setPen(QColor(233, 69, 96));
+    painter.drawText(QPointF(marco.left() + 55, marco.top() + 12), "Jugador");
+    painter.setPen(QColor(200, 200, 200));
+    painter.drawText(QPointF(marco.right() - 60, marco.bottom() - 4),
+                     QString("%1 s").arg(tiempoMaximo, 0, 'f', 0));
+}
+
+void VisualizacionWidget::establecerPrevision(const TrayectoriaPrevista& trayectoria)
+{
+    prevision = trayectoria;
+    hayPrevision = true;
+    update();
+}
+
+void VisualizacionWidget::limpiarPrevision()
+{
+    hayPrevision = false;
+    update();
+}
+
+void VisualizacionWidget::dibujarPrevision(QPainter& painter)
+{
+    if(!hayPrevision) return;
+
+    // Apogeo sobre la escena, a la escala del cohete
+    const double yApogeo = alturaAPixel(prevision.alturaApogeo);
+    if(prevision.alturaApogeo > 0.0 && yApogeo >= 0 && yApogeo <= height()) {
+        painter.setPen(QPen(QColor(255, 200, 0, 150), 1, Qt::DashLine));
+        painter.drawLine(QPointF(0, yApogeo), QPointF(width() - 60, yApogeo));
+        painter.setPen(QColor(255, 200, 0));
+        painter.setFont(QFont("Arial", 9));
+        painter.drawText(QPointF(width() / 2.0 + 40, yApogeo - 4),
+                         QString("Apogeo previsto: %1 km").arg(prevision.alturaApogeo / 1000.0, 0, 'f', 1));
+    }
+
+    // Curva de altura contra tiempo en el mismo recuadro que los perfiles
+    const QRectF marco(40, 40, 220, 130);
+    painter.setPen(QPen(QColor(150, 150, 150, 150), 1));
+    painter.setBrush(QColor(10, 10, 30, 180));
+    painter.drawRect(marco);
+
+    // Un salto que vuelve al suelo se dibuja a su propia escala: contra los
+    // 100 km del objetivo quedaría pegado al eje
+    const bool vuelveAlSuelo = prevision.desenlace == DesenlaceTrayectoria::Aterrizaje ||
+                               prevision.desenlace == DesenlaceTrayectoria::SinDespegue;
+    const double tiempoMaximo = std::max(prevision.tiempoFinal, 1.0);
+    const double alturaMaxima = vuelveAlSuelo ? std::max(prevision.alturaApogeo, 1.0) * 1.1
+                                              : std::max(prevision.alturaApogeo, alturaObjetivo) * 1.1;
+    auto aPixel = [&](double t, double h) {
+        return QPointF(marco.left() + marco.width() * t / tiempoMaximo,
+                       marco.bottom() - marco.height() * h / alturaMaxima);
+    };
+
+    if(!vuelveAlSuelo) {
+        const double yObjetivo = aPixel(0.0, alturaObjetivo).y();
+        painter.setPen(QPen(QColor(0, 255, 0, 120), 1, Qt::DashLine));
+        painter.drawLine(QPointF(marco.left(), yObjetivo), QPointF(marco.right(), yObjetivo));
+    }
+
+    QPolygonF curva;
+    curva.reserve(static_cast<int>(prevision.alturas.size()) + 1);
+    for(std::size_t i = 0; i < prevision.alturas.size(); ++i) {
+        curva.append(aPixel(i * prevision.intervalo, prevision.alturas[i]));
+    }
+    curva.append(aPixel(prevision.tiempoFinal, prevision.alturaFinal));
+    // Interpolada: punteada hasta que llega la simulación exacta
+    painter.setPen(QPen(QColor(255, 200, 0), 2, prevision.exacta ? Qt::SolidLine : Qt::DotLine));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawPolyline(curva);
+
+    painter.setBrush(QColor(255, 200, 0));
+    painter.drawEllipse(aPixel(prevision.tiempoApogeo, prevision.alturaApogeo), 3, 3);
+
+    QString desenlace;
+    QColor colorDesenlace;
+    const QPointF puntoFinal = aPixel(prevision.tiempoFinal, prevision.alturaFinal);
+    switch(prevision.desenlace) {
+    case DesenlaceTrayectoria::Orbita:
+        desenlace = QString("Llega a %1 km en %2 s")
+                        .arg(alturaObjetivo / 1000.0, 0, 'f', 0)
+                        .arg(prevision.tiempoFinal, 0, 'f', 1);
+        colorDesenlace = QColor(0, 255, 0);
+        break;
+    case DesenlaceTrayectoria::Quemadura:
+        desenlace = QString("Se quema a %1 km (t = %2 s)")
+                        .arg(prevision.alturaFinal / 1000.0, 0, 'f', 1)
+                        .arg(prevision.tiempoFinal, 0, 'f', 1);
+        colorDesenlace = QColor(255, 60, 60);
+        break;
+    case DesenlaceTrayectoria::Impacto:
+        desenlace = QString("Cae a los %1 s").arg(prevision.tiempoFinal, 0, 'f', 1);
+        colorDesenlace = QColor(255, 60, 60);
+        break;
+    case DesenlaceTrayectoria::Aterrizaje:
+        desenlace = QString("Sube %1 m y vuelve al suelo a los %2 s")
+                        .arg(prevision.alturaApogeo, 0, 'f', 0)
+                        .arg(prevision.tiempoFinal, 0, 'f', 1);
+        colorDesenlace = QColor(200, 200, 200);
+        break;
+    case DesenlaceTrayectoria::SinDespegue:
+        desenlace = "No despega";
+        colorDesenlace = QColor(200, 200, 200);
+        break;
+    case DesenlaceTrayectoria::TiempoAgotado:
+        desenlace = QString("Sigue en vuelo a los %1 s").arg(prevision.tiempoFinal, 0, 'f', 0);
+        colorDesenlace = QColor(200, 200, 200);
+        break;
+    }
+    painter.setPen(QPen(colorDesenlace, 2));
+    painter.drawLine(puntoFinal + QPointF(-4, -4), puntoFinal + QPointF(4, 4));
+    painter.drawLine(puntoFinal + QPointF(-4, 4), puntoFinal + QPointF(4, -4));
+
+    painter.setFont(QFont("Arial", 8));
+    painter.setPen(QColor(255, 200, 0));
+    painter.drawText(QPointF(marco.left() + 5, marco.top() + 12),
+                     QString("Sin motor desde %1 m/s%2")
+                         .arg(prevision.velocidadInicial, 0, 'f', 0)
+                         .arg(prevision.exacta ? "" : " (aprox.)"));
+    painter.setPen(colorDesenlace);
+    painter.drawText(QPointF(marco.left() + 5, marco.top() + 24), desenlace);
+    painter.setPen(QColor(200, 200, 200));
+    painter.drawText(QPointF(marco.right() - 60, marco.bottom() - 4),
+                     QString("%1 s").arg(tiempoMaximo, 0, 'f', 0));
+}
+
+void VisualizacionWidget::establecerPrediccion(const std::vector<PuntoPrevisto>& puntos,
+                                               const std::vector<MarcaPrevision>& marcas,
+                                               double tiempoActual)
+{
+    // Se asigna sobre los mismos vectores: tras los primeros frames no
+    // reserva memoria
+    prediccion = puntos;
+    marcasPrediccion = marcas;
+    tiempoPrediccion = tiempoActual;
+}
+
+void VisualizacionWidget::dibujarPrediccion(QPainter& painter)
+{
+    if(prediccion.empty() || !coheteActual || numeroNivel < 2) return;
+
+    // En el nivel 2 el cohete no se mueve de lado: el camino se abre hacia
+    // la derecha a razón de un horizonte de previsión por media pantalla
+    const double pixelesPorSegundo = (width() / 2.0 - 70.0) / PredictorTrayectoria::HORIZONTE;
+    auto aPixel = [&](double tiempo, double altura, double posicionX) {
+        const double x = (numeroNivel == 3)
+            ? posicionXAPixel(posicionX)
+            : posicionCohete.x() + (tiempo - tiempoPrediccion) * pixelesPorSegundo;
+        return QPointF(x, alturaAPixel(altura));
+    };
+
+    QPolygonF camino;
+    camino.reserve(static_cast<int>(prediccion.size()) + 1);
+    camino.append(posicionCohete);
+    for(const PuntoPrevisto& punto : prediccion) {
+        camino.append(aPixel(punto.tiempo, punto.altura, punto.posicionX));
+    }
+    painter.setPen(QPen(QColor(120, 200, 255, 170), 2, Qt::DashLine));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawPolyline(camino);
+
+    painter.setFont(QFont("Arial", 8));
+    for(const MarcaPrevision& marca : marcasPrediccion) {
+        QString texto;
+        QColor color;
+        switch(marca.tipo) {
+        case TipoMarcaPrevision::SinCombustible:
+            texto = "Sin combustible";
+            color = QColor(255, 170, 0);
+            break;
+        case TipoMarcaPrevision::SobreVelocidadSegura:
+            texto = "Sobre la velocidad segura";
+            color = QColor(255, 80, 80);
+            break;
+        case TipoMarcaPrevision::BajoVelocidadSegura:
+            texto = "Bajo la velocidad segura";
+            color = QColor(255, 80, 80);
+            break;
+        case TipoMarcaPrevision::VelocidadMaxima:
+            texto = "Destrucción por velocidad";
+            color = QColor(255, 0, 0);
+            break;
+        case TipoMarcaPrevision::Victoria:
+            texto = "Objetivo";
+            color = QColor(0, 255, 0);
+            break;
+        case TipoMarcaPrevision::Derrota:
+            texto = "Fin de la misión";
+            color = QColor(255, 0, 0);
+            break;
+        }
+
+        const QPointF punto = aPixel(marca.tiempo, marca.altura, marca.posicionX);
+        painter.setPen(QPen(color, 2));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawEllipse(punto, 5, 5);
+        painter.drawText(punto + QPointF(8, 4), texto);
+    }
+}
+
 void VisualizacionWidget::dibujarLineaObjetivo(QPainter& painter)
 {
-    if(!nivelActual) return;
+    if(numeroNivel == 0) return;
 
-    double alturaObjetivo = nivelActual->obtenerAlturaObjetivo();
     double yObjetivo = alturaAPixel(alturaObjetivo);
 
     if(yObjetivo >= 0 && yObjetivo <= height()) {
@@ -588,31 +885,39 @@ void VisualizacionWidget::calcularPosicionCohete()
     if(!coheteActual) return;
 
     double altura = coheteActual->obtenerAltura();
+    double posicionX = coheteActual->obtenerPosicionX();
+
+    // Interpolar entre el paso de física anterior y el actual para que el
+    // movimiento se vea continuo aunque la física avance a saltos
+    if(coheteAnterior && !coheteActual->estaDanado()) {
+        double a = factorInterpolacion;
+        altura = coheteAnterior->obtenerAltura() * (1.0 - a) + altura * a;
+        posicionX = coheteAnterior->obtenerPosicionX() * (1.0 - a) + posicionX * a;
+    }
 
     double y = alturaAPixel(altura);
 
     // Para nivel 3, usar la posición X del cohete; para otros niveles, centrar
-    double x;
-    if(numeroNivel == 3) {
-        // Convertir posición X del cohete (en metros) a píxeles
-        // Asumimos que el ancho del nivel es 2000 metros (aproximadamente)
-        double anchoNivelMetros = 2000.0;
-        double escalaX = width() / anchoNivelMetros;
-        x = (width() / 2.0) + (coheteActual->obtenerPosicionX() * escalaX);
-        
-        // Limitar dentro de los bordes
-        if(x < 25) x = 25;
-        if(x > width() - 25) x = width() - 25;
-    } else {
-        x = width() / 2.0;
-    }
+    double x = (numeroNivel == 3) ? posicionXAPixel(posicionX) : width() / 2.0;
 
     posicionCohete = QPointF(x, y);
 }
 
+double VisualizacionWidget::posicionXAPixel(double posicionX) const
+{
+    // Convertir posición X del cohete (en metros) a píxeles
+    // Asumimos que el ancho del nivel es 2000 metros (aproximadamente)
+    double anchoNivelMetros = 2000.0;
+    double escalaX = width() / anchoNivelMetros;
+    double x = (width() / 2.0) + (posicionX * escalaX);
+
+    // Limitar dentro de los bordes
+    return std::clamp(x, 25.0, width() - 25.0);
+}
+
 void VisualizacionWidget::calcularEscalaAltura()
 {
-    if(!nivelActual) return;
+    if(numeroNivel == 0) return;
 
     switch(numeroNivel) {
     case 1:
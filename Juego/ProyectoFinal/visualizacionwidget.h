@@ -5,11 +5,13 @@
 #include <QPainter>
 #include <QTimer>
 #include <QPixmap>
+#include <QVector>
 #include <QSoundEffect>
 #include <QMediaPlayer>
 #include <QAudioOutput>
-#include "Cohete.h"
-#include "Nivel.h"
+#include "bibliotecatrayectorias.h"
+#include "cohete.h"
+#include "predictortrayectoria.h"
 
 class VisualizacionWidget : public QWidget
 {
@@ -19,21 +21,55 @@ public:
     explicit VisualizacionWidget(QWidget *parent = nullptr);
     ~VisualizacionWidget();
 
-    // Métodos para actualizar el estado
-    void actualizarCohete(const Cohete* cohete);
-    void actualizarNivel(const Nivel* nivel, int numeroNivel);
+    // Métodos para actualizar el estado. El widget guarda copias: la
+    // simulación corre en otro hilo y no se apunta a su estado vivo.
+    // 'anterior' y 'alfa' permiten dibujar el cohete entre los dos últimos
+    // pasos de física: posición = anterior + (actual - anterior) * alfa
+    void actualizarCohete(const Cohete* cohete,
+                          const Cohete* anterior = nullptr,
+                          double alfa = 1.0);
+    void actualizarNivel(double alturaObjetivo, int numeroNivel);
     void iniciarAnimacion();
     void detenerAnimacion();
     void reiniciar();
 
+    // Gráfico de altura contra tiempo: un perfil de referencia (por ejemplo
+    // el programa de empuje óptimo) y la corrida del jugador encima
+    void establecerPerfilReferencia(const QVector<QPointF>& puntos); // (s, m)
+    void agregarPuntoJugador(double tiempo, double altura);
+    void limpiarPerfiles();
+
+    // Vuelo previsto del nivel 1 para la velocidad inicial elegida: curva
+    // de altura, apogeo y dónde se quema o termina
+    void establecerPrevision(const TrayectoriaPrevista& trayectoria);
+    void limpiarPrevision();
+
+    // Niveles 2 y 3: camino por delante del cohete si los controles quedan
+    // como están. En el nivel 2 el eje horizontal es el tiempo.
+    void establecerPrediccion(const std::vector<PuntoPrevisto>& puntos,
+                              const std::vector<MarcaPrevision>& marcas,
+                              double tiempoActual);
+
 protected:
     void paintEvent(QPaintEvent *event) override;
 
 private:
-    // Datos del cohete
+    // Datos del cohete (apuntan a las copias o son nulos)
+    Cohete copiaCohete;
+    Cohete copiaAnterior;
     const Cohete* coheteActual;
-    const Nivel* nivelActual;
-    int numeroNivel;
+    const Cohete* coheteAnterior;   // Estado del paso de física anterior
+    double factorInterpolacion;     // 0 = anterior, 1 = actual
+    double alturaObjetivo;
+    int numeroNivel;                // 0 = sin nivel cargado
+
+    QVector<QPointF> perfilReferencia;
+    QVector<QPointF> perfilJugador;
+    TrayectoriaPrevista prevision;
+    bool hayPrevision;
+    std::vector<PuntoPrevisto> prediccion;
+    std::vector<MarcaPrevision> marcasPrediccion;
+    double tiempoPrediccion;
 
     // Control de animación
     QTimer* timerAnimacion;
@@ -85,10 +121,14 @@ private:
     void dibujarLuna(QPainter& painter); 
     void dibujarExplosion(QPainter& painter);
     void dibujarAreaAterrizaje(QPainter& painter); 
+    void dibujarPerfiles(QPainter& painter);
+    void dibujarPrevision(QPainter& painter);
+    void dibujarPrediccion(QPainter& painter);
 
     void calcularPosicionCohete();
     void calcularEscalaAltura();
     double alturaAPixel(double altura) const;
+    double posicionXAPixel(double posicionX) const; // Solo nivel 3
     void cargarSprites();
     void dividirSpriteSheet();
     void dividirSpriteSheetExplosion();
@@ -0,0 +1,23 @@
+TEMPLATE = app
+CONFIG += console c++17
+CONFIG -= qt app_bundle
+
+TARGET = SimuladorLotes
+
+SOURCES += \
+    main.cpp
+
+INCLUDEPATH += $$PWD/../ProyectoFinal
+DEPENDPATH += $$PWD/../ProyectoFinal
+
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../NucleoSimulacion/release/ -lNucleoSimulacion
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../NucleoSimulacion/debug/ -lNucleoSimulacion
+else:unix: LIBS += -L$$OUT_PWD/../NucleoSimulacion/ -lNucleoSimulacion
+
+win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../NucleoSimulacion/release/libNucleoSimulacion.a
+else:win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../NucleoSimulacion/debug/libNucleoSimulacion.a
+else:win32:!win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../NucleoSimulacion/release/NucleoSimulacion.lib
+else:win32:!win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../NucleoSimulacion/debug/NucleoSimulacion.lib
+else:unix: PRE_TARGETDEPS += $$OUT_PWD/../NucleoSimulacion/libNucleoSimulacion.a
+
+unix: LIBS += -pthread
@@ -0,0 +1,692 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "cohete.h"
+#include "cohetebatch.h"
+#include "ejecutorlotes.h"
+#include "evaluadorrobustez.h"
+#include "generadorsplitmix.h"
+#include "grupohilos.h"
+#include "juego.h"
+#include "nivel1_sputnik.h"
+#include "nivel2_vostok.h"
+#include "nivel3_apolo11.h"
+#include "optimizadorvostok.h"
+#include "tablaalunizaje.h"
+
+namespace {
+
+struct Opciones {
+    int nivel = 2;
+    std::size_t misiones = 10000;
+    unsigned hilos = 0;
+    TipoIntegrador integrador = TipoIntegrador::Euler;
+    double paso = 0.1;
+    double tolerancia = 1e-6;
+    bool avanceBalistico = false;
+    bool compararIntegradores = false;
+    bool verificarLote = false;
+    bool medirTick = false;
+    std::size_t escenariosRobustez = 0;
+    std::uint64_t semilla = 1;
+    bool autopiloto = false;
+    bool sensores = false;
+    bool optimizarVostok = false;
+    double velocidadInicial = 0.0;
+    std::string rutaPrograma;  // --programa: misión a correr
+    std::string rutaGuardar;   // --guardar-programa: salida de --optimizar-vostok
+    std::string rutaTabla;     // --generar-tabla-alunizaje: archivo a escribir
+};
+
+void mostrarAyuda() {
+    std::cout << "Uso: SimuladorLotes [opciones]\n"
+              << "  --nivel N       Nivel a simular (1, 2 o 3). Por defecto 2.\n"
+              << "  --misiones N    Cantidad de misiones del barrido. Por defecto 10000.\n"
+              << "  --hilos N       Hilos a usar (0 = todos los nucleos). Por defecto 0.\n"
+              << "  --integrador I  euler, rk4, verlet o dp (Dormand-Prince). Por defecto euler.\n"
+              << "  --paso S        Paso de fisica en segundos. Por defecto 0.1.\n"
+              << "  --tolerancia E  Tolerancia de Dormand-Prince. Por defecto 1e-6.\n"
+              << "  --balistico     Salta en forma cerrada los tramos sin empuje fuera de\n"
+              << "                  la atmosfera (o en la Luna).\n"
+              << "  --comparar-integradores\n"
+              << "                  Compara precision y pasos de cada integrador en el\n"
+              << "                  ascenso de 400 s del nivel 2.\n"
+              << "  --verificar-lote\n"
+              << "                  Avanza el barrido 300 s con la fisica escalar de cada\n"
+              << "                  nivel y con CoheteBatch (SIMD), compara los estados y\n"
+              << "                  mide pasos de cohete por segundo.\n"
+              << "  --medir-tick    Mide el costo por paso de Juego en un solo hilo.\n"
+              << "  --robustez N    Prueba la mejor mision del barrido contra N escenarios\n"
+              << "                  perturbados (empuje, arrastre, combustible inicial y\n"
+              << "                  velocidad de descenso del nivel 3).\n"
+              << "  --semilla S     Semilla de los escenarios de --robustez. Por defecto 1.\n"
+              << "  --autopiloto    Nivel 3: el piloto automatico controla cada mision y el\n"
+              << "                  barrido varia la velocidad de descenso (-10 a -300 m/s).\n"
+              << "  --sensores      El piloto automatico vuela con la estimacion de sensores\n"
+              << "                  con ruido y retraso (filtro de Kalman) en lugar del\n"
+              << "                  estado exacto. Cada mision usa su propio ruido.\n"
+              << "  --optimizar-vostok\n"
+              << "                  Busca el programa de empuje de minimo combustible que\n"
+              << "                  gana el nivel 2 partiendo de --velocidad.\n"
+              << "  --guardar-programa RUTA\n"
+              << "                  Guarda el programa de --optimizar-vostok.\n"
+              << "  --programa RUTA Corre un programa de empuje guardado en el nivel\n"
+              << "                  elegido partiendo de --velocidad y muestra su trayectoria.\n"
+              << "  --velocidad V   Velocidad inicial (m/s) para las dos opciones anteriores.\n"
+              << "  --generar-tabla-alunizaje RUTA\n"
+              << "                  Calcula la tabla de alunizaje que consulta HAL-69 en el\n"
+              << "                  nivel 3 y la guarda en RUTA. El juego la busca como\n"
+              << "                  " << TablaAlunizaje::RUTA_PREDETERMINADA
+              << " junto a su ejecutable.\n"
+              << "                  Tarda alrededor de un minuto con un nucleo.\n"
+              << "  --ayuda         Muestra esta ayuda.\n";
+}
+
+bool leerIntegrador(const char* nombre, TipoIntegrador& tipo) {
+    if (std::strcmp(nombre, "euler") == 0) {
+        tipo = TipoIntegrador::Euler;
+    } else if (std::strcmp(nombre, "rk4") == 0) {
+        tipo = TipoIntegrador::RK4;
+    } else if (std::strcmp(nombre, "verlet") == 0) {
+        tipo = TipoIntegrador::VelocityVerlet;
+    } else if (std::strcmp(nombre, "dp") == 0) {
+        tipo = TipoIntegrador::DormandPrince;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* nombreIntegrador(TipoIntegrador tipo) {
+    switch (tipo) {
+    case TipoIntegrador::RK4: return "RK4";
+    case TipoIntegrador::VelocityVerlet: return "Velocity-Verlet";
+    case TipoIntegrador::DormandPrince: return "Dormand-Prince";
+    case TipoIntegrador::Euler:
+    default: return "Euler";
+    }
+}
+
+bool leerOpciones(int argc, char* argv[], Opciones& opciones) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool tieneValor = (i + 1 < argc);
+
+        if (std::strcmp(arg, "--nivel") == 0 && tieneValor) {
+            opciones.nivel = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--misiones") == 0 && tieneValor) {
+            opciones.misiones = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--hilos") == 0 && tieneValor) {
+            opciones.hilos = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--integrador") == 0 && tieneValor) {
+            if (!leerIntegrador(argv[++i], opciones.integrador)) return false;
+        } else if (std::strcmp(arg, "--paso") == 0 && tieneValor) {
+            opciones.paso = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--tolerancia") == 0 && tieneValor) {
+            opciones.tolerancia = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--balistico") == 0) {
+            opciones.avanceBalistico = true;
+        } else if (std::strcmp(arg, "--comparar-integradores") == 0) {
+            opciones.compararIntegradores = true;
+        } else if (std::strcmp(arg, "--verificar-lote") == 0) {
+            opciones.verificarLote = true;
+        } else if (std::strcmp(arg, "--medir-tick") == 0) {
+            opciones.medirTick = true;
+        } else if (std::strcmp(arg, "--robustez") == 0 && tieneValor) {
+            opciones.escenariosRobustez = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--semilla") == 0 && tieneValor) {
+            opciones.semilla = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--autopiloto") == 0) {
+            opciones.autopiloto = true;
+        } else if (std::strcmp(arg, "--sensores") == 0) {
+            opciones.sensores = true;
+        } else if (std::strcmp(arg, "--optimizar-vostok") == 0) {
+            opciones.optimizarVostok = true;
+        } else if (std::strcmp(arg, "--guardar-programa") == 0 && tieneValor) {
+            opciones.rutaGuardar = argv[++i];
+        } else if (std::strcmp(arg, "--programa") == 0 && tieneValor) {
+            opciones.rutaPrograma = argv[++i];
+        } else if (std::strcmp(arg, "--velocidad") == 0 && tieneValor) {
+            opciones.velocidadInicial = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--generar-tabla-alunizaje") == 0 && tieneValor) {
+            opciones.rutaTabla = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    return opciones.nivel >= 1 && opciones.nivel <= 3 && opciones.misiones > 0 &&
+           opciones.paso > 0.0;
+}
+
+// Genera un barrido de misiones del nivel pedido variando la velocidad
+// inicial y el programa de empuje.
+std::vector<Mision> generarBarrido(const Opciones& opciones) {
+    std::vector<Mision> misiones;
+    misiones.reserve(opciones.misiones);
+
+    for (std::size_t i = 0; i < opciones.misiones; ++i) {
+        // Fracciones pseudoaleatorias bien repartidas (secuencia de Weyl)
+        const double a = std::fmod(0.5 + i * 0.6180339887498949, 1.0);
+        const double b = std::fmod(0.5 + i * 0.7548776662466927, 1.0);
+        const double c = std::fmod(0.5 + i * 0.5698402909980532, 1.0);
+
+        Mision mision;
+        mision.nivel = opciones.nivel;
+        mision.velocidadInicial = 0.0;
+        mision.integrador = opciones.integrador;
+        mision.pasoFisica = opciones.paso;
+        mision.tolerancia = opciones.tolerancia;
+        mision.avanceBalistico = opciones.avanceBalistico;
+        mision.sensores = opciones.sensores;
+        mision.configuracionSensores.semilla = GeneradorSplitMix(opciones.semilla, i).siguiente();
+
+        switch (opciones.nivel) {
+        case 1:
+            mision.velocidadInicial = 10000.0 * a;
+            mision.programa.agregarTramo(0.0, 100000.0 * b);
+            break;
+        case 2:
+            // Velocidad heredada del nivel 1, ascenso fuerte y luego sostenimiento
+            mision.velocidadInicial = 6000.0 * a;
+            mision.programa.agregarTramo(0.0, 100000.0 + 400000.0 * a);
+            mision.programa.agregarTramo(10.0 + 290.0 * b, 200000.0 * c);
+            break;
+        case 3:
+            if (opciones.autopiloto) {
+                mision.autopiloto = true;
+                mision.velocidadInicial = -10.0 - 290.0 * a;
+                break;
+            }
+            // Caída libre y encendido tardío para frenar
+            mision.programa.agregarTramo(0.0, 0.0);
+            mision.programa.agregarTramo(20.0 + 100.0 * a, 20000.0 + 80000.0 * b);
+            break;
+        }
+
+        misiones.push_back(std::move(mision));
+    }
+
+    return misiones;
+}
+
+struct ResultadoAscenso {
+    double altura;
+    double velocidad;
+    double combustible;
+    long pasos;
+};
+
+// Ascenso fijo de 400 s del nivel 2 (velocidad heredada de 3000 m/s y
+// empuje constante) usado para comparar integradores.
+ResultadoAscenso simularAscensoVostok(TipoIntegrador tipo, double paso, double tolerancia) {
+    const double DURACION = 400.0;
+
+    Nivel2_Vostok nivel;
+    nivel.establecerIntegrador(tipo, tolerancia);
+
+    Cohete cohete;
+    cohete.configurarParaNivel(2);
+    cohete.reiniciarEstado();
+    cohete.establecerVelocidadInicial(3000.0);
+    cohete.ajustarEmpuje(150000.0);
+
+    const long numeroPasos = std::lround(DURACION / paso);
+    long pasos = 0;
+    for (long i = 0; i < numeroPasos; ++i) {
+        nivel.aplicarFisica(&cohete, paso);
+        pasos += (tipo == TipoIntegrador::Euler) ? 1 : nivel.obtenerPasosUltimaIntegracion();
+    }
+
+    return {cohete.obtenerAltura(), cohete.obtenerVelocidad(), cohete.obtenerCombustible(), pasos};
+}
+
+void compararIntegradores() {
+    struct Configuracion {
+        TipoIntegrador tipo;
+        double paso;
+        double tolerancia;
+    };
+
+    const ResultadoAscenso referencia =
+        simularAscensoVostok(TipoIntegrador::RK4, 0.001, 0.0);
+
+    const Configuracion configuraciones[] = {
+        {TipoIntegrador::Euler, 0.1, 0.0},
+        {TipoIntegrador::Euler, 0.01, 0.0},
+        {TipoIntegrador::VelocityVerlet, 0.1, 0.0},
+        {TipoIntegrador::RK4, 0.1, 0.0},
+        {TipoIntegrador::RK4, 1.0, 0.0},
+        {TipoIntegrador::DormandPrince, 400.0, 1e-6},
+        {TipoIntegrador::DormandPrince, 400.0, 1e-9},
+    };
+
+    std::cout << "Referencia (RK4, paso 0.001 s): altura " << referencia.altura
+              << " m, velocidad " << referencia.velocidad << " m/s\n\n";
+    std::cout << std::left << std::setw(18) << "Integrador" << std::setw(10) << "Paso"
+              << std::setw(12) << "Tolerancia" << std::setw(10) << "Pasos"
+              << std::setw(16) << "Error h (m)" << "Error v (m/s)\n";
+
+    for (const Configuracion& config : configuraciones) {
+        ResultadoAscenso r = simularAscensoVostok(config.tipo, config.paso, config.tolerancia);
+        std::cout << std::left << std::setw(18) << nombreIntegrador(config.tipo)
+                  << std::setw(10) << config.paso
+                  << std::setw(12) << config.tolerancia
+                  << std::setw(10) << r.pasos
+                  << std::setw(16) << std::abs(r.altura - referencia.altura)
+                  << std::abs(r.velocidad - referencia.velocidad) << "\n";
+    }
+}
+
+// Estado inicial de una misión tal como lo deja cada nivel al empezar
+Cohete prepararCohete(const Mision& mision) {
+    Cohete cohete;
+    cohete.configurarParaNivel(mision.nivel);
+    cohete.reiniciarEstado();
+    if (mision.nivel == 3) {
+        // Nivel3_Apolo11 coloca el módulo en su primer paso de física
+        cohete.establecerAltura(Nivel3_Apolo11().obtenerAlturaInicial());
+        cohete.establecerVelocidadInicial(mision.velocidadInicial != 0.0
+                                              ? mision.velocidadInicial
+                                              : Nivel3_Apolo11().obtenerVelocidadDescensoInicial());
+    } else {
+        cohete.establecerVelocidadInicial(mision.velocidadInicial);
+    }
+    return cohete;
+}
+
+double segundosDesde(std::chrono::steady_clock::time_point inicio) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+// Avanza las misiones con CoheteBatch repartiendo bloques de cohetes entre
+// los hilos del grupo. Cada bloque hace todos sus pasos seguidos para que
+// sus arreglos sigan en caché.
+void avanzarLote(CoheteBatch& lote, const std::vector<Mision>& misiones,
+                 const ParametrosLote& parametros, double paso, int numeroPasos,
+                 GrupoHilos& grupo) {
+    const std::size_t BLOQUE = 256;
+    const std::size_t n = misiones.size();
+    const std::size_t bloques = (n + BLOQUE - 1) / BLOQUE;
+
+    grupo.paraCada(bloques, [&](std::size_t b) {
+        const std::size_t inicio = b * BLOQUE;
+        const std::size_t fin = std::min(n, inicio + BLOQUE);
+        std::vector<std::size_t> cursores(fin - inicio, 0);
+
+        for (int k = 0; k < numeroPasos; ++k) {
+            const double t = k * paso;
+            for (std::size_t i = inicio; i < fin; ++i) {
+                lote.ajustarEmpuje(i, misiones[i].programa.empujeEn(t, cursores[i - inicio]));
+            }
+            lote.avanzar(parametros, paso, inicio, fin);
+        }
+    });
+}
+
+template<class NivelT>
+void verificarLote(const std::vector<Mision>& misiones, unsigned hilos) {
+    const double PASO = 0.1;
+    const int NUMERO_PASOS = 3000;
+    const std::size_t n = misiones.size();
+    const double pasosCohete = static_cast<double>(n) * NUMERO_PASOS;
+
+    // Camino escalar: un Cohete y un nivel por misión
+    std::vector<Cohete> cohetes(n);
+    auto inicio = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < n; ++i) {
+        NivelT nivel;
+        Cohete cohete = prepararCohete(misiones[i]);
+        std::size_t cursor = 0;
+        for (int k = 0; k < NUMERO_PASOS; ++k) {
+            cohete.ajustarEmpuje(misiones[i].programa.empujeEn(k * PASO, cursor));
+            nivel.aplicarFisica(&cohete, PASO);
+        }
+        cohetes[i] = cohete;
+    }
+    const double segundosEscalar = segundosDesde(inicio);
+
+    const ParametrosLote parametros = ParametrosLote::desdeNivel(NivelT());
+
+    auto cargarLote = [&](CoheteBatch& lote) {
+        for (std::size_t i = 0; i < n; ++i) {
+            lote.cargar(i, prepararCohete(misiones[i]));
+        }
+    };
+
+    CoheteBatch lote(n);
+    cargarLote(lote);
+    GrupoHilos sinAyudantes(0);
+    inicio = std::chrono::steady_clock::now();
+    avanzarLote(lote, misiones, parametros, PASO, NUMERO_PASOS, sinAyudantes);
+    const double segundosLote = segundosDesde(inicio);
+
+    CoheteBatch loteParalelo(n);
+    cargarLote(loteParalelo);
+    GrupoHilos grupo((hilos == 0 ? GrupoHilos::hilosDisponibles() : hilos) - 1);
+    inicio = std::chrono::steady_clock::now();
+    avanzarLote(loteParalelo, misiones, parametros, PASO, NUMERO_PASOS, grupo);
+    const double segundosParalelo = segundosDesde(inicio);
+
+    double errorAltura = 0.0;
+    double errorVelocidad = 0.0;
+    double errorCombustible = 0.0;
+    std::size_t danosDistintos = 0;
+    std::size_t distintosEntreLotes = 0;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const Cohete& c = cohetes[i];
+        errorAltura = std::max(errorAltura, std::abs(lote.obtenerAltura(i) - c.obtenerAltura()));
+        errorVelocidad = std::max(errorVelocidad,
+                                  std::abs(lote.obtenerVelocidad(i) - c.obtenerVelocidad()));
+        errorCombustible = std::max(errorCombustible,
+                                    std::abs(lote.obtenerCombustible(i) - c.obtenerCombustible()));
+        if (lote.estaDanado(i) != c.estaDanado()) ++danosDistintos;
+
+        if (lote.obtenerAltura(i) != loteParalelo.obtenerAltura(i) ||
+            lote.obtenerVelocidad(i) != loteParalelo.obtenerVelocidad(i)) {
+            ++distintosEntreLotes;
+        }
+    }
+
+    std::cout << n << " cohetes x " << NUMERO_PASOS << " pasos de " << PASO
+              << " s, kernels " << CoheteBatch::obtenerConjuntoInstrucciones() << "\n";
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  Escalar (1 hilo):        " << segundosEscalar << " s, "
+              << pasosCohete / segundosEscalar / 1e6 << " M pasos/s\n";
+    std::cout << "  CoheteBatch (1 hilo):    " << segundosLote << " s, "
+              << pasosCohete / segundosLote / 1e6 << " M pasos/s ("
+              << segundosEscalar / segundosLote << "x)\n";
+    std::cout << "  CoheteBatch (" << grupo.obtenerNumeroHilos() + 1 << " hilos):   "
+              << segundosParalelo << " s, "
+              << pasosCohete / segundosParalelo / 1e6 << " M pasos/s ("
+              << segundosEscalar / segundosParalelo << "x)\n";
+    std::cout << std::scientific << std::setprecision(2);
+    std::cout << "Diferencia maxima contra el camino escalar:\n"
+              << "  altura " << errorAltura << " m, velocidad " << errorVelocidad
+              << " m/s, combustible " << errorCombustible << " kg\n"
+              << "  Cohetes con distinto estado de dano: " << danosDistintos << "\n"
+              << "  Cohetes distintos entre 1 y " << grupo.obtenerNumeroHilos() + 1
+              << " hilos: " << distintosEntreLotes << "\n";
+}
+
+// Costo por paso de Juego: misiones completas en un solo hilo
+void medirTick(const std::vector<Mision>& misiones) {
+    // Bucle de un paso por llamada (como el temporizador de la interfaz)
+    // frente a ejecutarMision, que avanza de un cambio de empuje al siguiente.
+    long pasosTick = 0;
+    auto inicio = std::chrono::steady_clock::now();
+    for (const Mision& mision : misiones) {
+        Juego juego;
+        juego.establecerModoSilencioso(true);
+        juego.establecerPasoFisica(mision.pasoFisica);
+        juego.establecerIntegrador(mision.integrador, mision.tolerancia);
+        juego.iniciarNivel(mision.nivel);
+        if (mision.nivel != 3) {
+            juego.establecerVelocidadInicial(mision.velocidadInicial);
+        }
+        juego.iniciarSimulacion();
+
+        std::size_t cursor = 0;
+        while (juego.estaEnEjecucion() && !juego.haGanado() && !juego.haPerdido()) {
+            juego.ajustarEmpuje(mision.programa.empujeEn(juego.obtenerTiempoSimulacion(), cursor));
+            juego.actualizar();
+            ++pasosTick;
+        }
+    }
+    const double segundosTick = segundosDesde(inicio);
+
+    long pasos = 0;
+    inicio = std::chrono::steady_clock::now();
+    for (const Mision& mision : misiones) {
+        Juego juego;
+        juego.establecerModoSilencioso(true);
+        ResultadoMision r = EjecutorLotes::ejecutarMision(juego, mision);
+        // r.tiempo es el instante exacto del evento final, dentro del último paso
+        pasos += static_cast<long>(std::ceil(r.tiempo / mision.pasoFisica - 1e-9));
+    }
+    const double segundos = segundosDesde(inicio);
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "actualizar():   " << pasosTick << " pasos, "
+              << segundosTick * 1e9 / pasosTick << " ns/paso\n";
+    std::cout << "ejecutarMision: " << pasos << " pasos, "
+              << segundos * 1e9 / pasos << " ns/paso\n";
+}
+
+void mostrarRobustez(const Mision& mision, const Opciones& opciones) {
+    EvaluadorRobustez evaluador(opciones.hilos);
+    const Dispersiones dispersiones;
+
+    std::cout << "\nRobustez ante " << opciones.escenariosRobustez
+              << " escenarios perturbados (semilla " << opciones.semilla << "):\n";
+
+    auto inicio = std::chrono::steady_clock::now();
+    ResultadoRobustez r = evaluador.evaluar(mision, dispersiones,
+                                            opciones.escenariosRobustez, opciones.semilla);
+    const double segundos = segundosDesde(inicio);
+
+    std::cout << "  Exito: " << 100.0 * r.probabilidadExito << " % (+/- "
+              << 100.0 * r.margenExito95 << " %, " << r.victorias << " de "
+              << r.escenarios << ")\n";
+    if (r.victorias > 0) {
+        std::cout << "  Combustible restante P5/P50/P95: " << r.combustibleP5 << " / "
+                  << r.combustibleP50 << " / " << r.combustibleP95 << " kg\n";
+    }
+    for (const auto& [razon, cantidad] : r.razonesDerrota) {
+        std::cout << "  " << cantidad << " x " << razon << "\n";
+    }
+    std::cout << "  (" << segundos << " s con " << evaluador.obtenerNumeroHilos() << " hilos)\n";
+}
+
+void mostrarTrayectoria(const Mision& mision) {
+    std::cout << "  t (s)   altura (km)   velocidad (m/s)   combustible (kg)\n";
+    for (const PuntoTrayectoria& punto : OptimizadorVostok::muestrear(mision, 10.0)) {
+        std::cout << std::setw(7) << punto.tiempo << std::setw(14) << punto.altura / 1000.0
+                  << std::setw(18) << punto.velocidad << std::setw(19) << punto.combustible << "\n";
+    }
+}
+
+int optimizarVostok(const Opciones& opciones) {
+    ConfiguracionOptimizador config;
+    config.velocidadInicial = opciones.velocidadInicial;
+    config.pasoFisica = opciones.paso;
+    config.semilla = opciones.semilla;
+
+    OptimizadorVostok optimizador(opciones.hilos);
+    auto inicio = std::chrono::steady_clock::now();
+    const ResultadoOptimizacion r = optimizador.optimizar(config);
+    const double segundos = segundosDesde(inicio);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Optimizacion del nivel 2 desde " << config.velocidadInicial << " m/s: "
+              << r.generaciones << " generaciones, " << r.evaluaciones << " misiones en "
+              << segundos << " s con " << optimizador.obtenerNumeroHilos() << " hilos\n";
+
+    if (!r.factible) {
+        std::cout << "Ningun programa gana el nivel con esa velocidad inicial.\n";
+        return 1;
+    }
+
+    std::cout << "Combustible usado: " << r.combustibleUsado << " kg (llega en "
+              << r.mision.tiempo << " s)\n";
+    for (const ProgramaEmpuje::Tramo& tramo : r.programa.obtenerTramos()) {
+        std::cout << "  t >= " << tramo.tiempoInicio << " s: " << tramo.empuje << " N\n";
+    }
+    mostrarTrayectoria(OptimizadorVostok::crearMision(config, r.programa));
+
+    if (!opciones.rutaGuardar.empty()) {
+        if (!r.programa.guardar(opciones.rutaGuardar)) {
+            std::cerr << "No se pudo escribir " << opciones.rutaGuardar << "\n";
+            return 1;
+        }
+        std::cout << "Programa guardado en " << opciones.rutaGuardar << "\n";
+    }
+    return 0;
+}
+
+int correrPrograma(const Opciones& opciones) {
+    Mision mision;
+    mision.nivel = opciones.nivel;
+    mision.velocidadInicial = opciones.velocidadInicial;
+    mision.integrador = opciones.integrador;
+    mision.pasoFisica = opciones.paso;
+    mision.tolerancia = opciones.tolerancia;
+    mision.avanceBalistico = opciones.avanceBalistico;
+    if (!mision.programa.cargar(opciones.rutaPrograma)) {
+        std::cerr << "No se pudo leer el programa " << opciones.rutaPrograma << "\n";
+        return 1;
+    }
+
+    Juego juego;
+    juego.establecerModoSilencioso(true);
+    const ResultadoMision r = EjecutorLotes::ejecutarMision(juego, mision);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << (r.victoria ? "Victoria" : "Derrota: " + r.razonDerrota) << " a los "
+              << r.tiempo << " s, combustible restante: " << r.combustibleRestante << " kg\n";
+    mostrarTrayectoria(mision);
+    return r.victoria ? 0 : 2;
+}
+
+int generarTablaAlunizaje(const Opciones& opciones) {
+    auto inicio = std::chrono::steady_clock::now();
+    int barridos = 0;
+    const TablaAlunizaje tabla = TablaAlunizaje::generar(opciones.hilos, &barridos);
+    const double segundos = segundosDesde(inicio);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Tabla de alunizaje: " << TablaAlunizaje::obtenerCeldas() << " celdas, "
+              << barridos << " barridos en " << segundos << " s\n";
+    if (!tabla.guardar(opciones.rutaTabla)) {
+        std::cerr << "No se pudo escribir " << opciones.rutaTabla << "\n";
+        return 1;
+    }
+
+    TablaAlunizaje cargada;
+    inicio = std::chrono::steady_clock::now();
+    const bool ok = cargada.cargar(opciones.rutaTabla);
+    const double milisegundos = segundosDesde(inicio) * 1000.0;
+    if (!ok) {
+        std::cerr << "No se pudo volver a cargar " << opciones.rutaTabla << "\n";
+        return 1;
+    }
+    std::cout << "Guardada en " << opciones.rutaTabla << " (carga en " << milisegundos
+              << " ms)\n";
+
+    const Nivel3_Apolo11 nivel;
+    const ConsultaAlunizaje inicial =
+        cargada.consultar(nivel.obtenerAlturaInicial(), nivel.obtenerVelocidadDescensoInicial(),
+                          TablaAlunizaje::Parametros::delNivel().combustibleMaximo);
+    std::cout << "Desde el inicio del nivel 3 sobran " << inicial.combustibleFinal
+              << " kg alunizando a " << inicial.velocidadImpactoMinima << " m/s\n";
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Opciones opciones;
+    if (!leerOpciones(argc, argv, opciones)) {
+        mostrarAyuda();
+        return 1;
+    }
+
+    if (opciones.compararIntegradores) {
+        std::cout << std::setprecision(6);
+        compararIntegradores();
+        return 0;
+    }
+
+    if (opciones.optimizarVostok) {
+        return optimizarVostok(opciones);
+    }
+
+    if (!opciones.rutaTabla.empty()) {
+        return generarTablaAlunizaje(opciones);
+    }
+
+    if (!opciones.rutaPrograma.empty()) {
+        return correrPrograma(opciones);
+    }
+
+    std::vector<Mision> misiones = generarBarrido(opciones);
+
+    if (opciones.medirTick) {
+        medirTick(misiones);
+        return 0;
+    }
+
+    if (opciones.verificarLote) {
+        switch (opciones.nivel) {
+        case 1: verificarLote<Nivel1_Sputnik>(misiones, opciones.hilos); break;
+        case 2: verificarLote<Nivel2_Vostok>(misiones, opciones.hilos); break;
+        case 3: verificarLote<Nivel3_Apolo11>(misiones, opciones.hilos); break;
+        }
+        return 0;
+    }
+
+    EjecutorLotes ejecutor(opciones.hilos);
+
+    std::cout << "Simulando " << misiones.size() << " misiones del nivel "
+              << opciones.nivel << " con " << ejecutor.obtenerNumeroHilos()
+              << " hilos...\n";
+
+    auto inicio = std::chrono::steady_clock::now();
+    std::vector<ResultadoMision> resultados = ejecutor.ejecutar(misiones);
+    auto fin = std::chrono::steady_clock::now();
+
+    double segundos = std::chrono::duration<double>(fin - inicio).count();
+
+    std::size_t victorias = 0;
+    std::size_t mejor = resultados.size();
+    std::map<std::string, std::size_t> derrotas;
+
+    for (std::size_t i = 0; i < resultados.size(); ++i) {
+        const ResultadoMision& r = resultados[i];
+        if (r.victoria) {
+            ++victorias;
+            if (mejor == resultados.size() ||
+                r.combustibleRestante > resultados[mejor].combustibleRestante) {
+                mejor = i;
+            }
+        } else {
+            ++derrotas[r.razonDerrota];
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Tiempo total: " << segundos << " s ("
+              << (segundos > 0.0 ? misiones.size() / segundos : 0.0)
+              << " misiones/s)\n";
+    std::cout << "Victorias: " << victorias << " de " << resultados.size() << "\n";
+
+    for (const auto& [razon, cantidad] : derrotas) {
+        std::cout << "  " << cantidad << " x " << razon << "\n";
+    }
+
+    if (mejor < resultados.size()) {
+        std::cout << "\nMision con mas combustible restante (#" << mejor << "):\n";
+        if (opciones.nivel != 3 || misiones[mejor].autopiloto) {
+            std::cout << "  Velocidad inicial: " << misiones[mejor].velocidadInicial << " m/s\n";
+        }
+        for (const ProgramaEmpuje::Tramo& tramo : misiones[mejor].programa.obtenerTramos()) {
+            std::cout << "  t >= " << tramo.tiempoInicio << " s: " << tramo.empuje << " N\n";
+        }
+        std::cout << "  Tiempo: " << resultados[mejor].tiempo << " s, combustible: "
+                  << resultados[mejor].combustibleRestante << " kg\n";
+
+        if (opciones.escenariosRobustez > 0) {
+            mostrarRobustez(misiones[mejor], opciones);
+        }
+    }
+
+    return 0;
+}